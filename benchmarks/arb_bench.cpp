@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "arb_scanner.hpp"
+#include "cross_arb_search.hpp"
+#include "level_book.hpp"
+#include "types.hpp"
+
+// Two books range(0) levels deep; b bids through a by more than fees for ~170 levels
+static void fill_books(LevelBook& a, LevelBook& b, int depth) {
+    OrderBookData sa{};
+    OrderBookData sb{};
+    sa.snapshot = sb.snapshot = true;
+    for (int i = 0; i < depth; ++i) {
+        sa.bids.emplace_back(63000.0 - i * 0.5, 0.25 + i * 0.01);
+        sa.asks.emplace_back(63001.0 + i * 0.5, 0.25 + i * 0.01);
+        sb.bids.emplace_back(63300.0 - i * 0.5, 0.20 + i * 0.01);
+        sb.asks.emplace_back(63301.0 + i * 0.5, 0.20 + i * 0.01);
+    }
+    a.apply(sa);
+    b.apply(sb);
+}
+
+// Both directions, as CrossExchangeArb evaluates on every top-of-book change
+static void BM_WalkCrossBothDirections(benchmark::State& state) {
+    LevelBook a;
+    LevelBook b;
+    fill_books(a, b, static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        CrossFill ab = walk_cross(a.asks(), b.bids(), 0.001);
+        CrossFill ba = walk_cross(b.asks(), a.bids(), 0.001);
+        benchmark::DoNotOptimize(ab.profit);
+        benchmark::DoNotOptimize(ba.profit);
+    }
+}
+BENCHMARK(BM_WalkCrossBothDirections)->Arg(5)->Arg(50)->Arg(500);
+
+// A typical depth delta: one top-level change per side on a deep book
+static void BM_LevelBookApplyTopUpdate(benchmark::State& state) {
+    LevelBook a;
+    LevelBook b;
+    fill_books(a, b, static_cast<int>(state.range(0)));
+    OrderBookData update{};
+    update.bids = {{63000.0, 0.3}};
+    update.asks = {{63001.0, 0.3}};
+    double qty = 0.3;
+    for (auto _ : state) {
+        qty = qty == 0.3 ? 0.4 : 0.3;
+        update.bids[0].second = qty;
+        update.asks[0].second = qty;
+        benchmark::DoNotOptimize(a.apply(update));
+    }
+}
+BENCHMARK(BM_LevelBookApplyTopUpdate)->Arg(50)->Arg(500);
+
+// 100 symbols on 3 venues: a top-of-book change re-evaluates its row; the first venue's quotes
+// sit above the others', so every row holds an opportunity and the ranking is full
+static void fill_scanner(ArbScanner& scanner, std::vector<LevelBook::TopOfBook>& tops) {
+    constexpr uint32_t symbols = 100;
+    constexpr uint32_t venues = 3;
+    for (uint32_t row = 0; row < symbols; ++row) {
+        scanner.add_row();
+        for (uint32_t v = 0; v < venues; ++v) {
+            const uint32_t id = row * venues + v;
+            const double mid = 100.0 + row + (v == 0 ? 1.0 : 0.0);
+            tops.push_back(LevelBook::TopOfBook{mid - 0.01, 1.0, mid + 0.01, 1.0});
+            scanner.bind(id, row, v);
+            scanner.update(id, tops.back());
+        }
+    }
+}
+
+static void BM_ArbScannerUpdate(benchmark::State& state) {
+    ArbScanner scanner({0.001, 0.001, 0.0026}, 0.0);
+    std::vector<LevelBook::TopOfBook> tops;
+    fill_scanner(scanner, tops);
+    uint32_t id = 0;
+    for (auto _ : state) {
+        LevelBook::TopOfBook& top = tops[id];
+        top.bid_quantity = top.bid_quantity == 1.0 ? 2.0 : 1.0;
+        benchmark::DoNotOptimize(scanner.update(id, top));
+        id = id + 37 < tops.size() ? id + 37 : id + 37 - static_cast<uint32_t>(tops.size());
+    }
+}
+BENCHMARK(BM_ArbScannerUpdate);
+
+static void BM_ArbScannerRankTop5(benchmark::State& state) {
+    ArbScanner scanner({0.001, 0.001, 0.0026}, 0.0);
+    std::vector<LevelBook::TopOfBook> tops;
+    fill_scanner(scanner, tops);
+    std::vector<ArbScanner::Opportunity> ranked;
+    ranked.reserve(scanner.rows());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(scanner.ranked(ranked, 5));
+    }
+}
+BENCHMARK(BM_ArbScannerRankTop5);
@@ -0,0 +1,97 @@
+#pragma once
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include "types.hpp"
+
+#ifndef BENCHMARK_DATA_DIR
+#define BENCHMARK_DATA_DIR "benchmarks/data"
+#endif
+
+// Loads frames, one per line, from benchmarks/data/<name>.jsonl. The checked-in files are
+// synthetic, made by benchmarks/data/generate_frames.py; drop in a real capture to re-baseline.
+// Aborts when the file is missing so a benchmark never silently runs on nothing.
+inline const std::vector<std::string>& load_frames(const std::string& name) {
+    static std::vector<std::pair<std::string, std::vector<std::string>>> cache;
+    for (const auto& [cached_name, frames] : cache) {
+        if (cached_name == name) return frames;
+    }
+
+    std::string path = std::string(BENCHMARK_DATA_DIR) + "/" + name + ".jsonl";
+    std::ifstream in(path);
+    std::vector<std::string> frames;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty()) frames.push_back(line);
+    }
+    if (frames.empty()) {
+        std::cerr << "Error: no frames loaded from " << path << std::endl;
+        std::abort();
+    }
+    cache.emplace_back(name, std::move(frames));
+    return cache.back().second;
+}
+
+inline size_t total_bytes(const std::vector<std::string>& frames) {
+    size_t bytes = 0;
+    for (const auto& f : frames) bytes += f.size();
+    return bytes;
+}
+
+// Number tokens as they appear on the wire (quoted or bare), delimited by [start, end)
+struct NumberToken {
+    const char* start;
+    const char* end;
+};
+
+// Collects every numeric value in the frames; with_fraction selects decimals or integers
+inline std::vector<NumberToken> collect_numbers(const std::vector<std::string>& frames, bool with_fraction) {
+    std::vector<NumberToken> tokens;
+    for (const auto& frame : frames) {
+        const char* p = frame.data();
+        const char* end = p + frame.size();
+        while (p < end) {
+            // Values start right after ':' / ',' / '[' , optionally quoted
+            if (*p == ':' || *p == ',' || *p == '[') {
+                const char* v = p + 1;
+                if (v < end && *v == '"') ++v;
+                const char* q = v;
+                if (q < end && *q == '-') ++q;
+                const char* digits = q;
+                bool dot = false;
+                while (q < end && ((*q >= '0' && *q <= '9') || (*q == '.' && !dot))) {
+                    if (*q == '.') dot = true;
+                    ++q;
+                }
+                // Reject prefixes of dates and identifiers like "2024-09-25T..." or "8b6a-..."
+                bool terminated = q < end && (*q == '"' || *q == ',' || *q == '}' || *q == ']');
+                if (q > digits && terminated && dot == with_fraction) {
+                    tokens.push_back(NumberToken{v, q});
+                }
+                p = q > p + 1 ? q : p + 1;
+                continue;
+            }
+            ++p;
+        }
+    }
+    return tokens;
+}
+
+// Collects the quoted ISO-8601 values of the given key
+inline std::vector<NumberToken> collect_timestamps(const std::vector<std::string>& frames, const std::string& key) {
+    std::vector<NumberToken> tokens;
+    const std::string needle = "\"" + key + "\":\"";
+    for (const auto& frame : frames) {
+        size_t pos = 0;
+        while ((pos = frame.find(needle, pos)) != std::string::npos) {
+            pos += needle.size();
+            size_t close = frame.find('"', pos);
+            if (close == std::string::npos) break;
+            tokens.push_back(NumberToken{frame.data() + pos, frame.data() + close});
+            pos = close;
+        }
+    }
+    return tokens;
+}
@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "candle_aggregator.hpp"
+
+// Per-trade cost of building bars for many instruments. Trades land on random instruments
+// 1us apart, so time bars mostly update an open bar and a bar closes every few hundred trades.
+static constexpr int64_t US = 1'000;
+static constexpr size_t TRADES = 1 << 16;
+
+struct Trade {
+    uint32_t instrument;
+    double price;
+    double quantity;
+};
+
+static std::vector<Trade> random_trades(size_t instruments) {
+    std::mt19937_64 rng(11);
+    std::uniform_int_distribution<uint32_t> pick(0, static_cast<uint32_t>(instruments - 1));
+    std::uniform_real_distribution<double> price(99.0, 101.0);
+    std::uniform_real_distribution<double> quantity(0.01, 2.0);
+    std::vector<Trade> trades(TRADES);
+    for (auto& t : trades) t = Trade{pick(rng), price(rng), quantity(rng)};
+    return trades;
+}
+
+static void run_trades(benchmark::State& state, const char* spec) {
+    const size_t instruments = static_cast<size_t>(state.range(0));
+    const auto trades = random_trades(instruments);
+    CandleAggregator aggregator(instruments, BarSpec::parse(spec));
+    uint64_t bars = 0;
+    auto emit = [&](uint32_t, const CandleAggregator::CandleBar& bar) { bars += bar.trade_count > 0; };
+    int64_t t = 0;
+    size_t i = 0;
+    for (auto _ : state) {
+        const Trade& trade = trades[i++ & (TRADES - 1)];
+        t += US;
+        aggregator.on_trade(trade.instrument, t, trade.price, trade.quantity, emit);
+    }
+    benchmark::DoNotOptimize(bars);
+    state.counters["bars"] = benchmark::Counter(static_cast<double>(bars));
+}
+
+static void BM_CandleTimeBars(benchmark::State& state) { run_trades(state, "1s"); }
+BENCHMARK(BM_CandleTimeBars)->Arg(16)->Arg(1024);
+
+static void BM_CandleVolumeBars(benchmark::State& state) { run_trades(state, "100vol"); }
+BENCHMARK(BM_CandleVolumeBars)->Arg(16)->Arg(1024);
+
+static void BM_CandleTickBars(benchmark::State& state) { run_trades(state, "100tick"); }
+BENCHMARK(BM_CandleTickBars)->Arg(16)->Arg(1024);
+
+// Timer calls between boundaries: the steady state of a 100ms poll against 1s bars
+static void BM_CandleTimerIdle(benchmark::State& state) {
+    const size_t instruments = static_cast<size_t>(state.range(0));
+    CandleAggregator aggregator(instruments, BarSpec::parse("1s"));
+    auto emit = [](uint32_t, const CandleAggregator::CandleBar&) {};
+    for (uint32_t id = 0; id < instruments; ++id) aggregator.on_trade(id, 0, 100.0, 1.0, emit);
+    for (auto _ : state) {
+        aggregator.on_timer(500'000 * US, emit);
+    }
+}
+BENCHMARK(BM_CandleTimerIdle)->Arg(1024);
+
+// The sweep at a boundary: every instrument has an open bar and all of them close
+static void BM_CandleTimerSweep(benchmark::State& state) {
+    const size_t instruments = static_cast<size_t>(state.range(0));
+    CandleAggregator aggregator(instruments, BarSpec::parse("1s"));
+    uint64_t bars = 0;
+    auto emit = [&](uint32_t, const CandleAggregator::CandleBar&) { ++bars; };
+    int64_t t = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (uint32_t id = 0; id < instruments; ++id) aggregator.on_trade(id, t, 100.0, 1.0, emit);
+        t += 1'000'000 * US;
+        state.ResumeTiming();
+        aggregator.on_timer(t, emit);
+    }
+    benchmark::DoNotOptimize(bars);
+}
+BENCHMARK(BM_CandleTimerSweep)->Arg(1024);
@@ -0,0 +1,99 @@
+"""Generates the synthetic benchmark frames in this directory.
+
+Each file holds 200 frames of one venue channel in that venue's wire format (Binance combined
+streams, Coinbase exchange feed, Kraken v2), one frame per line. Prices follow a seeded random
+walk around 63250, so the output is the same on every run. The frames match the real feeds in
+layout, field types and rough size; their values, level counts and timing are made up. To
+benchmark on real traffic, replace a file with a capture of the same channel, one frame per
+line.
+
+    python3 benchmarks/data/generate_frames.py
+"""
+import datetime
+import json
+import os
+import random
+
+random.seed(7)
+out = os.path.dirname(os.path.abspath(__file__)) + '/'
+N = 200
+t0 = 1727251777000  # ms
+def iso(ms, us=0):
+    d = datetime.datetime.fromtimestamp(ms/1000, datetime.timezone.utc)
+    return d.strftime('%Y-%m-%dT%H:%M:%S.') + '%06dZ' % ((ms % 1000) * 1000 + us)
+def w(name, lines):
+    with open(out + name, 'w', newline='\n') as f:
+        for l in lines: f.write(l + '\n')
+def dumps(o): return json.dumps(o, separators=(',', ':'))
+mid = 63250.0
+def walk():
+    global mid
+    mid = round(mid + random.gauss(0, 2.5), 2)
+    return mid
+
+# Binance combined streams
+lines=[]; u=52830011000
+for i in range(N):
+    m=walk(); n=random.randint(1,20); k=random.randint(1,20)
+    U=u+1; u=U+n+k
+    b=[["%.2f"%(m-0.01*random.randint(1,500)),"%.5f"%(random.random()*2 if random.random()>.2 else 0)] for _ in range(n)]
+    a=[["%.2f"%(m+0.01*random.randint(1,500)),"%.5f"%(random.random()*2 if random.random()>.2 else 0)] for _ in range(k)]
+    lines.append(dumps({"stream":"btcusdt@depth@100ms","data":{"e":"depthUpdate","E":t0+100*i,"s":"BTCUSDT","U":U,"u":u,"b":b,"a":a}}))
+w('binance_depth.jsonl',lines)
+lines=[]; tid=3840012000
+for i in range(N):
+    m=walk(); tid+=1; T=t0+random.randint(0,40)+25*i
+    lines.append(dumps({"stream":"btcusdt@trade","data":{"e":"trade","E":T+1,"s":"BTCUSDT","t":tid,"p":"%.2f"%m,"q":"%.5f"%(random.random()*0.5),"T":T,"m":random.random()<.5,"M":True}}))
+w('binance_trade.jsonl',lines)
+lines=[]
+for i in range(N):
+    m=walk(); E=t0+1000*i
+    lines.append(dumps({"stream":"btcusdt@ticker","data":{"e":"24hrTicker","E":E,"s":"BTCUSDT","p":"%.2f"%(m-62100),"P":"%.3f"%((m-62100)/621),"w":"%.2f"%(m-300),"x":"62099.99","c":"%.2f"%m,"Q":"%.5f"%random.random(),"b":"%.2f"%(m-0.01),"B":"%.5f"%(random.random()*3),"a":"%.2f"%m,"A":"%.5f"%(random.random()*3),"o":"62100.00","h":"63890.00","l":"61770.12","v":"21873.40102","q":"1371948372.90811070","O":E-86400000,"C":E,"F":3830012000,"L":3840012000+i,"n":10000000+i}}))
+w('binance_ticker.jsonl',lines)
+lines=[]
+for i in range(N):
+    m=walk(); o=m; c=walk(); hi=max(o,c)+random.random()*3; lo=min(o,c)-random.random()*3; t=t0+1000*i
+    lines.append(dumps({"stream":"btcusdt@kline_1s","data":{"e":"kline","E":t+1001,"s":"BTCUSDT","k":{"t":t,"T":t+999,"s":"BTCUSDT","i":"1s","f":3840012000+10*i,"L":3840012009+10*i,"o":"%.2f"%o,"c":"%.2f"%c,"h":"%.2f"%hi,"l":"%.2f"%lo,"v":"%.5f"%(random.random()*4),"n":random.randint(1,60),"x":True,"q":"%.8f"%(random.random()*250000),"V":"%.5f"%(random.random()*2),"Q":"%.8f"%(random.random()*120000),"B":"0"}}}))
+w('binance_kline.jsonl',lines)
+
+# Coinbase exchange feed
+lines=[]
+for i in range(N):
+    m=walk(); ch=[[random.choice(["buy","sell"]),"%.2f"%(m+0.01*random.randint(-300,300)),"%.8f"%(random.random() if random.random()>.2 else 0)] for _ in range(random.randint(1,12))]
+    lines.append(dumps({"type":"l2update","product_id":"BTC-USD","changes":ch,"time":iso(t0+50*i,random.randint(0,999))}))
+w('coinbase_level2.jsonl',lines)
+lines=[]; seq=86213577000; tid=693001000
+for i in range(N):
+    m=walk(); seq+=random.randint(1,40); tid+=1
+    lines.append(dumps({"type":"match","trade_id":tid,"maker_order_id":"%08x-7d1e-4a4b-9d2f-%012x"%(random.getrandbits(32),random.getrandbits(48)),"taker_order_id":"%08x-3c5a-4f0e-8b6a-%012x"%(random.getrandbits(32),random.getrandbits(48)),"side":random.choice(["buy","sell"]),"size":"%.8f"%(random.random()*0.3),"price":"%.2f"%m,"product_id":"BTC-USD","sequence":seq,"time":iso(t0+30*i,random.randint(0,999))}))
+w('coinbase_matches.jsonl',lines)
+lines=[]
+for i in range(N):
+    m=walk(); seq+=random.randint(1,40); tid+=1
+    lines.append(dumps({"type":"ticker","sequence":seq,"product_id":"BTC-USD","price":"%.2f"%m,"open_24h":"62101.37","volume_24h":"8421.90230876","low_24h":"61760.00","high_24h":"63899.99","volume_30d":"294410.33871240","best_bid":"%.2f"%(m-0.01),"best_bid_size":"%.8f"%random.random(),"best_ask":"%.2f"%m,"best_ask_size":"%.8f"%random.random(),"side":random.choice(["buy","sell"]),"time":iso(t0+200*i,random.randint(0,999)),"trade_id":tid,"last_size":"%.8f"%(random.random()*0.1)}))
+w('coinbase_ticker.jsonl',lines)
+
+# Kraken v2
+def kdumps(o): return dumps(o)
+lines=[]
+for i in range(N):
+    m=walk()
+    bids=[{"price":round(m-0.1*random.randint(1,100),1),"qty":round(random.random()*2,8) if random.random()>.2 else 0.0} for _ in range(random.randint(0,6))]
+    asks=[{"price":round(m+0.1*random.randint(1,100),1),"qty":round(random.random()*2,8) if random.random()>.2 else 0.0} for _ in range(random.randint(0,6))]
+    lines.append(kdumps({"channel":"book","type":"update","data":[{"symbol":"BTC/USD","bids":bids,"asks":asks,"checksum":random.getrandbits(32),"timestamp":iso(t0+40*i,random.randint(0,999))}]}))
+w('kraken_book.jsonl',lines)
+lines=[]; tid=71003000
+for i in range(N):
+    m=walk(); tid+=1
+    lines.append(kdumps({"channel":"trade","type":"update","data":[{"symbol":"BTC/USD","side":random.choice(["buy","sell"]),"price":round(m,1),"qty":round(random.random()*0.2,8),"ord_type":random.choice(["market","limit"]),"trade_id":tid,"timestamp":iso(t0+60*i,random.randint(0,999))}]}))
+w('kraken_trade.jsonl',lines)
+lines=[]
+for i in range(N):
+    m=walk()
+    lines.append(kdumps({"channel":"ticker","type":"update","data":[{"symbol":"BTC/USD","bid":round(m-0.1,1),"bid_qty":round(random.random()*5,8),"ask":round(m,1),"ask_qty":round(random.random()*5,8),"last":round(m,1),"volume":1893.37164815,"vwap":62954.9,"low":61770.0,"high":63890.0,"change":round(m-62100,1),"change_pct":round((m-62100)/621,2)}]}))
+w('kraken_ticker.jsonl',lines)
+lines=[]
+for i in range(N):
+    o=walk(); c=walk(); t=t0+60000*i
+    lines.append(kdumps({"channel":"ohlc","type":"update","timestamp":iso(t+random.randint(0,59000)),"data":[{"symbol":"BTC/USD","open":round(o,1),"high":round(max(o,c)+random.random()*5,1),"low":round(min(o,c)-random.random()*5,1),"close":round(c,1),"trades":random.randint(1,200),"volume":round(random.random()*12,8),"vwap":round((o+c)/2,1),"interval_begin":iso(t),"interval":1,"timestamp":iso(t+60000)}]}))
+w('kraken_ohlc.jsonl',lines)
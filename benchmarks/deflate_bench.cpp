@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include <boost/beast/zlib/deflate_stream.hpp>
+#include <boost/beast/zlib/inflate_stream.hpp>
+#include "bench_frames.hpp"
+#include "payload_buffer.hpp"
+
+namespace zlib = boost::beast::zlib;
+
+// Frames as permessage-deflate puts them on the wire: sync-flushed, the 00 00 ff ff tail
+// stripped, and with context takeover sharing one window across the whole stream
+static std::vector<std::string> deflate_frames(const std::vector<std::string>& frames, bool context_takeover) {
+    zlib::deflate_stream deflater;
+    deflater.reset(6, 15, 8, zlib::Strategy::normal);
+    std::vector<std::string> out;
+    out.reserve(frames.size());
+    for (const auto& frame : frames) {
+        if (!context_takeover) deflater.reset();
+        std::string compressed(frame.size() + 64, '\0');
+        zlib::z_params zs;
+        zs.next_in = frame.data();
+        zs.avail_in = frame.size();
+        zs.next_out = compressed.data();
+        zs.avail_out = compressed.size();
+        boost::system::error_code ec;
+        deflater.write(zs, zlib::Flush::sync, ec);
+        compressed.resize(zs.total_out - 4);
+        out.push_back(std::move(compressed));
+    }
+    return out;
+}
+
+// Inflates one frame into the buffer, appending the tail permessage-deflate strips
+static std::string inflate_frame(zlib::inflate_stream& inflater, PayloadBuffer& buffer,
+                                 const std::string& compressed, size_t raw_size) {
+    static const char tail[4] = {0x00, 0x00, static_cast<char>(0xff), static_cast<char>(0xff)};
+    auto out = buffer.prepare(raw_size);
+    zlib::z_params zs;
+    zs.next_out = out.data();
+    zs.avail_out = out.size();
+    boost::system::error_code ec;
+    zs.next_in = compressed.data();
+    zs.avail_in = compressed.size();
+    inflater.write(zs, zlib::Flush::sync, ec);
+    zs.next_in = tail;
+    zs.avail_in = sizeof(tail);
+    inflater.write(zs, zlib::Flush::sync, ec);
+    buffer.commit(zs.total_out);
+    return buffer.take();
+}
+
+// Receive-side cost of compression: inflating every frame into the buffer the parser reads.
+// Counters show wire bytes against the uncompressed size, i.e. the bandwidth saved.
+static void BM_Inflate(benchmark::State& state, const char* name, bool context_takeover) {
+    const auto& frames = load_frames(name);
+    const auto compressed = deflate_frames(frames, context_takeover);
+
+    zlib::inflate_stream inflater;
+    PayloadBuffer buffer;
+    inflater.reset(15);
+    for (size_t i = 0; i < compressed.size(); ++i) {
+        if (!context_takeover) inflater.reset(15);
+        if (inflate_frame(inflater, buffer, compressed[i], frames[i].size()) != frames[i]) {
+            state.SkipWithError("inflated frame differs from the original");
+            return;
+        }
+    }
+
+    for (auto _ : state) {
+        inflater.reset(15);
+        for (size_t i = 0; i < compressed.size(); ++i) {
+            if (!context_takeover) inflater.reset(15);
+            std::string payload = inflate_frame(inflater, buffer, compressed[i], frames[i].size());
+            benchmark::DoNotOptimize(payload.data());
+        }
+    }
+
+    size_t wire = total_bytes(compressed);
+    size_t raw = total_bytes(frames);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(frames.size()));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(raw));
+    state.counters["wire_bytes_per_msg"] = static_cast<double>(wire) / static_cast<double>(frames.size());
+    state.counters["raw_bytes_per_msg"] = static_cast<double>(raw) / static_cast<double>(frames.size());
+    state.counters["ratio"] = static_cast<double>(raw) / static_cast<double>(wire);
+}
+BENCHMARK_CAPTURE(BM_Inflate, binance_depth, "binance_depth", true);
+BENCHMARK_CAPTURE(BM_Inflate, binance_depth_no_takeover, "binance_depth", false);
+BENCHMARK_CAPTURE(BM_Inflate, kraken_book, "kraken_book", true);
+BENCHMARK_CAPTURE(BM_Inflate, kraken_book_no_takeover, "kraken_book", false);
+BENCHMARK_CAPTURE(BM_Inflate, coinbase_level2, "coinbase_level2", true);
+
+// Baseline for the above: the same frames read uncompressed, copied into the payload as
+// on_read did before reading into a PayloadBuffer
+static void BM_PlainCopy(benchmark::State& state, const char* name) {
+    const auto& frames = load_frames(name);
+    for (auto _ : state) {
+        for (const auto& frame : frames) {
+            std::string payload(frame.data(), frame.size());
+            benchmark::DoNotOptimize(payload.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(frames.size()));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(total_bytes(frames)));
+}
+BENCHMARK_CAPTURE(BM_PlainCopy, binance_depth, "binance_depth");
+BENCHMARK_CAPTURE(BM_PlainCopy, kraken_book, "kraken_book");
@@ -0,0 +1,58 @@
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <time.h>
+#include "fast_clock.hpp"
+#include "utils.hpp"
+
+static void BM_FastClockTicks(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(FastClock::ticks());
+    }
+}
+BENCHMARK(BM_FastClockTicks);
+
+static void BM_FastClockNowNanos(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(FastClock::now_nanos());
+    }
+}
+BENCHMARK(BM_FastClockNowNanos);
+
+static void BM_SystemClockNow(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(get_time_now_nano());
+    }
+}
+BENCHMARK(BM_SystemClockNow);
+
+#ifndef _WIN32
+static void BM_ClockGettimeRealtime(benchmark::State& state) {
+    timespec ts;
+    for (auto _ : state) {
+        clock_gettime(CLOCK_REALTIME, &ts);
+        benchmark::DoNotOptimize(ts);
+    }
+}
+BENCHMARK(BM_ClockGettimeRealtime);
+#endif
+
+// Drift check: FastClock against the system clock across recalibrations.
+// Reports the worst absolute offset seen; it should stay within a few microseconds.
+static void BM_FastClockDrift(benchmark::State& state) {
+    FastClock::start_calibration_thread(std::chrono::milliseconds(100));
+    int64_t worst = 0;
+    for (auto _ : state) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        int64_t before = get_time_now_nano();
+        int64_t fast = FastClock::now_nanos();
+        int64_t after = get_time_now_nano();
+        int64_t offset = fast - (before + (after - before) / 2);
+        worst = std::max(worst, std::abs(offset));
+    }
+    FastClock::stop_calibration_thread();
+    state.counters["max_offset_ns"] = static_cast<double>(worst);
+    state.counters["using_tsc"] = FastClock::using_tsc() ? 1.0 : 0.0;
+}
+BENCHMARK(BM_FastClockDrift)->Iterations(300)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,152 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "indicators.hpp"
+
+// Per-update cost of each indicator. Trades arrive every 1ms into 1s windows, so a windowed
+// indicator holds ~1000 samples and expires one per update, the steady state.
+static constexpr int64_t MS = 1'000'000;
+static constexpr int64_t WINDOW = 1000 * MS;
+
+static std::vector<double> random_prices(size_t n) {
+    std::mt19937_64 rng(7);
+    std::normal_distribution<double> step(0.0, 0.0005);
+    std::vector<double> prices(n);
+    double p = 60000.0;
+    for (auto& price : prices) {
+        p *= 1.0 + step(rng);
+        price = p;
+    }
+    return prices;
+}
+
+static void BM_Ema(benchmark::State& state) {
+    const auto prices = random_prices(4096);
+    Ema ema = Ema::from_span(20);
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ema.update(prices[i++ & 4095]));
+    }
+}
+BENCHMARK(BM_Ema);
+
+static void BM_TimeEma(benchmark::State& state) {
+    const auto prices = random_prices(4096);
+    TimeEma ema(WINDOW);
+    int64_t t = 0;
+    size_t i = 0;
+    for (auto _ : state) {
+        t += MS;
+        benchmark::DoNotOptimize(ema.update(t, prices[i++ & 4095]));
+    }
+}
+BENCHMARK(BM_TimeEma);
+
+static void BM_TimeSma(benchmark::State& state) {
+    const auto prices = random_prices(4096);
+    TimeSma sma(WINDOW);
+    int64_t t = 0;
+    size_t i = 0;
+    for (auto _ : state) {
+        t += MS;
+        benchmark::DoNotOptimize(sma.update(t, prices[i++ & 4095]));
+    }
+}
+BENCHMARK(BM_TimeSma);
+
+static void BM_RollingVwap(benchmark::State& state) {
+    const auto prices = random_prices(4096);
+    RollingVwap vwap(WINDOW);
+    int64_t t = 0;
+    size_t i = 0;
+    for (auto _ : state) {
+        t += MS;
+        benchmark::DoNotOptimize(vwap.update(t, prices[i & 4095], 0.01 + (i & 7) * 0.1));
+        ++i;
+    }
+}
+BENCHMARK(BM_RollingVwap);
+
+static void BM_RealizedVolatility(benchmark::State& state) {
+    const auto prices = random_prices(4096);
+    RealizedVolatility rv(WINDOW);
+    int64_t t = 0;
+    size_t i = 0;
+    for (auto _ : state) {
+        t += MS;
+        benchmark::DoNotOptimize(rv.update(t, prices[i++ & 4095]));
+    }
+}
+BENCHMARK(BM_RealizedVolatility);
+
+static void BM_TradeFlowImbalance(benchmark::State& state) {
+    TradeFlowImbalance flow(WINDOW);
+    int64_t t = 0;
+    size_t i = 0;
+    for (auto _ : state) {
+        t += MS;
+        benchmark::DoNotOptimize(flow.update(t, 0.01 + (i & 7) * 0.1, (i * 7919) & 4 ? 1 : -1));
+        ++i;
+    }
+}
+BENCHMARK(BM_TradeFlowImbalance);
+
+static void BM_BookSignals(benchmark::State& state) {
+    LevelBook::TopOfBook top{59999.5, 1.2, 60000.5, 0.8};
+    for (auto _ : state) {
+        top.bid_quantity = top.bid_quantity == 1.2 ? 1.3 : 1.2;
+        benchmark::DoNotOptimize(book_imbalance(top));
+        benchmark::DoNotOptimize(microprice(top));
+    }
+}
+BENCHMARK(BM_BookSignals);
+
+// range(0) instruments sampled at once, batch against one scalar Ema per instrument
+static void BM_EmaBatch(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const auto samples = random_prices(n);
+    EmaBatch batch(n, 2.0 / 21.0);
+    batch.reset(samples.data());
+    for (auto _ : state) {
+        batch.update(samples.data());
+        benchmark::DoNotOptimize(batch.values());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_EmaBatch)->Arg(64)->Arg(1024);
+
+static void BM_EmaScalarLoop(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const auto samples = random_prices(n);
+    std::vector<Ema> emas(n, Ema::from_span(20));
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; ++i) {
+            benchmark::DoNotOptimize(emas[i].update(samples[i]));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_EmaScalarLoop)->Arg(64)->Arg(1024);
+
+static void BM_BookSignalsBatch(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const auto bid = random_prices(n);
+    std::vector<double> ask(n);
+    std::vector<double> bid_quantity(n);
+    std::vector<double> ask_quantity(n);
+    for (size_t i = 0; i < n; ++i) {
+        ask[i] = bid[i] + 0.5;
+        bid_quantity[i] = 0.1 + (i & 7) * 0.3;
+        ask_quantity[i] = 0.1 + (i & 3) * 0.5;
+    }
+    std::vector<double> imbalance(n);
+    std::vector<double> micro(n);
+    for (auto _ : state) {
+        book_signals_batch(bid.data(), bid_quantity.data(), ask.data(), ask_quantity.data(), n,
+                           imbalance.data(), micro.data());
+        benchmark::DoNotOptimize(micro.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_BookSignalsBatch)->Arg(64)->Arg(1024);
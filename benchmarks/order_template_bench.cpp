@@ -0,0 +1,33 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <boost/json.hpp>
+#include "order_template.hpp"
+
+// What building the order message per send costs: a JSON object serialized from scratch
+static void BM_OrderSerializeJson(benchmark::State& state) {
+    uint64_t id = 0;
+    for (auto _ : state) {
+        ++id;
+        boost::json::object params{
+            {"symbol", "BTCUSDT"}, {"side", "BUY"}, {"type", "LIMIT"}, {"timeInForce", "GTC"},
+            {"price", std::to_string(50'000.0 + static_cast<double>(id % 100) * 0.01)},
+            {"quantity", std::to_string(0.01)},
+            {"newClientOrderId", std::to_string(id)}};
+        std::string message = boost::json::serialize(boost::json::object{
+            {"id", std::to_string(id)}, {"method", "order.place"}, {"params", std::move(params)}});
+        benchmark::DoNotOptimize(message.data());
+    }
+}
+BENCHMARK(BM_OrderSerializeJson);
+
+// The same message from a template, only id, price and quantity written per send
+static void BM_OrderTemplateRender(benchmark::State& state) {
+    OrderTemplate order = OrderTemplate::binance_place("BTCUSDT", Side::Buy, OrderType::Limit, 2, 5);
+    uint64_t id = 0;
+    for (auto _ : state) {
+        ++id;
+        std::string_view message = order.render(id, id, 50'000.0 + static_cast<double>(id % 100) * 0.01, 0.01);
+        benchmark::DoNotOptimize(message.data());
+    }
+}
+BENCHMARK(BM_OrderTemplateRender);
@@ -0,0 +1,28 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+#include "rolling_pair_stats.hpp"
+
+// One tick of PairTradingStrat per iteration: push a sample into one of range(0) pairs
+// (window 500) and read its z-score. The pairs rotate, as ticks for different symbols would
+static void BM_RollingPairStatsPushZScore(benchmark::State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    std::vector<RollingPairStats> pairs(count, RollingPairStats(500));
+    std::vector<double> log_prices(4096);
+    std::mt19937_64 rng(1);
+    std::normal_distribution<double> noise(0.0, 0.01);
+    for (auto& p : log_prices) {
+        p = 4.0 + noise(rng);
+    }
+    size_t i = 0;
+    size_t pair = 0;
+    for (auto _ : state) {
+        const double y = log_prices[i & 4095];
+        const double x = log_prices[(i + 7) & 4095];
+        pairs[pair].push(y, x);
+        benchmark::DoNotOptimize(pairs[pair].z_score(y, x));
+        ++i;
+        pair = pair + 1 < count ? pair + 1 : 0;
+    }
+}
+BENCHMARK(BM_RollingPairStatsPushZScore)->Arg(1)->Arg(300);
@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+#include <array>
+#include "bench_frames.hpp"
+#include "binance_fast_parser.hpp"
+#include "coinbase_fast_parser.hpp"
+#include "kraken_fast_parser.hpp"
+
+// Frames each venue's parser sees in production
+template<typename Parser> struct VenueFrames;
+template<> struct VenueFrames<BinanceFastParser> {
+    static constexpr std::array<const char*, 4> names = {"binance_depth", "binance_trade", "binance_ticker", "binance_kline"};
+};
+template<> struct VenueFrames<CoinbaseFastParser> {
+    static constexpr std::array<const char*, 3> names = {"coinbase_level2", "coinbase_matches", "coinbase_ticker"};
+};
+template<> struct VenueFrames<KrakenFastParser> {
+    static constexpr std::array<const char*, 4> names = {"kraken_book", "kraken_trade", "kraken_ticker", "kraken_ohlc"};
+};
+
+template<typename Parser>
+static std::vector<NumberToken> venue_numbers(bool with_fraction) {
+    std::vector<NumberToken> tokens;
+    for (const char* name : VenueFrames<Parser>::names) {
+        auto venue_tokens = collect_numbers(load_frames(name), with_fraction);
+        tokens.insert(tokens.end(), venue_tokens.begin(), venue_tokens.end());
+    }
+    return tokens;
+}
+
+static void BM_BinanceParseDepthUpdate(benchmark::State& state) {
+    const auto& frames = load_frames("binance_depth");
+    for (auto _ : state) {
+        for (const auto& frame : frames) {
+            OrderBookData book = BinanceFastParser::parse_depth_update(frame.data(), frame.size());
+            benchmark::DoNotOptimize(book);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(frames.size()));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(total_bytes(frames)));
+}
+BENCHMARK(BM_BinanceParseDepthUpdate);
+
+static void BM_CoinbaseParseDepthUpdate(benchmark::State& state) {
+    const auto& frames = load_frames("coinbase_level2");
+    for (auto _ : state) {
+        for (const auto& frame : frames) {
+            OrderBookData book = CoinbaseFastParser::parse_depth_update(frame.data(), frame.size());
+            benchmark::DoNotOptimize(book);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(frames.size()));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(total_bytes(frames)));
+}
+BENCHMARK(BM_CoinbaseParseDepthUpdate);
+
+template<typename Parser>
+static void BM_ParseDouble(benchmark::State& state) {
+    const auto tokens = venue_numbers<Parser>(true);
+    for (auto _ : state) {
+        for (const auto& t : tokens) {
+            benchmark::DoNotOptimize(Parser::parse_double(t.start, t.end));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(tokens.size()));
+}
+BENCHMARK_TEMPLATE(BM_ParseDouble, BinanceFastParser);
+BENCHMARK_TEMPLATE(BM_ParseDouble, CoinbaseFastParser);
+BENCHMARK_TEMPLATE(BM_ParseDouble, KrakenFastParser);
+
+template<typename Parser>
+static void BM_ParseInt64(benchmark::State& state) {
+    const auto tokens = venue_numbers<Parser>(false);
+    for (auto _ : state) {
+        for (const auto& t : tokens) {
+            benchmark::DoNotOptimize(Parser::parse_int64(t.start, t.end));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(tokens.size()));
+}
+BENCHMARK_TEMPLATE(BM_ParseInt64, BinanceFastParser);
+BENCHMARK_TEMPLATE(BM_ParseInt64, CoinbaseFastParser);
+BENCHMARK_TEMPLATE(BM_ParseInt64, KrakenFastParser);
+
+static void BM_KrakenParseTimestamp(benchmark::State& state) {
+    std::vector<NumberToken> tokens;
+    for (const char* name : VenueFrames<KrakenFastParser>::names) {
+        auto venue_tokens = collect_timestamps(load_frames(name), "timestamp");
+        tokens.insert(tokens.end(), venue_tokens.begin(), venue_tokens.end());
+    }
+    for (auto _ : state) {
+        for (const auto& t : tokens) {
+            benchmark::DoNotOptimize(KrakenFastParser::parse_kraken_timestamp(t.start, static_cast<size_t>(t.end - t.start)));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(tokens.size()));
+}
+BENCHMARK(BM_KrakenParseTimestamp);
@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include "bench_frames.hpp"
+#include "binance_data_processor.hpp"
+#include "coinbase_data_processor.hpp"
+#include "kraken_data_processor.hpp"
+
+// Bus with one no-op handler per event type, so publish cost is included but handlers are free
+static std::shared_ptr<EventBus> make_bus() {
+    auto bus = std::make_shared<EventBus>();
+    bus->subscribe<TradeEvent>([](const TradeEvent& e) { benchmark::DoNotOptimize(&e); });
+    bus->subscribe<TickerDataEvent>([](const TickerDataEvent& e) { benchmark::DoNotOptimize(&e); });
+    bus->subscribe<OrderBookDataEvent>([](const OrderBookDataEvent& e) { benchmark::DoNotOptimize(&e); });
+    bus->subscribe<CandleStickDataEvent>([](const CandleStickDataEvent& e) { benchmark::DoNotOptimize(&e); });
+    return bus;
+}
+
+// Runs every frame of one venue channel through the processor's parse-and-publish path
+template<typename Processor>
+static void process_frames(benchmark::State& state, const char* dataset) {
+    const auto& frames = load_frames(dataset);
+    std::vector<RawMessage> messages;
+    messages.reserve(frames.size());
+    for (const auto& frame : frames) {
+        messages.push_back(RawMessage{frame, {}});
+    }
+
+    SPSCQueue<RawMessage> queue(2);
+    Processor processor(queue, make_bus());
+    for (auto _ : state) {
+        for (auto& message : messages) {
+            processor.parse_and_publish(message);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(frames.size()));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(total_bytes(frames)));
+}
+
+static void BM_BinanceProcess(benchmark::State& state, const char* dataset) {
+    process_frames<BinanceDataProcessor>(state, dataset);
+}
+
+static void BM_CoinbaseProcess(benchmark::State& state, const char* dataset) {
+    process_frames<CoinbaseDataProcessor>(state, dataset);
+}
+
+static void BM_KrakenProcess(benchmark::State& state, const char* dataset) {
+    process_frames<KrakenDataProcessor>(state, dataset);
+}
+
+BENCHMARK_CAPTURE(BM_BinanceProcess, binance_depth, "binance_depth");
+BENCHMARK_CAPTURE(BM_BinanceProcess, binance_trade, "binance_trade");
+BENCHMARK_CAPTURE(BM_BinanceProcess, binance_ticker, "binance_ticker");
+BENCHMARK_CAPTURE(BM_BinanceProcess, binance_kline, "binance_kline");
+BENCHMARK_CAPTURE(BM_CoinbaseProcess, coinbase_level2, "coinbase_level2");
+BENCHMARK_CAPTURE(BM_CoinbaseProcess, coinbase_matches, "coinbase_matches");
+BENCHMARK_CAPTURE(BM_CoinbaseProcess, coinbase_ticker, "coinbase_ticker");
+BENCHMARK_CAPTURE(BM_KrakenProcess, kraken_book, "kraken_book");
+BENCHMARK_CAPTURE(BM_KrakenProcess, kraken_trade, "kraken_trade");
+BENCHMARK_CAPTURE(BM_KrakenProcess, kraken_ticker, "kraken_ticker");
+BENCHMARK_CAPTURE(BM_KrakenProcess, kraken_ohlc, "kraken_ohlc");
@@ -0,0 +1,151 @@
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "bench_frames.hpp"
+#include "spsc_queue.hpp"
+#include "mpsc_queue.hpp"
+#include "event_bus.hpp"
+#include "utils.hpp"
+
+static bool cpus_available(benchmark::State& state, int a, int b) {
+    int cpus = static_cast<int>(std::thread::hardware_concurrency());
+    if (a >= cpus || b >= cpus) {
+        state.SkipWithError("not enough CPUs for the requested pinning");
+        return false;
+    }
+    return true;
+}
+
+// Round trip between two pinned threads through a pair of queues; Time is one full ping-pong
+static void BM_SPSCQueuePingPong(benchmark::State& state) {
+    const int main_cpu = static_cast<int>(state.range(0));
+    const int echo_cpu = static_cast<int>(state.range(1));
+    if (!cpus_available(state, main_cpu, echo_cpu)) return;
+
+    SPSCQueue<uint64_t> ping(1024);
+    SPSCQueue<uint64_t> pong(1024);
+    std::atomic<bool> running{true};
+
+    std::thread echo([&] {
+        uint64_t value;
+        while (running.load(std::memory_order_relaxed)) {
+            if (ping.try_pop(value)) {
+                while (!pong.try_push(std::move(value))) {}
+            }
+        }
+    });
+    pin_thread_to_cpu(echo, echo_cpu);
+    pin_current_thread_to_cpu(main_cpu);
+
+    uint64_t seq = 0;
+    uint64_t reply = 0;
+    for (auto _ : state) {
+        uint64_t value = ++seq;
+        while (!ping.try_push(std::move(value))) {}
+        while (!pong.try_pop(reply)) {}
+        benchmark::DoNotOptimize(reply);
+    }
+
+    running.store(false, std::memory_order_relaxed);
+    echo.join();
+}
+BENCHMARK(BM_SPSCQueuePingPong)->Args({2, 3})->Args({2, 4})->UseRealTime();
+
+// One-way throughput of benchmark frames, the way the exchange thread feeds a data processor
+static void BM_SPSCQueueRawMessageThroughput(benchmark::State& state) {
+    const int producer_cpu = static_cast<int>(state.range(0));
+    const int consumer_cpu = static_cast<int>(state.range(1));
+    if (!cpus_available(state, producer_cpu, consumer_cpu)) return;
+
+    const auto& frames = load_frames("binance_depth");
+    SPSCQueue<RawMessage> queue(8192);
+    std::atomic<bool> running{true};
+    std::atomic<uint64_t> consumed{0};
+
+    std::thread consumer([&] {
+        RawMessage message;
+        uint64_t count = 0;
+        while (running.load(std::memory_order_relaxed)) {
+            if (queue.try_pop(message)) {
+                benchmark::DoNotOptimize(message.payload.data());
+                consumed.store(++count, std::memory_order_release);
+            }
+        }
+    });
+    pin_thread_to_cpu(consumer, consumer_cpu);
+    pin_current_thread_to_cpu(producer_cpu);
+
+    uint64_t produced = 0;
+    for (auto _ : state) {
+        RawMessage message{frames[produced % frames.size()], {}};
+        while (!queue.try_push(std::move(message))) {}
+        ++produced;
+    }
+    while (consumed.load(std::memory_order_acquire) < produced) {}
+
+    running.store(false, std::memory_order_relaxed);
+    consumer.join();
+    state.SetItemsProcessed(static_cast<int64_t>(produced));
+}
+BENCHMARK(BM_SPSCQueueRawMessageThroughput)->Args({2, 3})->UseRealTime();
+
+// Fan-in: range(0) producer threads on CPUs 3.. push into one queue drained on CPU 2, the
+// way several parser threads feed one strategy thread. Items are counted at the consumer.
+static void BM_MPSCQueueFanIn(benchmark::State& state) {
+    const int producers = static_cast<int>(state.range(0));
+    const int consumer_cpu = 2;
+    if (!cpus_available(state, consumer_cpu, consumer_cpu + producers)) return;
+
+    MPSCQueue<uint64_t> queue(8192);
+    std::atomic<bool> running{true};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&] {
+            uint64_t value = 0;
+            while (running.load(std::memory_order_relaxed)) {
+                uint64_t item = ++value;
+                queue.try_push(std::move(item));
+            }
+        });
+        pin_thread_to_cpu(threads.back(), consumer_cpu + 1 + p);
+    }
+    pin_current_thread_to_cpu(consumer_cpu);
+
+    uint64_t value = 0;
+    for (auto _ : state) {
+        while (!queue.try_pop(value)) {}
+        benchmark::DoNotOptimize(value);
+    }
+
+    running.store(false, std::memory_order_relaxed);
+    for (auto& t : threads) t.join();
+    state.SetItemsProcessed(state.iterations());
+    state.counters["producers"] = producers;
+}
+BENCHMARK(BM_MPSCQueueFanIn)->DenseRange(1, 3)->UseRealTime();
+
+static void BM_EventBusPublish(benchmark::State& state) {
+    const int subscribers = static_cast<int>(state.range(0));
+    EventBus bus;
+    uint64_t delivered = 0;
+    for (int i = 0; i < subscribers; ++i) {
+        bus.subscribe<TradeEvent>([&delivered](const TradeEvent& e) {
+            benchmark::DoNotOptimize(e.data.price);
+            ++delivered;
+        });
+    }
+
+    TradeEvent event;
+    event.data.source = "Binance";
+    event.data.symbol = "BTCUSDT";
+    event.data.price = 63250.12;
+    event.data.quantity = 0.015;
+    for (auto _ : state) {
+        bus.publish(event);
+    }
+    benchmark::DoNotOptimize(delivered);
+    state.SetItemsProcessed(state.iterations());
+    state.counters["subscribers"] = subscribers;
+}
+BENCHMARK(BM_EventBusPublish)->RangeMultiplier(2)->Range(1, 32);
@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include "risk_engine.hpp"
+
+static std::unique_ptr<RiskEngine> make_engine(uint32_t instruments) {
+    auto engine = std::make_unique<RiskEngine>();
+    RiskLimits limits;
+    limits.max_position = 10.0;
+    limits.max_notional = 1'000'000.0;
+    limits.max_price_deviation = 0.05;
+    limits.max_orders_per_window = UINT32_MAX;
+    limits.order_window_ns = 1'000'000'000;
+    for (uint32_t id = 0; id < instruments; ++id) {
+        engine->set_limits(id, limits);
+        engine->update_reference_price(id, 50'000.0, 50'001.0);
+    }
+    return engine;
+}
+
+// Accepted orders run every check, so this is the worst case
+static void BM_RiskCheckAccepted(benchmark::State& state) {
+    const uint32_t instruments = static_cast<uint32_t>(state.range(0));
+    auto engine = make_engine(instruments);
+
+    OrderRequest order{};
+    order.side = Side::Buy;
+    order.type = OrderType::Limit;
+    order.price = 50'000.5;
+    order.quantity = 0.01;
+
+    int64_t now = 0;
+    uint32_t id = 0;
+    for (auto _ : state) {
+        order.instrument_id = id;
+        benchmark::DoNotOptimize(engine->check(order, ++now));
+        id = id + 1 == instruments ? 0 : id + 1;
+    }
+}
+BENCHMARK(BM_RiskCheckAccepted)->Arg(1)->Arg(100)->Arg(1000);
+
+static void BM_RiskCheckKillSwitch(benchmark::State& state) {
+    auto engine = make_engine(1);
+    engine->activate_kill_switch();
+
+    OrderRequest order{};
+    order.side = Side::Sell;
+    order.type = OrderType::Limit;
+    order.price = 50'000.0;
+    order.quantity = 0.01;
+
+    int64_t now = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(engine->check(order, ++now));
+    }
+}
+BENCHMARK(BM_RiskCheckKillSwitch);
+
+static void BM_RiskOnFill(benchmark::State& state) {
+    auto engine = make_engine(1);
+    for (auto _ : state) {
+        engine->on_fill(0, Side::Buy, 0.01);
+        engine->on_fill(0, Side::Sell, 0.01);
+    }
+    benchmark::DoNotOptimize(engine->position(0));
+}
+BENCHMARK(BM_RiskOnFill);
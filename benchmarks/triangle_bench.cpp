@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include "instrument_registry.hpp"
+#include "level_book.hpp"
+#include "triangle_scanner.hpp"
+
+// A Binance-like graph of ~500 pairs: 166 coins quoted in USDT, BTC and ETH, plus BTCUSDT,
+// ETHUSDT and ETHBTC. BTCUSDT is the busiest pair (one triangle per coin quoted in BTC); a
+// coin's pair sits in 2 triangles. Prices are consistent, so no cycle clears the fee.
+struct TriangleGraph {
+    InstrumentRegistry registry;
+    std::vector<LevelBook::TopOfBook> tops;
+
+    TriangleGraph() {
+        add("BTCUSDT", 60000.0);
+        add("ETHUSDT", 3000.0);
+        add("ETHBTC", 0.05);
+        for (int i = 0; i < 166; ++i) {
+            const std::string coin = "C" + std::to_string(i);
+            const double usdt = 1.0 + i;
+            add(coin + "USDT", usdt);
+            add(coin + "BTC", usdt / 60000.0);
+            add(coin + "ETH", usdt / 3000.0);
+        }
+    }
+
+    void add(const std::string& symbol, double mid) {
+        registry.add("Binance", symbol);
+        tops.push_back(LevelBook::TopOfBook{mid * 0.9999, 1.0, mid * 1.0001, 1.0});
+    }
+};
+
+static void prime(TriangleScanner& scanner, const TriangleGraph& graph) {
+    for (uint32_t id = 0; id < graph.tops.size(); ++id) {
+        scanner.update(id, graph.tops[id], [](uint32_t, double) {});
+    }
+}
+
+// Updates cycling through every pair, the average cost per top-of-book change
+static void BM_TriangleUpdateAllPairs(benchmark::State& state) {
+    TriangleGraph graph;
+    TriangleScanner scanner(graph.registry, "Binance", 0.001, 0.0);
+    prime(scanner, graph);
+    uint32_t id = 0;
+    size_t found = 0;
+    for (auto _ : state) {
+        LevelBook::TopOfBook& top = graph.tops[id];
+        top.bid_quantity = top.bid_quantity == 1.0 ? 2.0 : 1.0;
+        found += scanner.update(id, top, [](uint32_t, double) {});
+        id = id + 1 < graph.tops.size() ? id + 1 : 0;
+    }
+    benchmark::DoNotOptimize(found);
+    state.counters["pairs"] = static_cast<double>(graph.tops.size());
+    state.counters["cycles"] = static_cast<double>(scanner.cycles());
+}
+BENCHMARK(BM_TriangleUpdateAllPairs);
+
+// The worst case: BTCUSDT, through which a third of all cycles run
+static void BM_TriangleUpdateBusiestPair(benchmark::State& state) {
+    TriangleGraph graph;
+    TriangleScanner scanner(graph.registry, "Binance", 0.001, 0.0);
+    prime(scanner, graph);
+    LevelBook::TopOfBook top = graph.tops[0];
+    size_t found = 0;
+    for (auto _ : state) {
+        top.bid_price = top.bid_price == 59994.0 ? 59995.0 : 59994.0;
+        found += scanner.update(0, top, [](uint32_t, double) {});
+    }
+    benchmark::DoNotOptimize(found);
+}
+BENCHMARK(BM_TriangleUpdateBusiestPair);
@@ -0,0 +1,182 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "level_book.hpp"
+
+/**
+ * @class ArbScanner
+ * @brief Best bid/ask of every instrument on every venue, scanned for cross-venue arbitrage.
+ *
+ * One row per symbol, one column per venue. Each row keeps its quotes as fixed-width arrays of
+ * MAX_VENUES doubles (one AVX2 register), already adjusted for that venue's taker fee, with
+ * empty slots at -inf/+inf so they never clear. A venue update rewrites one slot and
+ * re-evaluates that row only: for each buy venue, the sell side of every venue is checked in
+ * one branch-free pass over the row, which the compiler vectorizes. Each row remembers its
+ * best (buy venue, sell venue) pair, and ranked() orders the rows by that pair's profit.
+ *
+ * Profit is what the top levels alone can execute: min(ask size, bid size) times the
+ * after-fee spread. It ranks candidates cheaply; sizing an order deeper than the top of book
+ * is up to the caller (see walk_cross). Rows must quote the same asset in the same quote
+ * currency on every venue. Single-threaded.
+ */
+class ArbScanner {
+public:
+    static constexpr size_t MAX_VENUES = 4;
+
+    struct Opportunity {
+        uint32_t row = 0;
+        uint32_t buy_venue = 0;
+        uint32_t sell_venue = 0;
+        double buy_price = 0.0;  // Best ask on the buy venue
+        double sell_price = 0.0; // Best bid on the sell venue
+        double quantity = 0.0;
+        double profit = 0.0;     // After taker fees on both legs; 0 if the row has nothing
+    };
+
+    /**
+     * @param taker_fees One per venue, as a fraction of notional; the venue count is its size.
+     * @param min_profit Minimum profit as a fraction of the bought notional.
+     */
+    ArbScanner(const std::vector<double>& taker_fees, double min_profit) : venues_(taker_fees.size()) {
+        if (venues_ < 2 || venues_ > MAX_VENUES) {
+            throw std::invalid_argument("ArbScanner: needs 2 to " + std::to_string(MAX_VENUES) + " venues");
+        }
+        for (size_t v = 0; v < venues_; ++v) {
+            sell_factor_[v] = 1.0 - taker_fees[v];
+            buy_factor_[v] = 1.0 + taker_fees[v];
+            hurdle_factor_[v] = 1.0 + taker_fees[v] + min_profit;
+        }
+    }
+
+    // Startup only
+    uint32_t add_row() {
+        quotes_.emplace_back();
+        best_.push_back(Opportunity{static_cast<uint32_t>(best_.size())});
+        return static_cast<uint32_t>(quotes_.size() - 1);
+    }
+
+    // Startup only: the instrument (an InstrumentRegistry id) quotes `row` on `venue`
+    void bind(uint32_t instrument, uint32_t row, uint32_t venue) {
+        if (row >= quotes_.size() || venue >= venues_) {
+            throw std::invalid_argument("ArbScanner: bad row or venue for instrument " + std::to_string(instrument));
+        }
+        if (instrument >= slots_.size()) slots_.resize(instrument + 1);
+        slots_[instrument] = Slot{row, venue};
+    }
+
+    // Returns true if the instrument's row holds an opportunity after the update
+    bool update(uint32_t instrument, const LevelBook::TopOfBook& top) {
+        if (instrument >= slots_.size() || slots_[instrument].row == NO_ROW) {
+            return false;
+        }
+        const Slot slot = slots_[instrument];
+        set_quote(quotes_[slot.row], slot.venue, top);
+        evaluate(slot.row);
+        return best_[slot.row].profit > 0.0;
+    }
+
+    // Feed lost or stale: every quote from the venue is void until it updates again
+    void clear_venue(uint32_t venue) {
+        if (venue >= venues_) return;
+        for (uint32_t row = 0; row < quotes_.size(); ++row) {
+            set_quote(quotes_[row], venue, LevelBook::TopOfBook{});
+            evaluate(row);
+        }
+    }
+
+    const Opportunity& best(uint32_t row) const { return best_[row]; }
+
+    // Fills `out` with up to `max` opportunities, most profitable first; returns how many
+    size_t ranked(std::vector<Opportunity>& out, size_t max) const {
+        out.clear();
+        for (const auto& opp : best_) {
+            if (opp.profit > 0.0) out.push_back(opp);
+        }
+        const size_t n = std::min(max, out.size());
+        std::partial_sort(out.begin(), out.begin() + n, out.end(),
+                          [](const Opportunity& a, const Opportunity& b) { return a.profit > b.profit; });
+        out.resize(n);
+        return n;
+    }
+
+    size_t rows() const { return quotes_.size(); }
+    size_t venues() const { return venues_; }
+
+private:
+    static constexpr uint32_t NO_ROW = UINT32_MAX;
+    static constexpr double INF = std::numeric_limits<double>::infinity();
+
+    struct Slot {
+        uint32_t row = NO_ROW;
+        uint32_t venue = 0;
+    };
+
+    // One row of the matrix; each field is one vector register wide
+    struct alignas(64) Quotes {
+        double bid[MAX_VENUES] = {-INF, -INF, -INF, -INF};    // Best bid after the sell-side fee
+        double ask[MAX_VENUES] = {INF, INF, INF, INF};        // Best ask after the buy-side fee
+        double hurdle[MAX_VENUES] = {INF, INF, INF, INF};     // Ask the sell bid must beat, fee and min profit included
+        double bid_quantity[MAX_VENUES] = {};
+        double ask_quantity[MAX_VENUES] = {};
+        double bid_price[MAX_VENUES] = {};
+        double ask_price[MAX_VENUES] = {};
+    };
+
+    void set_quote(Quotes& q, uint32_t v, const LevelBook::TopOfBook& top) const {
+        const bool has_bid = top.bid_quantity > 0.0;
+        const bool has_ask = top.ask_quantity > 0.0;
+        q.bid[v] = has_bid ? top.bid_price * sell_factor_[v] : -INF;
+        q.ask[v] = has_ask ? top.ask_price * buy_factor_[v] : INF;
+        q.hurdle[v] = has_ask ? top.ask_price * hurdle_factor_[v] : INF;
+        q.bid_quantity[v] = top.bid_quantity;
+        q.ask_quantity[v] = top.ask_quantity;
+        q.bid_price[v] = top.bid_price;
+        q.ask_price[v] = top.ask_price;
+    }
+
+    void evaluate(uint32_t row) {
+        const Quotes& q = quotes_[row];
+        Opportunity& best = best_[row];
+        best.profit = 0.0;
+        for (size_t buy = 0; buy < venues_; ++buy) {
+            const double ask = q.ask[buy];
+            const double hurdle = q.hurdle[buy];
+            const double ask_quantity = q.ask_quantity[buy];
+            // Every sell venue at once; empty slots and buy == sell never clear the hurdle.
+            // Kept rolled so GCC vectorizes it instead of unrolling it into scalar code; 64-bit
+            // lane indices keep the compare as wide as the doubles
+            double profit[MAX_VENUES];
+#pragma GCC unroll 1
+            for (size_t sell = 0; sell < MAX_VENUES; ++sell) {
+                const double quantity = std::min(ask_quantity, q.bid_quantity[sell]);
+                const double p = quantity * (q.bid[sell] - ask);
+                profit[sell] = q.bid[sell] > hurdle && sell != buy ? p : 0.0;
+            }
+            for (size_t sell = 0; sell < MAX_VENUES; ++sell) {
+                if (profit[sell] > best.profit) {
+                    best.buy_venue = static_cast<uint32_t>(buy);
+                    best.sell_venue = static_cast<uint32_t>(sell);
+                    best.profit = profit[sell];
+                }
+            }
+        }
+        if (best.profit > 0.0) {
+            best.buy_price = q.ask_price[best.buy_venue];
+            best.sell_price = q.bid_price[best.sell_venue];
+            best.quantity = std::min(q.ask_quantity[best.buy_venue], q.bid_quantity[best.sell_venue]);
+        }
+    }
+
+    const size_t venues_;
+    double sell_factor_[MAX_VENUES] = {};
+    double buy_factor_[MAX_VENUES] = {};
+    double hurdle_factor_[MAX_VENUES] = {};
+    std::vector<Quotes> quotes_;
+    std::vector<Opportunity> best_;
+    std::vector<Slot> slots_; // By instrument id
+};
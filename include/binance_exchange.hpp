@@ -2,15 +2,21 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <atomic>
+#include <optional>
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/ssl/context.hpp>
 #include <boost/beast/websocket/stream.hpp>
 #include <boost/beast/ssl.hpp>
-#include <boost/beast/core/flat_buffer.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/json.hpp>
+#include "feed_supervisor.hpp"
 #include "iexchange.hpp"
+#include "outbound_queue.hpp"
+#include "payload_buffer.hpp"
+#include "socket_tuning.hpp"
 #include "spsc_queue.hpp"
+#include "types.hpp"
 
 namespace beast = boost::beast;
 namespace net = boost::asio;
@@ -23,15 +29,23 @@ private:
     net::io_context ioc_;
     ssl::context ctx_;
     tcp::resolver resolver_;
-    beast::websocket::stream<beast::ssl_stream<tcp::socket>> ws_;
-    beast::flat_buffer buffer_;
+    std::optional<beast::websocket::stream<beast::ssl_stream<FeedSocket>>> ws_; // Recreated per connection
+    PayloadBuffer buffer_; // Frames are read, and inflated, straight into the payload
     std::string host_;
     std::string host_header_;
     std::string port_;
     std::string target_;
     boost::json::object subscription_info_;
-    SPSCQueue<std::string>& queue_;
+    SPSCQueue<RawMessage>& queue_;
+    std::atomic<uint64_t> dropped_messages_{0}; // Written by the I/O thread only
+    FeedSupervisor supervisor_;
+    bool compression_ = true;
+    SocketTuning socket_tuning_;
+    OutboundQueue<beast::websocket::stream<beast::ssl_stream<FeedSocket>>> outbound_; // Every write goes through here
 
+    void connect();
+    void teardown();
+    void fail(const char* what, boost::system::error_code ec);
     void on_resolve(boost::system::error_code ec, tcp::resolver::results_type results);
     void on_connect(boost::system::error_code ec, tcp::resolver::results_type::endpoint_type ep);
     void on_ssl_handshake(boost::system::error_code ec);
@@ -39,14 +53,20 @@ private:
     void on_read(boost::system::error_code ec, std::size_t bytes_transferred);
 
 public:
-    BinanceExchange(SPSCQueue<std::string>& queue);
+    BinanceExchange(SPSCQueue<RawMessage>& queue);
     ~BinanceExchange() noexcept override;
     void initialize(const std::string_view& host, const std::string_view& port, const std::string_view& target,
                     const boost::json::object& subscription_info) override;
     net::io_context& get_io_context() override;
-    void start_async() override;
+    void start() override;
     void run() override;
     void stop() override;
     void send_message(const std::string& message) override;
     void read_message() override;
+    uint64_t dropped_messages() const override { return dropped_messages_.load(std::memory_order_relaxed); }
+    void set_reconnect_policy(const ReconnectPolicy& policy) { supervisor_.set_policy(policy); }
+    // Offer permessage-deflate on the next connection (on by default)
+    void set_compression(bool enabled) { compression_ = enabled; }
+    // Applied to every connection once TCP is up
+    void set_socket_tuning(const SocketTuning& tuning) { socket_tuning_ = tuning; }
 };
\ No newline at end of file
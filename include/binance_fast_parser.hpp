@@ -162,9 +162,8 @@ public:
         if (E_start) {
             const char* E_end = E_start;
             while (E_end < end && (*E_end >= '0' && *E_end <= '9')) ++E_end;
-            // result.event_time = parse_int64(E_start, E_end);
-            result.timestamp = get_time_now_nano();
-        
+            // Event time is in milliseconds
+            result.timestamp = parse_int64(E_start, E_end) * 1'000'000;
         }
 
         // Parse symbol "s"
@@ -180,7 +179,7 @@ public:
         if (U_start) {
             const char* U_end = U_start;
             while (U_end < end && (*U_end >= '0' && *U_end <= '9')) ++U_end;
-            result.id = parse_int64(U_start, U_end);
+            result.first_id = parse_int64(U_start, U_end);
         }
 
         // Parse final update ID "u"
@@ -195,12 +194,12 @@ public:
         const char* b_start = find_value_after_key(json, end, "b", 1);
         if (b_start) {
             const char* b_end = b_start;
-            int bracket_count = 1;
-            while (b_end < end && bracket_count > 0) {
+            int bracket_count = 0; // b_start is the outer '[' itself, so stop where it closes
+            do {
                 if (*b_end == '[') ++bracket_count;
                 if (*b_end == ']') --bracket_count;
                 ++b_end;
-            }
+            } while (b_end < end && bracket_count > 0);
             result.bids = parse_array(b_start, b_end);
         }
 
@@ -208,18 +207,46 @@ public:
         const char* a_start = find_value_after_key(json, end, "a", 1);
         if (a_start) {
             const char* a_end = a_start;
-            int bracket_count = 1;
-            while (a_end < end && bracket_count > 0) {
+            int bracket_count = 0;
+            do {
                 if (*a_end == '[') ++bracket_count;
                 if (*a_end == ']') --bracket_count;
                 ++a_end;
-            }
+            } while (a_end < end && bracket_count > 0);
             result.asks = parse_array(a_start, a_end);
         }
 
         return result;
     }
 
+    // Parse a partial book depth frame (<symbol>@depth<levels>): the top levels as a whole-book
+    // snapshot. It names no symbol; the caller takes it from the stream name
+    static inline OrderBookData parse_partial_depth(const char* json, size_t len) {
+        OrderBookData result;
+        result.snapshot = true;
+        const char* end = json + len;
+
+        const char* id_start = find_value_after_key(json, end, "lastUpdateId", 12);
+        if (id_start) result.id = parse_int64(id_start, end);
+
+        const char* sides[2] = {find_value_after_key(json, end, "bids", 4), find_value_after_key(json, end, "asks", 4)};
+        for (int s = 0; s < 2; ++s) {
+            const char* side_end = sides[s];
+            if (!side_end) continue;
+            int bracket_count = 0;
+            while (side_end < end) {
+                if (*side_end == '[') ++bracket_count;
+                if (*side_end == ']' && --bracket_count == 0) {
+                    ++side_end;
+                    break;
+                }
+                ++side_end;
+            }
+            (s == 0 ? result.bids : result.asks) = parse_array(sides[s], side_end);
+        }
+        return result;
+    }
+
     static inline TickerData parse_ticker(const char* json, size_t len) {
         
     }
@@ -0,0 +1,278 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "event_bus.hpp"
+#include "event_fan_in.hpp"
+#include "instrument_registry.hpp"
+#include "types.hpp"
+
+/**
+ * @struct BarSpec
+ * @brief What closes a bar: elapsed time, traded volume or trade count.
+ */
+struct BarSpec {
+    enum class Kind : uint8_t {
+        Time,   // Aligned to multiples of interval_ns since the epoch, closed by the timer
+        Volume, // Closed by the trade that brings volume to the threshold
+        Tick    // Closed by the trade that brings trade_count to the threshold
+    };
+
+    Kind kind = Kind::Time;
+    int64_t interval_ns = 0;
+    double volume = 0.0;
+    int64_t ticks = 0;
+    std::string label; // CandleStickData::interval of the bars, e.g. "1m"
+
+    /**
+     * @brief "250ms", "1s", "5m", "1h" for time bars, "10vol" for volume bars, "100tick" for
+     *        tick bars; the text becomes the label. Throws std::invalid_argument otherwise.
+     */
+    static BarSpec parse(std::string_view text) {
+        size_t digits = 0;
+        while (digits < text.size() && ((text[digits] >= '0' && text[digits] <= '9') || text[digits] == '.')) {
+            ++digits;
+        }
+        const std::string number(text.substr(0, digits));
+        const std::string_view unit = text.substr(digits);
+        double n = 0.0;
+        try {
+            n = std::stod(number);
+        } catch (const std::exception&) {
+            throw std::invalid_argument("BarSpec: bad bar size '" + std::string(text) + "'");
+        }
+        if (!(n > 0.0)) throw std::invalid_argument("BarSpec: bar size must be positive in '" + std::string(text) + "'");
+
+        BarSpec spec;
+        spec.label = std::string(text);
+        if (unit == "vol") {
+            spec.kind = Kind::Volume;
+            spec.volume = n;
+            return spec;
+        }
+        if (unit == "tick") {
+            spec.kind = Kind::Tick;
+            spec.ticks = static_cast<int64_t>(n);
+            if (spec.ticks < 1) throw std::invalid_argument("BarSpec: tick bars need at least one trade");
+            return spec;
+        }
+        double unit_ns = 0.0;
+        if (unit == "ms") unit_ns = 1e6;
+        else if (unit == "s") unit_ns = 1e9;
+        else if (unit == "m") unit_ns = 60e9;
+        else if (unit == "h") unit_ns = 3600e9;
+        else throw std::invalid_argument("BarSpec: unknown unit in '" + std::string(text) + "'");
+        spec.interval_ns = static_cast<int64_t>(n * unit_ns);
+        if (spec.interval_ns < 1'000'000) throw std::invalid_argument("BarSpec: time bars must be at least 1ms");
+        return spec;
+    }
+};
+
+/**
+ * @class CandleAggregator
+ * @brief Builds OHLCV bars of one BarSpec from trades, for every instrument of a registry.
+ *
+ * Each instrument's open bar is one 64-byte CandleBar in a flat array indexed by instrument
+ * id, so a trade updates a single cache line. Volume and tick bars close on the trade that
+ * fills them. Time bars close either on the first trade past their end or on on_timer(): all
+ * open time bars end on the same interval boundaries, so on_timer() is one compare until a
+ * boundary passes and then a single sweep over the array. An interval without trades
+ * produces no bar.
+ *
+ * A trade stamped before its instrument's open time bar (out of order, or arriving after the
+ * timer closed its bar) is folded into the open or next bar and counted in late(), so no
+ * interval is ever emitted twice. Single-threaded.
+ */
+class CandleAggregator {
+public:
+    struct alignas(64) CandleBar {
+        int64_t open_time = 0;   // Bar start; first trade time for volume and tick bars
+        int64_t close_time = 0;  // Bar end (exclusive) for time bars, last trade time otherwise
+        double open = 0.0;
+        double high = 0.0;
+        double low = 0.0;
+        double close = 0.0;
+        double volume = 0.0;
+        int64_t trade_count = 0; // 0 while no bar is open
+    };
+
+    CandleAggregator(size_t instruments, BarSpec spec) : spec_(std::move(spec)), bars_(instruments) {}
+
+    /**
+     * @brief Adds a trade; calls emit(instrument, bar) for the bar it closes, if any.
+     */
+    template<typename Emit>
+    void on_trade(uint32_t instrument, int64_t timestamp, double price, double quantity, Emit&& emit) {
+        CandleBar& bar = bars_[instrument];
+        if (spec_.kind == BarSpec::Kind::Time) {
+            if (bar.trade_count > 0 && timestamp >= bar.close_time) {
+                close(instrument, emit);
+            }
+            if (bar.trade_count == 0) {
+                // A straggler for a bar already emitted goes into the next one
+                int64_t t = timestamp;
+                if (t < bar.close_time) {
+                    t = bar.close_time;
+                    ++late_;
+                }
+                const int64_t start = t - floor_mod(t, spec_.interval_ns);
+                open(bar, start, start + spec_.interval_ns, price);
+                next_close_ = std::min(next_close_, bar.close_time);
+            } else if (timestamp < bar.open_time) {
+                ++late_;
+            }
+        } else if (bar.trade_count == 0) {
+            open(bar, timestamp, timestamp, price);
+        }
+
+        bar.high = std::max(bar.high, price);
+        bar.low = std::min(bar.low, price);
+        bar.close = price;
+        bar.volume += quantity;
+        ++bar.trade_count;
+
+        if (spec_.kind == BarSpec::Kind::Volume || spec_.kind == BarSpec::Kind::Tick) {
+            bar.close_time = std::max(bar.close_time, timestamp);
+            const bool full = spec_.kind == BarSpec::Kind::Volume ? bar.volume >= spec_.volume
+                                                                  : bar.trade_count >= spec_.ticks;
+            if (full) {
+                close(instrument, emit);
+            }
+        }
+    }
+
+    /**
+     * @brief Closes every time bar that ends at or before `now`.
+     *
+     * Pass the clock the trade timestamps are on, minus any grace period for trades still in
+     * flight; in replay, the latest trade time.
+     */
+    template<typename Emit>
+    void on_timer(int64_t now, Emit&& emit) {
+        if (spec_.kind != BarSpec::Kind::Time || now < next_close_) {
+            return;
+        }
+        next_close_ = std::numeric_limits<int64_t>::max();
+        for (uint32_t id = 0; id < bars_.size(); ++id) {
+            const CandleBar& bar = bars_[id];
+            if (bar.trade_count == 0) continue;
+            if (bar.close_time <= now) {
+                close(id, emit);
+            } else {
+                next_close_ = std::min(next_close_, bar.close_time);
+            }
+        }
+    }
+
+    // Closes every open bar, complete or not, e.g. at shutdown
+    template<typename Emit>
+    void flush(Emit&& emit) {
+        for (uint32_t id = 0; id < bars_.size(); ++id) {
+            if (bars_[id].trade_count > 0) close(id, emit);
+        }
+        next_close_ = std::numeric_limits<int64_t>::max();
+    }
+
+    const BarSpec& spec() const { return spec_; }
+    const CandleBar& bar(uint32_t instrument) const { return bars_[instrument]; }
+    uint64_t late() const { return late_; }
+
+private:
+    static int64_t floor_mod(int64_t a, int64_t b) {
+        const int64_t m = a % b;
+        return m < 0 ? m + b : m;
+    }
+
+    static void open(CandleBar& bar, int64_t open_time, int64_t close_time, double price) {
+        bar = CandleBar{open_time, close_time, price, price, price, price, 0.0, 0};
+    }
+
+    template<typename Emit>
+    void close(uint32_t instrument, Emit& emit) {
+        emit(instrument, bars_[instrument]);
+        bars_[instrument].trade_count = 0;
+    }
+
+    const BarSpec spec_;
+    std::vector<CandleBar> bars_; // By instrument id
+    int64_t next_close_ = std::numeric_limits<int64_t>::max(); // Earliest end of an open time bar
+    uint64_t late_ = 0;
+};
+
+/**
+ * @class TradeCandles
+ * @brief Local candles for every instrument of a registry, at several BarSpecs, from the
+ *        venues' trade streams instead of their kline channels.
+ *
+ * Trades are collected from every pipeline by an EventFanIn, so all aggregation runs on the
+ * thread that calls poll(), keyed by the instrument id the fan-in resolved. Finished bars come
+ * out as CandleStickData with the source and symbol of the registry and the spec's label as
+ * interval; poll() runs outside any bus handler, so emit may publish them as
+ * CandleStickDataEvents.
+ */
+class TradeCandles {
+public:
+    TradeCandles(std::shared_ptr<EventBus> event_bus, const InstrumentRegistry& registry,
+                 const std::vector<BarSpec>& specs, size_t queue_capacity = 65536)
+        : registry_(registry), trades_(std::move(event_bus), registry, queue_capacity) {
+        aggregators_.reserve(specs.size());
+        for (const auto& spec : specs) {
+            aggregators_.emplace_back(registry.size(), spec);
+        }
+    }
+
+    /**
+     * @brief Aggregates the trades queued so far, then closes the time bars that ended by
+     *        `now`. Calls emit(const CandleStickData&) per finished bar.
+     */
+    template<typename Emit>
+    void poll(int64_t now, Emit&& emit) {
+        TradeEvent trade;
+        uint32_t id;
+        while (trades_.try_pop(id, trade)) {
+            for (auto& aggregator : aggregators_) {
+                aggregator.on_trade(id, trade.data.trade_time, trade.data.price, trade.data.quantity,
+                                    [&](uint32_t instrument, const CandleAggregator::CandleBar& bar) {
+                                        emit(to_candle(aggregator, instrument, bar));
+                                    });
+            }
+        }
+        for (auto& aggregator : aggregators_) {
+            aggregator.on_timer(now, [&](uint32_t instrument, const CandleAggregator::CandleBar& bar) {
+                emit(to_candle(aggregator, instrument, bar));
+            });
+        }
+    }
+
+    uint64_t dropped_trades() const { return trades_.dropped(); }
+
+private:
+    CandleStickData to_candle(const CandleAggregator& aggregator, uint32_t instrument,
+                              const CandleAggregator::CandleBar& bar) const {
+        const InstrumentInfo& info = registry_.info(instrument);
+        CandleStickData candle{};
+        candle.open_time = bar.open_time;
+        candle.close_time = bar.close_time;
+        candle.trade_count = bar.trade_count;
+        candle.open = bar.open;
+        candle.high = bar.high;
+        candle.low = bar.low;
+        candle.close = bar.close;
+        candle.volume = bar.volume;
+        candle.source = info.source;
+        candle.symbol = info.symbol;
+        candle.interval = aggregator.spec().label;
+        return candle;
+    }
+
+    const InstrumentRegistry& registry_;
+    EventFanIn<TradeEvent> trades_;
+    std::vector<CandleAggregator> aggregators_;
+};
@@ -2,6 +2,12 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/ssl/context.hpp>
 #include <boost/beast/websocket/stream.hpp>
@@ -9,8 +15,12 @@
 #include <boost/beast/core/flat_buffer.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/json.hpp>
+#include "feed_supervisor.hpp"
 #include "iexchange.hpp"
+#include "outbound_queue.hpp"
+#include "socket_tuning.hpp"
 #include "spsc_queue.hpp"
+#include "types.hpp"
 
 namespace beast = boost::beast;
 namespace net = boost::asio;
@@ -19,12 +29,21 @@ using tcp = net::ip::tcp;
 namespace json = boost::json;
 
 class CoinbaseExchange : public IExchange, public std::enable_shared_from_this<CoinbaseExchange> {
+public:
+    // Level 2 book kept from the WebSocket feed and REST snapshots, for snapshot_orderbook()
+    struct OrderBook {
+        std::map<double, double, std::greater<double>> bids;
+        std::map<double, double> asks;
+        int64_t last_sequence = 0;
+    };
+
 private:
     net::io_context ioc_;
     ssl::context ctx_;
     tcp::resolver resolver_;
-    beast::websocket::stream<beast::ssl_stream<tcp::socket>> ws_;
+    std::optional<beast::websocket::stream<beast::ssl_stream<FeedSocket>>> ws_; // Recreated per connection
     beast::flat_buffer buffer_;
+    bool running_ = false;
 
 
     std::string host_;
@@ -35,7 +54,15 @@ private:
     std::vector<std::string> channels_;
 
     boost::json::object subscription_info_;
-    SPSCQueue<std::string>& queue_;
+    SPSCQueue<RawMessage>& queue_;
+    std::atomic<uint64_t> dropped_messages_{0}; // Written by the I/O thread only
+    FeedSupervisor supervisor_;
+    bool compression_ = true;
+    SocketTuning socket_tuning_;
+    OutboundQueue<beast::websocket::stream<beast::ssl_stream<FeedSocket>>> outbound_; // Every write goes through here
+
+    std::mutex orderbook_mutex_;
+    OrderBook orderbook_;
 
     // Authentication credentials
     std::string api_key_;
@@ -48,16 +75,28 @@ private:
     void on_ssl_handshake(boost::system::error_code ec);
     void on_handshake(boost::system::error_code ec);
     void on_read(boost::system::error_code ec, std::size_t bytes_transferred);
+    void connect();
+    void teardown();
+    void fail(const char* what, boost::system::error_code ec);
+    std::string subscription_message(const char* type) const;
+
+    // Book maintenance and recovery
+    void handle_snapshot_msg(const json::object& obj);
+    void handle_l2update_msg(const json::object& obj);
+    void handle_full_msg(const json::object& obj);
+    void recover_snapshot_for_product(const std::string& product_id);
+    bool fetch_level2_snapshot(const std::string& product_id);
 
     // Authentication helper methods
-    std::string create_jwt_token(const std::string& request_path) const;
+    std::string create_signature(const std::string& timestamp, const std::string& method,
+                                 const std::string& request_path, const std::string& body) const;
     std::string base64_encode(const std::string& input) const;
     std::string base64_decode(const std::string& input) const;
-    std::string hmac_sha256(const std::string& key, const std::string& data) const;
+    std::string hmac_sha256_raw(const std::string& key, const std::string& data) const;
     std::string get_timestamp() const;
 
 public:
-    CoinbaseExchange(SPSCQueue<std::string>& queue);
+    CoinbaseExchange(SPSCQueue<RawMessage>& queue);
     ~CoinbaseExchange() noexcept override;
 
     void set_credentials(const std::string& api_key, const std::string& api_secret, 
@@ -66,9 +105,16 @@ public:
                     const boost::json::object& subscription_info) override;
     net::io_context& get_io_context() override;
 
-    void start_async() override;
+    void start() override;
     void run() override;
     void stop() override;
     void send_message(const std::string& message) override;
     void read_message() override;
+    uint64_t dropped_messages() const override { return dropped_messages_.load(std::memory_order_relaxed); }
+    void set_reconnect_policy(const ReconnectPolicy& policy) { supervisor_.set_policy(policy); }
+    // Offer permessage-deflate on the next connection (on by default)
+    void set_compression(bool enabled) { compression_ = enabled; }
+    // Applied to every connection once TCP is up
+    void set_socket_tuning(const SocketTuning& tuning) { socket_tuning_ = tuning; }
+    OrderBook snapshot_orderbook();
 };
\ No newline at end of file
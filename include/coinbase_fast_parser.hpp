@@ -109,9 +109,11 @@ public:
         // Parse event time "time"
         const char* time_start = find_value_after_key(json, end, "time", 4);
         if (time_start) {
-            result.timestamp = get_time_now_nano();
-
-        } 
+            const char* time_end = static_cast<const char*>(memchr(time_start, '"', end - time_start));
+            if (time_end) {
+                result.timestamp = parse_iso8601_nanos(time_start, time_end - time_start);
+            }
+        }
 
         // Parse symbol "product_id"
         const char* s_start = find_value_after_key(json, end, "product_id", 10);
@@ -121,53 +123,91 @@ public:
             result.symbol = std::string_view(s_start, s_end - s_start);
         }
 
-        // Parse changes "changes"
+        // Parse changes "changes": [["buy","price","size"], ...]
         const char* changes_start = find_value_after_key(json, end, "changes", 7);
         if (changes_start) {
-            const char* changes_end = changes_start;
-            int bracket_count = 1;
-            while (changes_end < end && bracket_count > 0) {
-                if (*changes_end == '[') ++bracket_count;
-                if (*changes_end == ']') --bracket_count;
-                ++changes_end;
+            const char* changes_end = array_end(changes_start, end);
+            const char* p = changes_start + 1; // Past the outer '['
+            while (const char* entry = static_cast<const char*>(memchr(p, '[', changes_end - p))) {
+                const char* entry_end = static_cast<const char*>(memchr(entry, ']', changes_end - entry));
+                if (!entry_end) break;
+                p = entry + 1;
+                std::string_view type = next_string(p, entry_end);
+                std::string_view price = next_string(p, entry_end);
+                std::string_view size = next_string(p, entry_end);
+                PriceLevel level{to_double(price), to_double(size)};
+                if (type == "buy") {
+                    result.bids.push_back(level);
+                } else if (type == "sell") {
+                    result.asks.push_back(level);
+                }
+                p = entry_end + 1;
             }
+        }
+        return result;
+    }
 
-            // Iterate through the array of changes
-            const char* current = changes_start;
-            while (current < changes_end) {
-                if (*current == '[') {
-                    // Found the start of a new change entry
-                    const char* type_start = current + 2; // Skip `["`
-                    const char* type_end = type_start;
-                    while (type_end < changes_end && *type_end != '"') ++type_end;
-
-                    const char* price_start = type_end + 3; // Skip `", "`
-                    const char* price_end = price_start;
-                    while (price_end < changes_end && (*price_end >= '0' && *price_end <= '9' || *price_end == '.')) ++price_end;
-
-                    const char* size_start = price_end + 3; // Skip `", "`
-                    const char* size_end = size_start;
-                    while (size_end < changes_end && (*size_end >= '0' && *size_end <= '9' || *size_end == '.')) ++size_end;
-
-                    double price = parse_double(price_start, price_end);
-                    double size = parse_double(size_start, size_end);
-                    std::string_view type(type_start, type_end - type_start);
-
-                    if (type == "buy") {
-                        result.bids.push_back({price, size});
-                    } else if (type == "sell") {
-                        result.asks.push_back({price, size});
-                    }
+    // Parse the level2 "snapshot" sent on subscribe: the whole book, before any l2update. It has
+    // no time; the caller stamps it
+    static inline OrderBookData parse_snapshot(const char* json, size_t len) {
+        OrderBookData result;
+        result.snapshot = true;
+        const char* end = json + len;
 
-                    // Move to the next entry
-                    current = size_end;
-                    while (current < changes_end && *current != ']') ++current;
-                    if (current < changes_end) ++current; // Skip the ']'
-                } else {
-                    ++current;
-                }
-            }
+        const char* s_start = find_value_after_key(json, end, "product_id", 10);
+        if (s_start) {
+            const char* s_end = s_start;
+            while (s_end < end && *s_end != '"') ++s_end;
+            result.symbol = std::string_view(s_start, s_end - s_start);
         }
+
+        const char* bids = find_value_after_key(json, end, "bids", 4);
+        if (bids) result.bids = parse_levels(bids, array_end(bids, end));
+        const char* asks = find_value_after_key(json, end, "asks", 4);
+        if (asks) result.asks = parse_levels(asks, array_end(asks, end));
         return result;
     }
+
+private:
+    // One past the ']' that closes the array opening at `open`
+    static inline const char* array_end(const char* open, const char* end) {
+        int depth = 0;
+        for (const char* p = open; p < end; ++p) {
+            if (*p == '[') ++depth;
+            else if (*p == ']' && --depth == 0) return p + 1;
+        }
+        return end;
+    }
+
+    // The next quoted string before `end`; p moves past its closing quote
+    static inline std::string_view next_string(const char*& p, const char* end) {
+        const char* open = static_cast<const char*>(memchr(p, '"', end - p));
+        const char* close = open ? static_cast<const char*>(memchr(open + 1, '"', end - open - 1)) : nullptr;
+        if (!close) {
+            p = end;
+            return {};
+        }
+        p = close + 1;
+        return std::string_view(open + 1, close - open - 1);
+    }
+
+    static inline double to_double(std::string_view value) {
+        return value.empty() ? 0.0 : parse_double(value.data(), value.data() + value.size());
+    }
+
+    // [["price","size"], ...]
+    static inline std::vector<PriceLevel> parse_levels(const char* begin, const char* end) {
+        std::vector<PriceLevel> levels;
+        const char* p = begin + 1; // Past the outer '['
+        while (const char* entry = static_cast<const char*>(memchr(p, '[', end - p))) {
+            const char* entry_end = static_cast<const char*>(memchr(entry, ']', end - entry));
+            if (!entry_end) break;
+            p = entry + 1;
+            std::string_view price = next_string(p, entry_end);
+            std::string_view size = next_string(p, entry_end);
+            levels.emplace_back(to_double(price), to_double(size));
+            p = entry_end + 1;
+        }
+        return levels;
+    }
 };
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "event_bus.hpp"
+#include "ipipeline.hpp"
+#include "multi_stream_connector.hpp"
+#include "spsc_queue.hpp"
+
+/**
+ * @class ConnectorPipeline
+ * @brief A venue feed spread over many sockets by a MultiStreamConnector, parsed by the venue's
+ *        usual processor.
+ *
+ * Every connection runs on the connector's one I/O thread and pushes into the same queue, so
+ * the processor sees a single stream exactly as it would behind one exchange socket. Use it
+ * when a venue's symbols outgrow one connection; the topology picks it per pipeline.
+ */
+template<typename Processor>
+class ConnectorPipeline : public IPipeline {
+public:
+    /**
+     * @param source The source name the processor publishes, e.g. "Binance".
+     * @param protocol The venue's protocol, with host, port and target already set.
+     * @param streams What the venue subscribes by, see VenueProtocol.
+     */
+    ConnectorPipeline(std::string source, VenueProtocol protocol, std::vector<std::string> streams,
+                      SPSCQueue<RawMessage>& queue, std::shared_ptr<EventBus> event_bus)
+        : connector_(std::move(protocol), {&queue}), streams_(std::move(streams)), processor_(queue, event_bus) {
+        event_bus_ = std::move(event_bus);
+        name = std::move(source);
+    }
+
+    ~ConnectorPipeline() override {
+        stop();
+    }
+
+    // The protocol carries host, port and target, and builds each shard's own subscription
+    void initialize(const std::string&, const std::string&, const std::string&, const boost::json::object&) override {
+        if (!connector_.initialize(streams_)) {
+            throw std::invalid_argument(name + ": streams do not fit the venue's connection limits");
+        }
+    }
+
+    void start() override {
+        if (running_) {
+            std::cerr << name << " ConnectorPipeline already running!" << std::endl;
+            return;
+        }
+        running_ = true;
+
+        connector_.start(exchange_placement_);
+        parser_thread_ = std::thread([this] {
+            try {
+                processor_.start();
+            } catch (const std::exception& e) {
+                std::cerr << name << " parser thread exception: " << e.what() << std::endl;
+            }
+        });
+        pin_thread(parser_thread_, parser_placement_);
+    }
+
+    void stop() override {
+        if (!running_) return;
+        running_ = false;
+
+        // Parser first, as in the single-socket pipelines
+        processor_.stop();
+        if (parser_thread_.joinable()) parser_thread_.join();
+        connector_.stop();
+    }
+
+    void set_thread_placement(const ThreadPlacement& exchange_thread, const ThreadPlacement& parser_thread) override {
+        exchange_placement_ = exchange_thread;
+        parser_placement_ = parser_thread;
+    }
+    void set_wait_strategy(WaitStrategy strategy) override { processor_.set_wait_strategy(strategy); }
+    void set_socket_tuning(const SocketTuning& tuning) override { connector_.set_socket_tuning(tuning); }
+    const LatencyTracer& latency_tracer() const override { return processor_.tracer(); }
+    uint64_t dropped_messages() const override { return connector_.dropped_messages(); }
+
+    MultiStreamConnector& connector() { return connector_; }
+    const MultiStreamConnector& connector() const { return connector_; }
+
+private:
+    MultiStreamConnector connector_;
+    std::vector<std::string> streams_;
+    Processor processor_;
+    std::thread parser_thread_;
+    ThreadPlacement exchange_placement_;
+    ThreadPlacement parser_placement_;
+    bool running_ = false;
+};
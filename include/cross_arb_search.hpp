@@ -0,0 +1,59 @@
+#pragma once
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include "types.hpp"
+
+/**
+ * @struct CrossFill
+ * @brief What buying on one book and selling on another can execute right now.
+ */
+struct CrossFill {
+    double quantity = 0.0;
+    double buy_notional = 0.0;  // Before fees
+    double sell_notional = 0.0; // Before fees
+    double buy_limit = 0.0;     // Worst ask taken, the limit price for the buy order
+    double sell_limit = 0.0;    // Worst bid taken, the limit price for the sell order
+    double profit = 0.0;        // After taker fees on both legs
+
+    double buy_vwap() const { return quantity > 0.0 ? buy_notional / quantity : 0.0; }
+    double sell_vwap() const { return quantity > 0.0 ? sell_notional / quantity : 0.0; }
+};
+
+/**
+ * @brief Sweeps asks (ascending) against bids (descending) in one merge-style pass.
+ *
+ * Each step matches the cheapest remaining ask with the richest remaining bid for the smaller
+ * of their quantities, as long as selling at that bid still beats buying at that ask after
+ * paying `fee` (taker fee as a fraction of notional) on each leg. The per-unit edge only
+ * shrinks as the walk goes deeper, so stopping at the first unprofitable pair gives the
+ * maximum profit, in O(levels walked).
+ */
+inline CrossFill walk_cross(const std::vector<PriceLevel>& asks, const std::vector<PriceLevel>& bids, double fee,
+                            double max_quantity = std::numeric_limits<double>::infinity()) {
+    CrossFill fill;
+    size_t i = 0;
+    size_t j = 0;
+    double ask_left = asks.empty() ? 0.0 : asks[0].second;
+    double bid_left = bids.empty() ? 0.0 : bids[0].second;
+    while (i < asks.size() && j < bids.size() && fill.quantity < max_quantity) {
+        const double ask = asks[i].first;
+        const double bid = bids[j].first;
+        const double edge = bid * (1.0 - fee) - ask * (1.0 + fee);
+        if (edge <= 0.0) break;
+
+        const double quantity = std::min({ask_left, bid_left, max_quantity - fill.quantity});
+        fill.quantity += quantity;
+        fill.buy_notional += quantity * ask;
+        fill.sell_notional += quantity * bid;
+        fill.profit += quantity * edge;
+        fill.buy_limit = ask;
+        fill.sell_limit = bid;
+
+        ask_left -= quantity;
+        bid_left -= quantity;
+        if (ask_left <= 0.0 && ++i < asks.size()) ask_left = asks[i].second;
+        if (bid_left <= 0.0 && ++j < bids.size()) bid_left = bids[j].second;
+    }
+    return fill;
+}
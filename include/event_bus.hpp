@@ -149,6 +149,9 @@
 #include <typeindex>
 #include <memory>
 #include <any>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 #include "types.hpp"
 
 class EventBus {
@@ -0,0 +1,109 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "event_bus.hpp"
+#include "instrument_registry.hpp"
+#include "mpsc_queue.hpp"
+#include "types.hpp"
+
+/**
+ * @class EventFanIn
+ * @brief Collects one event type from every pipeline into a queue a strategy thread drains.
+ *
+ * EventBus runs handlers on the publishing parser thread, so a strategy subscribed directly
+ * does its work on Binance's, Coinbase's and Kraken's threads in turn. This subscribes once,
+ * copies each event into an MPSCQueue (every parser thread is a producer) and leaves the
+ * strategy to pop them on its own core, in arrival order.
+ *
+ * Parsed events point their string views into the frame being parsed, which is gone by the
+ * time the consumer sees the copy. Only instruments in the registry are forwarded, with
+ * source and symbol re-pointed at the registry's strings; events for anything else are
+ * skipped. TradeData::side is re-pointed at static "buy"/"sell" (empty if the venue gave
+ * neither). Every field of a popped event is then safe to read on the strategy thread, and
+ * try_pop hands back the registry id found on the way in, so the consumer need not look the
+ * instrument up again.
+ * CandleStickDataEvent is rejected at compile time: its interval view has no owner to move
+ * to. The registry must not change once events flow, and the bus must not publish after this
+ * is destroyed (EventBus has no unsubscribe).
+ *
+ * Given a source, only that venue's events are taken, so each venue can get its own queue
+ * (see MergedFeed); events from other venues are neither forwarded nor counted as skipped.
+ */
+template<typename EventType>
+class EventFanIn {
+    static_assert(std::is_same_v<EventType, TradeEvent> || std::is_same_v<EventType, TickerDataEvent> ||
+                      std::is_same_v<EventType, OrderBookDataEvent>,
+                  "EventFanIn only knows how to re-point the string views of trades, tickers and books");
+
+public:
+    EventFanIn(std::shared_ptr<EventBus> event_bus, const InstrumentRegistry& registry, size_t capacity,
+               MemoryPlacement memory = {}, std::string source = {})
+        : registry_(registry), source_(std::move(source)), queue_(capacity, memory) {
+        event_bus->subscribe<EventType>([this](const EventType& event) { forward(event); });
+    }
+
+    EventFanIn(const EventFanIn&) = delete;
+    EventFanIn& operator=(const EventFanIn&) = delete;
+
+    // Strategy thread only; instrument is the event's registry id
+    bool try_pop(uint32_t& instrument, EventType& event) {
+        Entry entry;
+        if (!queue_.try_pop(entry)) return false;
+        instrument = entry.instrument;
+        event = std::move(entry.event);
+        return true;
+    }
+
+    bool try_pop(EventType& event) {
+        uint32_t instrument;
+        return try_pop(instrument, event);
+    }
+
+    // Events lost to a full queue
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    // Events for instruments outside the registry
+    uint64_t skipped() const { return skipped_.load(std::memory_order_relaxed); }
+
+private:
+    struct Entry {
+        uint32_t instrument = InstrumentRegistry::INVALID_INSTRUMENT;
+        EventType event{};
+    };
+
+    void forward(const EventType& event) {
+        if (!source_.empty() && event.data.source != source_) return;
+        const uint32_t id = registry_.find(event.data.source, event.data.symbol);
+        if (id == InstrumentRegistry::INVALID_INSTRUMENT) {
+            skipped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        Entry copy{id, event};
+        const InstrumentInfo& info = registry_.info(id);
+        copy.event.data.source = info.source;
+        copy.event.data.symbol = info.symbol;
+        if constexpr (std::is_same_v<EventType, TradeEvent>) {
+            copy.event.data.side = intern_side(event.data.side);
+        }
+        if (!queue_.try_push(std::move(copy))) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    static std::string_view intern_side(std::string_view side) {
+        static constexpr std::string_view buy = "buy";
+        static constexpr std::string_view sell = "sell";
+        if (side == buy) return buy;
+        if (side == sell) return sell;
+        return {};
+    }
+
+    const InstrumentRegistry& registry_;
+    const std::string source_; // Empty takes every source
+    MPSCQueue<Entry> queue_;
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> skipped_{0};
+};
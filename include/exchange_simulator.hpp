@@ -0,0 +1,319 @@
+#pragma once
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <boost/asio.hpp>
+#include <boost/asio/ssl.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/ssl.hpp>
+#include <boost/beast/websocket.hpp>
+#include <boost/beast/websocket/ssl.hpp>
+#include <boost/json.hpp>
+#include "matching_engine.hpp"
+#include "utils.hpp"
+
+// Local order-entry simulator speaking a Binance-like WebSocket order protocol, run by
+// tools/exchange_simulator and by the tests.
+//
+// Requests:
+//   {"id":"1","method":"order.place","params":{"symbol":"BTCUSDT","side":"BUY","type":"LIMIT",
+//    "price":"50000.0","quantity":"0.1","newClientOrderId":"42"}}
+//   {"id":"2","method":"order.cancel","params":{"symbol":"BTCUSDT","origClientOrderId":"42"}}
+//
+// Responses echo the request id with a status; fills and cancels arrive afterwards as
+// "executionReport" events using Binance's field names (c, S, X, l, L, z, i, E). A Listener
+// accepts on 127.0.0.1 and runs a Session per connection, all on one io_context thread.
+
+namespace beast = boost::beast;
+namespace websocket = beast::websocket;
+namespace net = boost::asio;
+namespace ssl = net::ssl;
+namespace json = boost::json;
+using tcp = net::ip::tcp;
+
+struct SimulatorConfig {
+    unsigned short port = 9443;
+    std::string cert_file;
+    std::string key_file;
+    std::chrono::microseconds ack_latency{0};
+    std::chrono::microseconds fill_latency{0};
+    double reject_rate = 0.0;
+    uint64_t disconnect_after = 0; // Drop the connection after N inbound messages, 0 = never
+    uint64_t seed = 42;
+};
+
+class SessionBase {
+public:
+    virtual ~SessionBase() = default;
+    virtual void send(std::string message, std::chrono::microseconds delay) = 0;
+};
+
+// State shared by all sessions; everything runs on the single io_context thread
+struct Simulator {
+    SimulatorConfig config;
+    MatchingEngine engine;
+    std::unordered_map<uint64_t, std::weak_ptr<SessionBase>> sessions;
+    std::mt19937_64 rng;
+    uint64_t next_owner_id = 1;
+
+    explicit Simulator(SimulatorConfig cfg) : config(std::move(cfg)), rng(config.seed) {}
+
+    bool should_reject() {
+        if (config.reject_rate <= 0.0) return false;
+        return std::uniform_real_distribution<double>(0.0, 1.0)(rng) < config.reject_rate;
+    }
+};
+
+inline const char* side_to_string(Side side) {
+    return side == Side::Buy ? "BUY" : "SELL";
+}
+
+inline const char* status_to_string(OrderStatus status) {
+    switch (status) {
+        case OrderStatus::New: return "NEW";
+        case OrderStatus::Acknowledged: return "NEW";
+        case OrderStatus::PartiallyFilled: return "PARTIALLY_FILLED";
+        case OrderStatus::Filled: return "FILLED";
+        case OrderStatus::Canceled: return "CANCELED";
+        case OrderStatus::Rejected: return "REJECTED";
+    }
+    return "UNKNOWN";
+}
+
+inline std::string execution_report(const Execution& exec) {
+    json::object report;
+    report["e"] = "executionReport";
+    report["E"] = get_time_now_milli();
+    report["s"] = exec.symbol;
+    report["c"] = exec.client_order_id;
+    report["S"] = side_to_string(exec.side);
+    report["x"] = exec.last_quantity > 0.0 ? "TRADE" : status_to_string(exec.status);
+    report["X"] = status_to_string(exec.status);
+    report["i"] = exec.order_id;
+    report["p"] = std::to_string(exec.price);
+    report["q"] = std::to_string(exec.quantity);
+    report["l"] = std::to_string(exec.last_quantity);
+    report["L"] = std::to_string(exec.last_price);
+    report["z"] = std::to_string(exec.cumulative_quantity);
+    return json::serialize(report);
+}
+
+template<typename WsStream>
+class Session : public SessionBase, public std::enable_shared_from_this<Session<WsStream>> {
+public:
+    Session(WsStream ws, Simulator& sim)
+        : ws_(std::move(ws)), sim_(sim), owner_id_(sim.next_owner_id++) {}
+
+    ~Session() override {
+        sim_.engine.cancel_all(owner_id_);
+        sim_.sessions.erase(owner_id_);
+    }
+
+    void start() {
+        sim_.sessions[owner_id_] = this->shared_from_this();
+        if constexpr (std::is_same_v<typename WsStream::next_layer_type, beast::ssl_stream<beast::tcp_stream>>) {
+            ws_.next_layer().async_handshake(ssl::stream_base::server,
+                [self = this->shared_from_this()](beast::error_code ec) {
+                    if (ec) { std::cerr << "[Simulator] TLS handshake: " << ec.message() << "\n"; return; }
+                    self->accept();
+                });
+        } else {
+            accept();
+        }
+    }
+
+    void send(std::string message, std::chrono::microseconds delay) override {
+        if (delay.count() == 0) {
+            enqueue(std::move(message));
+            return;
+        }
+        auto timer = std::make_shared<net::steady_timer>(ws_.get_executor(), delay);
+        timer->async_wait([self = this->shared_from_this(), timer, msg = std::move(message)](beast::error_code ec) mutable {
+            if (!ec) self->enqueue(std::move(msg));
+        });
+    }
+
+private:
+    void accept() {
+        ws_.set_option(websocket::stream_base::timeout::suggested(beast::role_type::server));
+        ws_.async_accept([self = this->shared_from_this()](beast::error_code ec) {
+            if (ec) { std::cerr << "[Simulator] WS accept: " << ec.message() << "\n"; return; }
+            std::cout << "[Simulator] Session " << self->owner_id_ << " connected\n";
+            self->read();
+        });
+    }
+
+    void read() {
+        ws_.async_read(buffer_, [self = this->shared_from_this()](beast::error_code ec, std::size_t) {
+            self->on_read(ec);
+        });
+    }
+
+    void on_read(beast::error_code ec) {
+        if (ec) {
+            std::cout << "[Simulator] Session " << owner_id_ << " closed: " << ec.message() << "\n";
+            return;
+        }
+
+        std::string msg = beast::buffers_to_string(buffer_.data());
+        buffer_.consume(buffer_.size());
+        handle_request(msg);
+
+        if (sim_.config.disconnect_after > 0 && ++inbound_count_ >= sim_.config.disconnect_after) {
+            std::cout << "[Simulator] Injecting disconnect on session " << owner_id_ << "\n";
+            beast::error_code ignored;
+            beast::get_lowest_layer(ws_).socket().close(ignored);
+            return;
+        }
+        read();
+    }
+
+    void handle_request(const std::string& msg) {
+        json::value id;
+        try {
+            json::object req = json::parse(msg).as_object();
+            id = req["id"];
+            std::string method = json::value_to<std::string>(req.at("method"));
+            const json::object& params = req.at("params").as_object();
+
+            if (method == "order.place") {
+                place_order(id, params);
+            } else if (method == "order.cancel") {
+                cancel_order(id, params);
+            } else {
+                respond_error(id, 400, "Unknown method");
+            }
+        } catch (const std::exception& e) {
+            respond_error(id, 400, e.what());
+        }
+    }
+
+    void place_order(const json::value& id, const json::object& params) {
+        std::string symbol = json::value_to<std::string>(params.at("symbol"));
+        std::string client_id = json::value_to<std::string>(params.at("newClientOrderId"));
+        Side side = params.at("side").as_string() == "BUY" ? Side::Buy : Side::Sell;
+        OrderType type = params.at("type").as_string() == "MARKET" ? OrderType::Market : OrderType::Limit;
+        double quantity = std::stod(json::value_to<std::string>(params.at("quantity")));
+        double price = type == OrderType::Limit ? std::stod(json::value_to<std::string>(params.at("price"))) : 0.0;
+
+        if (quantity <= 0.0 || (type == OrderType::Limit && price <= 0.0) || sim_.should_reject()) {
+            respond_error(id, 400, "Order rejected");
+            return;
+        }
+
+        auto executions = sim_.engine.submit(owner_id_, symbol, client_id, side, type, price, quantity);
+        if (executions.size() == 1 && executions.front().status == OrderStatus::Rejected) {
+            respond_error(id, 400, "Duplicate order sent.", -2010);
+            return;
+        }
+        for (const Execution& exec : executions) {
+            if (exec.owner_id == owner_id_ && exec.status == OrderStatus::Acknowledged) {
+                json::object result{{"symbol", symbol}, {"orderId", exec.order_id},
+                                    {"clientOrderId", client_id}, {"status", "NEW"}};
+                respond(id, result, sim_.config.ack_latency);
+            } else {
+                dispatch(exec);
+            }
+        }
+    }
+
+    void cancel_order(const json::value& id, const json::object& params) {
+        std::string client_id = json::value_to<std::string>(params.at("origClientOrderId"));
+        auto executions = sim_.engine.cancel(owner_id_, client_id);
+        if (executions.empty()) {
+            respond_error(id, 400, "Unknown order");
+            return;
+        }
+        json::object result{{"clientOrderId", client_id}, {"status", "CANCELED"}};
+        respond(id, result, sim_.config.ack_latency);
+        for (const Execution& exec : executions) {
+            dispatch(exec);
+        }
+    }
+
+    // Makers may belong to other sessions
+    void dispatch(const Execution& exec) {
+        auto it = sim_.sessions.find(exec.owner_id);
+        if (it == sim_.sessions.end()) return;
+        if (auto session = it->second.lock()) {
+            session->send(execution_report(exec), sim_.config.fill_latency);
+        }
+    }
+
+    void respond(const json::value& id, json::object result, std::chrono::microseconds delay) {
+        json::object resp{{"id", id}, {"status", 200}, {"result", std::move(result)}};
+        send(json::serialize(resp), delay);
+    }
+
+    // code is Binance's error code, left out when 0
+    void respond_error(const json::value& id, int status, const std::string& message, int code = 0) {
+        json::object error{{"msg", message}};
+        if (code != 0) error["code"] = code;
+        json::object resp{{"id", id}, {"status", status}, {"error", std::move(error)}};
+        send(json::serialize(resp), sim_.config.ack_latency);
+    }
+
+    // Exactly one async_write in flight; the rest wait in the outbox
+    void enqueue(std::string message) {
+        outbox_.push_back(std::move(message));
+        if (outbox_.size() == 1) write();
+    }
+
+    void write() {
+        ws_.async_write(net::buffer(outbox_.front()),
+            [self = this->shared_from_this()](beast::error_code ec, std::size_t) {
+                if (ec) { std::cerr << "[Simulator] Write: " << ec.message() << "\n"; return; }
+                self->outbox_.pop_front();
+                if (!self->outbox_.empty()) self->write();
+            });
+    }
+
+    WsStream ws_;
+    Simulator& sim_;
+    uint64_t owner_id_;
+    beast::flat_buffer buffer_;
+    std::deque<std::string> outbox_;
+    uint64_t inbound_count_ = 0;
+};
+
+using PlainSession = Session<websocket::stream<beast::tcp_stream>>;
+using TlsSession = Session<websocket::stream<beast::ssl_stream<beast::tcp_stream>>>;
+
+class Listener {
+public:
+    Listener(net::io_context& ioc, Simulator& sim, ssl::context* tls)
+        : ioc_(ioc), acceptor_(ioc, tcp::endpoint(net::ip::make_address("127.0.0.1"), sim.config.port)),
+          sim_(sim), tls_(tls) {}
+
+    // The bound port, for a config that asked for any free one (port 0)
+    unsigned short port() const { return acceptor_.local_endpoint().port(); }
+
+    void accept() {
+        acceptor_.async_accept(net::make_strand(ioc_), [this](beast::error_code ec, tcp::socket socket) {
+            if (ec) {
+                std::cerr << "[Simulator] Accept: " << ec.message() << "\n";
+            } else {
+                socket.set_option(tcp::no_delay(true));
+                if (tls_) {
+                    std::make_shared<TlsSession>(
+                        websocket::stream<beast::ssl_stream<beast::tcp_stream>>(std::move(socket), *tls_), sim_)->start();
+                } else {
+                    std::make_shared<PlainSession>(
+                        websocket::stream<beast::tcp_stream>(std::move(socket)), sim_)->start();
+                }
+            }
+            accept();
+        });
+    }
+
+private:
+    net::io_context& ioc_;
+    tcp::acceptor acceptor_;
+    Simulator& sim_;
+    ssl::context* tls_;
+};
@@ -0,0 +1,234 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <x86intrin.h>
+#include <cpuid.h>
+#define FAST_CLOCK_HAS_RDTSC 1
+#endif
+
+/**
+ * @class FastClock
+ * @brief rdtsc-based clock converted to epoch nanoseconds.
+ *
+ * ticks() is a single rdtsc for cheap stage deltas; now_nanos() turns a tick count into wall
+ * time using a (base_tsc, base_ns, ns_per_tick) calibration published under a seqlock, so a
+ * read is rdtsc plus a few loads and a multiply instead of a ~20ns vDSO call.
+ *
+ * A background thread re-anchors the calibration against CLOCK_REALTIME periodically to bound
+ * drift and follow NTP adjustments; it is the only writer of the seqlock. Re-anchoring never
+ * moves now_nanos() backwards: when the clock has run ahead of CLOCK_REALTIME it is slowed by
+ * up to MAX_SLEW until the wall clock catches up, the way adjtime() slews. On CPUs without an
+ * invariant TSC (or without rdtsc at all) every call falls back to the system clock, so
+ * callers never need to check.
+ */
+class FastClock {
+public:
+    static constexpr double MAX_SLEW = 500e-6; // Largest fraction the rate is slowed by
+
+    static inline uint64_t ticks() {
+#ifdef FAST_CLOCK_HAS_RDTSC
+        if (state().use_tsc) return __rdtsc();
+#endif
+        return static_cast<uint64_t>(system_now_nanos());
+    }
+
+    static inline int64_t now_nanos() {
+#ifdef FAST_CLOCK_HAS_RDTSC
+        if (state().use_tsc) return to_epoch_nanos(__rdtsc());
+#endif
+        return system_now_nanos();
+    }
+
+    static inline int64_t to_epoch_nanos(uint64_t tick) {
+        State& s = state();
+        if (!s.use_tsc) return static_cast<int64_t>(tick);
+        while (true) {
+            uint64_t seq = s.seq.load(std::memory_order_acquire);
+            if (seq & 1) continue; // Writer in progress
+            uint64_t base_tsc = s.base_tsc.load(std::memory_order_relaxed);
+            int64_t base_ns = s.base_ns.load(std::memory_order_relaxed);
+            double ns_per_tick = s.ns_per_tick.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (s.seq.load(std::memory_order_relaxed) == seq) {
+                return base_ns + static_cast<int64_t>(static_cast<double>(static_cast<int64_t>(tick - base_tsc)) * ns_per_tick);
+            }
+        }
+    }
+
+    static inline int64_t elapsed_nanos(uint64_t from_ticks, uint64_t to_ticks) {
+        if (to_ticks <= from_ticks) return 0;
+        return static_cast<int64_t>(static_cast<double>(to_ticks - from_ticks) * ns_per_tick());
+    }
+
+    static double ns_per_tick() { return state().ns_per_tick.load(std::memory_order_relaxed); }
+    static bool using_tsc() { return state().use_tsc; }
+
+    // Starts periodic recalibration; call once at startup, before the feeds start
+    static void start_calibration_thread(std::chrono::milliseconds interval = std::chrono::milliseconds(1000)) {
+        State& s = state();
+        std::lock_guard<std::mutex> lock(s.thread_mutex);
+        if (!s.use_tsc || s.calibration_thread.joinable()) return;
+        s.stop_requested = false;
+        s.calibration_thread = std::thread([interval] {
+            State& st = state();
+            std::unique_lock<std::mutex> wait_lock(st.wait_mutex);
+            while (!st.cv.wait_for(wait_lock, interval, [&st] { return st.stop_requested; })) {
+                recalibrate(interval);
+            }
+        });
+    }
+
+    static void stop_calibration_thread() {
+        State& s = state();
+        std::lock_guard<std::mutex> lock(s.thread_mutex);
+        {
+            std::lock_guard<std::mutex> wait_lock(s.wait_mutex);
+            s.stop_requested = true;
+        }
+        s.cv.notify_all();
+        if (s.calibration_thread.joinable()) s.calibration_thread.join();
+    }
+
+private:
+    struct Sample {
+        uint64_t tsc;
+        int64_t ns;
+    };
+
+    struct State {
+        bool use_tsc = false;
+        alignas(64) std::atomic<uint64_t> seq{0};
+        std::atomic<uint64_t> base_tsc{0};
+        std::atomic<int64_t> base_ns{0};
+        std::atomic<double> ns_per_tick{1.0};
+
+        // Calibration thread only: the last CLOCK_REALTIME sample and the unslewed tick rate
+        Sample last_sample{0, 0};
+        double rate = 1.0;
+
+        std::mutex thread_mutex;
+        std::mutex wait_mutex;
+        std::condition_variable cv;
+        bool stop_requested = false;
+        std::thread calibration_thread;
+
+        State() {
+            use_tsc = has_invariant_tsc();
+            if (use_tsc) initial_calibration(*this);
+        }
+
+        ~State() {
+            {
+                std::lock_guard<std::mutex> wait_lock(wait_mutex);
+                stop_requested = true;
+            }
+            cv.notify_all();
+            if (calibration_thread.joinable()) calibration_thread.join();
+        }
+    };
+
+    static State& state() {
+        static State s;
+        return s;
+    }
+
+    static int64_t system_now_nanos() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    static bool has_invariant_tsc() {
+#ifdef FAST_CLOCK_HAS_RDTSC
+        unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+        if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) == 0 || eax < 0x80000007) return false;
+        __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+        return (edx & (1u << 8)) != 0; // Invariant TSC
+#else
+        return false;
+#endif
+    }
+
+    // Pairs a TSC read with CLOCK_REALTIME, keeping the tightest of a few attempts
+    static Sample take_sample() {
+        Sample best{0, 0};
+#ifdef FAST_CLOCK_HAS_RDTSC
+        uint64_t best_window = UINT64_MAX;
+        unsigned int aux = 0;
+        for (int i = 0; i < 5; ++i) {
+            uint64_t before = __rdtscp(&aux);
+            int64_t ns = system_now_nanos();
+            uint64_t after = __rdtscp(&aux);
+            if (after - before < best_window) {
+                best_window = after - before;
+                best = Sample{before + (after - before) / 2, ns};
+            }
+        }
+#endif
+        return best;
+    }
+
+    // Refines the tick rate from the wall clock samples, then re-anchors at the current tick to
+    // CLOCK_REALTIME, or to the current reading if that is later, slewing the difference out over
+    // the next interval
+    static void recalibrate(std::chrono::nanoseconds interval) {
+        State& s = state();
+        if (!s.use_tsc) return;
+        const Sample sample = take_sample();
+
+        double rate = s.rate;
+        if (sample.tsc > s.last_sample.tsc && sample.ns > s.last_sample.ns) {
+            double measured = static_cast<double>(sample.ns - s.last_sample.ns) /
+                              static_cast<double>(sample.tsc - s.last_sample.tsc);
+            // Ignore wall clock steps (e.g. settimeofday); only smooth in plausible rate changes
+            if (std::fabs(measured - rate) / rate < 0.001) {
+                rate = 0.8 * rate + 0.2 * measured;
+            }
+        }
+        s.rate = rate;
+        s.last_sample = sample;
+
+        const uint64_t tick = ticks();
+        const int64_t wall = sample.ns + static_cast<int64_t>(static_cast<double>(static_cast<int64_t>(tick - sample.tsc)) * rate);
+        const int64_t current = to_epoch_nanos(tick);
+        if (current <= wall) {
+            publish(tick, wall, rate);
+            return;
+        }
+        const double ahead = static_cast<double>(current - wall) / static_cast<double>(interval.count());
+        publish(tick, current, rate * (1.0 - std::min(ahead, MAX_SLEW)));
+    }
+
+    static void initial_calibration(State& s) {
+        Sample start = take_sample();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        Sample end = take_sample();
+        double rate = static_cast<double>(end.ns - start.ns) / static_cast<double>(end.tsc - start.tsc);
+        if (!(rate > 0.0) || !std::isfinite(rate)) {
+            s.use_tsc = false;
+            return;
+        }
+        s.base_tsc.store(end.tsc, std::memory_order_relaxed);
+        s.base_ns.store(end.ns, std::memory_order_relaxed);
+        s.ns_per_tick.store(rate, std::memory_order_relaxed);
+        s.last_sample = end;
+        s.rate = rate;
+    }
+
+    static void publish(uint64_t base_tsc, int64_t base_ns, double rate) {
+        State& s = state();
+        uint64_t seq = s.seq.load(std::memory_order_relaxed);
+        s.seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        s.base_tsc.store(base_tsc, std::memory_order_relaxed);
+        s.base_ns.store(base_ns, std::memory_order_relaxed);
+        s.ns_per_tick.store(rate, std::memory_order_relaxed);
+        s.seq.store(seq + 2, std::memory_order_release);
+    }
+};
@@ -0,0 +1,205 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <string_view>
+#include <vector>
+#include "binance_fast_parser.hpp"
+#include "coinbase_fast_parser.hpp"
+#include "fast_clock.hpp"
+#include "kraken_fast_parser.hpp"
+#include "order_id_map.hpp"
+#include "types.hpp"
+
+// Maps a frame to a 64-bit identity that is equal for every copy of the same venue message
+using DedupKeyFn = uint64_t (*)(std::string_view payload);
+
+/**
+ * @class FeedArbiter
+ * @brief First-arrival-wins arbitration between redundant connections carrying the same streams.
+ *
+ * Each frame is reduced to a fingerprint by a venue key function, built from the venue's own
+ * identifiers where it has one:
+ *  - Binance: stream name + final update ID `u` (depth, bookTicker), trade ID `t`, aggregate
+ *    trade ID `a`, or event time `E` for the rest (ticker, kline)
+ *  - Coinbase: type + product_id + `sequence`
+ *  - Kraken: channel + symbol + `checksum`/`timestamp` for book, `trade_id` for trades
+ * Frames without such an identifier (level2 batches, acks, heartbeats) fall back to a hash of
+ * the whole payload, since redundant copies are byte-identical.
+ *
+ * The first copy of a fingerprint is accepted and credited to its connection as a win; later
+ * copies are rejected and their delay behind the winner recorded. Fingerprints are remembered
+ * for the last `window` unique messages, which must exceed the worst skew between connections
+ * in messages. Lookups go through an OrderIdMap, so accept() never allocates.
+ *
+ * accept() is single-threaded (the connector's I/O thread); the statistics may be read from
+ * any thread.
+ */
+class FeedArbiter {
+public:
+    struct ConnectionStats {
+        std::atomic<uint64_t> wins{0};
+        std::atomic<uint64_t> duplicates{0};
+        std::atomic<uint64_t> lag_ns_total{0}; // Sum over duplicates of the delay behind the winner
+        std::atomic<uint64_t> lag_ns_max{0};
+    };
+
+    FeedArbiter(DedupKeyFn key_fn, size_t connections, size_t window = 65536)
+        : key_fn_(key_fn), connections_(connections), window_(window), index_(window),
+          ring_(window), stats_(std::make_unique<ConnectionStats[]>(connections)) {}
+
+    // True for the first copy of a message; socket_rx of each copy measures the losers' lag
+    bool accept(uint32_t connection, const RawMessage& message) {
+        uint64_t key = key_fn_(message.payload);
+        if (key == 0) key = 1; // 0 is the map's empty marker
+        ConnectionStats& stats = stats_[connection];
+
+        uint32_t slot = index_.find(key);
+        if (slot != OrderIdMap::NOT_FOUND) {
+            int64_t lag = FastClock::elapsed_nanos(ring_[slot].first_rx, message.trace.socket_rx);
+            uint64_t lag_ns = lag > 0 ? static_cast<uint64_t>(lag) : 0;
+            stats.duplicates.store(stats.duplicates.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            stats.lag_ns_total.store(stats.lag_ns_total.load(std::memory_order_relaxed) + lag_ns, std::memory_order_relaxed);
+            if (lag_ns > stats.lag_ns_max.load(std::memory_order_relaxed)) {
+                stats.lag_ns_max.store(lag_ns, std::memory_order_relaxed);
+            }
+            return false;
+        }
+
+        // Evict the oldest fingerprint once the window is full
+        Entry& entry = ring_[head_];
+        if (entry.key != 0) index_.erase(entry.key);
+        entry.key = key;
+        entry.first_rx = message.trace.socket_rx;
+        index_.insert(key, static_cast<uint32_t>(head_));
+        head_ = head_ + 1 == window_ ? 0 : head_ + 1;
+
+        stats.wins.store(stats.wins.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        unique_messages_.store(unique_messages_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    size_t connections() const { return connections_; }
+    uint64_t unique_messages() const { return unique_messages_.load(std::memory_order_relaxed); }
+    const ConnectionStats& stats(size_t connection) const { return stats_[connection]; }
+
+    // Share of unique messages this connection delivered first
+    double win_rate(size_t connection) const {
+        uint64_t total = unique_messages();
+        return total ? static_cast<double>(stats_[connection].wins.load(std::memory_order_relaxed)) / static_cast<double>(total) : 0.0;
+    }
+
+    void report(std::ostream& out, std::string_view name) const {
+        out << "[" << name << "] Arbitration over " << connections_ << " connections, " << unique_messages()
+            << " unique messages\n";
+        for (size_t c = 0; c < connections_; ++c) {
+            const ConnectionStats& s = stats_[c];
+            uint64_t duplicates = s.duplicates.load(std::memory_order_relaxed);
+            out << "  #" << c << " wins=" << s.wins.load(std::memory_order_relaxed) << " (" << 100.0 * win_rate(c)
+                << "%) late=" << duplicates << " avg_lag="
+                << (duplicates ? s.lag_ns_total.load(std::memory_order_relaxed) / duplicates : 0)
+                << "ns max_lag=" << s.lag_ns_max.load(std::memory_order_relaxed) << "ns\n";
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // Venue key functions
+    //////////////////////////////////////////////////////////////////////////
+
+    static uint64_t binance_key(std::string_view payload) {
+        const char* begin = payload.data();
+        const char* end = begin + payload.size();
+        uint64_t scope = string_hash(BinanceFastParser::find_value_after_key(begin, end, "stream", 6), end);
+
+        const char* id = BinanceFastParser::find_value_after_key(begin, end, "u", 1);
+        if (!id) {
+            const char* type = BinanceFastParser::find_value_after_key(begin, end, "e", 1);
+            if (type && end - type > 6 && memcmp(type, "trade\"", 6) == 0) {
+                id = BinanceFastParser::find_value_after_key(begin, end, "t", 1);
+            } else if (type && end - type > 9 && memcmp(type, "aggTrade\"", 9) == 0) {
+                id = BinanceFastParser::find_value_after_key(begin, end, "a", 1);
+            }
+        }
+        if (!id) id = BinanceFastParser::find_value_after_key(begin, end, "E", 1);
+        if (!id) return hash_bytes(begin, payload.size());
+        return mix(scope ^ mix(static_cast<uint64_t>(BinanceFastParser::parse_int64(id, end))));
+    }
+
+    static uint64_t coinbase_key(std::string_view payload) {
+        const char* begin = payload.data();
+        const char* end = begin + payload.size();
+        const char* sequence = CoinbaseFastParser::find_value_after_key(begin, end, "sequence", 8);
+        if (!sequence) return hash_bytes(begin, payload.size());
+        uint64_t scope = string_hash(CoinbaseFastParser::find_value_after_key(begin, end, "type", 4), end) ^
+                         string_hash(CoinbaseFastParser::find_value_after_key(begin, end, "product_id", 10), end) * 31;
+        return mix(scope ^ mix(static_cast<uint64_t>(CoinbaseFastParser::parse_int64(sequence, end))));
+    }
+
+    static uint64_t kraken_key(std::string_view payload) {
+        const char* begin = payload.data();
+        const char* end = begin + payload.size();
+        const char* channel = KrakenFastParser::find_value_after_key(begin, end, "channel", 7);
+        if (!channel) return hash_bytes(begin, payload.size());
+        uint64_t scope = string_hash(channel, end) ^
+                         string_hash(KrakenFastParser::find_value_after_key(begin, end, "symbol", 6), end) * 31;
+
+        if (end - channel > 5 && memcmp(channel, "book\"", 5) == 0) {
+            const char* checksum = KrakenFastParser::find_value_after_key(begin, end, "checksum", 8);
+            const char* timestamp = KrakenFastParser::find_value_after_key(begin, end, "timestamp", 9);
+            if (checksum && timestamp) {
+                return mix(scope ^ mix(static_cast<uint64_t>(KrakenFastParser::parse_int64(checksum, end))) ^
+                           string_hash(timestamp, end));
+            }
+        } else if (const char* trade_id = KrakenFastParser::find_value_after_key(begin, end, "trade_id", 8)) {
+            return mix(scope ^ mix(static_cast<uint64_t>(KrakenFastParser::parse_int64(trade_id, end))));
+        }
+        return hash_bytes(begin, payload.size());
+    }
+
+    // 8 bytes per step; only needs to be good enough to keep fingerprints of distinct frames apart
+    static uint64_t hash_bytes(const char* data, size_t len) {
+        uint64_t h = 0x9E3779B97F4A7C15ull ^ len;
+        size_t i = 0;
+        for (; i + 8 <= len; i += 8) {
+            uint64_t word;
+            memcpy(&word, data + i, 8);
+            h = (h ^ mix(word)) * 0xBF58476D1CE4E5B9ull;
+        }
+        uint64_t tail = 0;
+        memcpy(&tail, data + i, len - i);
+        return mix(h ^ tail);
+    }
+
+private:
+    struct Entry {
+        uint64_t key = 0;
+        uint64_t first_rx = 0;
+    };
+
+    // splitmix64 finalizer
+    static uint64_t mix(uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xBF58476D1CE4E5B9ull;
+        x ^= x >> 27;
+        x *= 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    // Hash of a string value as returned by find_value_after_key (just past the opening quote)
+    static uint64_t string_hash(const char* value, const char* end) {
+        if (!value) return 0;
+        const char* close = static_cast<const char*>(memchr(value, '"', end - value));
+        return hash_bytes(value, close ? close - value : end - value);
+    }
+
+    DedupKeyFn key_fn_;
+    size_t connections_;
+    size_t window_;
+    OrderIdMap index_;
+    std::vector<Entry> ring_;
+    size_t head_ = 0;
+    std::unique_ptr<ConnectionStats[]> stats_;
+    std::atomic<uint64_t> unique_messages_{0};
+};
@@ -0,0 +1,269 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/beast/websocket/stream_base.hpp>
+#include "event_bus.hpp"
+#include "fast_clock.hpp"
+#include "spsc_queue.hpp"
+#include "types.hpp"
+
+struct ReconnectPolicy {
+    std::chrono::milliseconds initial_backoff{250};
+    std::chrono::milliseconds max_backoff{30'000};
+    double multiplier = 2.0;
+    double jitter = 0.5;                          // Fraction of each delay that is randomized
+    std::chrono::milliseconds stale_after{10'000}; // No message for this long recycles the connection, 0 disables
+    std::chrono::milliseconds ping_timeout{10'000}; // WebSocket ping sent at half of this, read fails at the full
+    std::chrono::milliseconds connect_timeout{10'000}; // Resolve through WebSocket handshake
+};
+
+/**
+ * @class FeedSupervisor
+ * @brief Keeps one exchange WebSocket alive: failure detection, jittered backoff and status.
+ *
+ * The exchange reports every error through on_disconnected() and every frame through push().
+ * The supervisor tears the connection down, waits initial_backoff * multiplier^attempt (capped
+ * at max_backoff, the last `jitter` fraction randomized so many clients don't reconnect in
+ * lockstep) and calls the reconnect handler, which opens a fresh stream and resends the
+ * subscription. The attempt counter resets once a reconnected feed delivers data.
+ *
+ * Four failure modes are covered:
+ *  - disconnects: any resolve/connect/handshake/read/write error reported by the exchange
+ *  - hung connects: no completed handshake within connect_timeout of the attempt starting
+ *  - ping timeouts: stream_timeout() enables Beast's keep-alive pings, so a peer that stops
+ *    answering fails the pending read with beast::error::timeout
+ *  - stale feeds: a watchdog recycles a connection that is up but has delivered no message
+ *    within stale_after (pongs and control frames don't count)
+ *
+ * Every transition is pushed into the parser queue as an in-band RawMessage marker, so the
+ * processor publishes the FeedStatusEvent in order with the book updates around it. Markers are
+ * never dropped: if the queue is full they wait, and data is dropped behind them instead. A
+ * dropped frame leaves a hole in the venue's update stream, so every drop is followed in the
+ * queue by a Gap marker (one per run of drops) and consumers rebuild rather than trade on a
+ * book that silently missed updates. A reconnect resends the subscription anyway; after a Gap on
+ * a live connection the resync handler, if set, resubscribes, so venues without sequence
+ * numbers (Coinbase, Kraken) send the fresh snapshot those books need to be rebuilt.
+ *
+ * Not thread-safe: call everything from the exchange's io_context thread.
+ */
+class FeedSupervisor {
+public:
+    FeedSupervisor(boost::asio::io_context& ioc, SPSCQueue<RawMessage>& queue, std::string source,
+                   ReconnectPolicy policy = {})
+        : queue_(queue), source_(std::move(source)), policy_(policy),
+          backoff_timer_(ioc), watchdog_timer_(ioc), rng_(std::random_device{}()) {}
+
+    // reconnect opens a new connection; teardown closes the current one and cancels its operations
+    void set_handlers(std::function<void()> reconnect, std::function<void()> teardown) {
+        reconnect_ = std::move(reconnect);
+        teardown_ = std::move(teardown);
+    }
+
+    // Resubscribes on the live connection after a Gap; unset for venues whose books resync themselves
+    void set_resync(std::function<void()> resync) { resync_ = std::move(resync); }
+
+    void set_policy(const ReconnectPolicy& policy) { policy_ = policy; }
+    // Stamped on every status marker, for sources that run several connections into one queue
+    void set_connection(uint32_t connection) { connection_ = connection; }
+    // Consulted before each status marker is posted; returning false suppresses it
+    void set_status_gate(std::function<bool(FeedState)> gate) { status_gate_ = std::move(gate); }
+    const ReconnectPolicy& policy() const { return policy_; }
+
+    // Timeouts to apply to every new stream before its WebSocket handshake
+    boost::beast::websocket::stream_base::timeout stream_timeout() const {
+        boost::beast::websocket::stream_base::timeout opt{};
+        opt.handshake_timeout = policy_.connect_timeout;
+        opt.idle_timeout = policy_.ping_timeout;
+        opt.keep_alive_pings = true;
+        return opt;
+    }
+
+    // Starts the watchdog; call once before the first connection attempt
+    void start() {
+        stopped_ = false;
+        connecting_since_ = FastClock::ticks();
+        arm_watchdog();
+    }
+
+    // No reconnects after this, and the timers no longer keep the io_context running
+    void stop() {
+        stopped_ = true;
+        backoff_timer_.cancel();
+        watchdog_timer_.cancel();
+    }
+
+    bool stopped() const { return stopped_; }
+    bool connected() const { return connected_; }
+    uint32_t reconnects() const { return reconnects_; }
+    uint32_t resyncs() const { return resyncs_; }
+
+    // Call once the subscription has been sent
+    void on_connected() {
+        if (stopped_) return;
+        connected_ = true;
+        down_reported_ = false;
+        last_rx_ = FastClock::ticks();
+        if (reconnects_ > 0) {
+            std::cout << "[" << source_ << "] Reconnected (attempt " << attempt_ << ")" << std::endl;
+        }
+        post_status(FeedState::Connected, "subscribed");
+    }
+
+    /**
+     * @brief Reports a failed operation. Only the first report per connection counts; the
+     * aborted operations that follow the teardown report again and are ignored.
+     */
+    void on_disconnected(std::string_view reason, FeedState state = FeedState::Disconnected) {
+        if (stopped_ || reconnect_pending_) return;
+        connected_ = false;
+        reconnect_pending_ = true;
+        if (teardown_) teardown_();
+        // One status per outage, not one per failed attempt
+        if (!down_reported_) {
+            post_status(state, reason);
+            down_reported_ = true;
+        }
+
+        auto delay = next_backoff();
+        std::cerr << "[" << source_ << "] Feed " << (state == FeedState::Stale ? "stale" : "lost") << ": " << reason
+                  << ", reconnecting in " << delay.count() << "ms" << std::endl;
+        backoff_timer_.expires_after(delay);
+        backoff_timer_.async_wait([this](boost::system::error_code ec) {
+            if (ec || stopped_) return;
+            reconnect_pending_ = false;
+            ++reconnects_;
+            connecting_since_ = FastClock::ticks();
+            if (reconnect_) reconnect_();
+        });
+    }
+
+    // Records that the connection delivered a frame, whether or not it is pushed
+    void on_frame(uint64_t socket_rx) {
+        last_rx_ = socket_rx;
+        attempt_ = 0;
+    }
+
+    // Queues a frame behind any pending status markers; false means it was dropped, and a Gap
+    // marker is queued after it
+    bool push(RawMessage&& message) {
+        on_frame(message.trace.socket_rx);
+        if (pending_.empty() || flush_pending()) {
+            message.trace.enqueue = FastClock::ticks();
+            if (queue_.try_push(std::move(message))) return true;
+        }
+        // Drops until the queue drains share one marker
+        if (pending_.empty() || pending_.back().state != FeedState::Gap) {
+            post_status(FeedState::Gap, "queue full, frames dropped");
+            if (connected_ && resync_) {
+                ++resyncs_;
+                resync_();
+            }
+        }
+        return false;
+    }
+
+    // Delay before the next attempt: exponential, capped, with the jittered share drawn uniformly
+    std::chrono::milliseconds next_backoff() {
+        double base = static_cast<double>(policy_.initial_backoff.count());
+        for (uint32_t i = 0; i < attempt_ && base < static_cast<double>(policy_.max_backoff.count()); ++i) {
+            base *= policy_.multiplier;
+        }
+        base = std::min(base, static_cast<double>(policy_.max_backoff.count()));
+        ++attempt_;
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        double delay = base * (1.0 - policy_.jitter) + base * policy_.jitter * unit(rng_);
+        return std::chrono::milliseconds(static_cast<int64_t>(delay));
+    }
+
+private:
+    void post_status(FeedState state, std::string_view reason) {
+        if (status_gate_ && !status_gate_(state)) return;
+        RawMessage marker;
+        marker.payload = reason;
+        marker.feed_status = true;
+        marker.state = state;
+        marker.connection = connection_;
+        marker.trace.socket_rx = FastClock::ticks();
+        pending_.push_back(std::move(marker));
+        flush_pending();
+    }
+
+    bool flush_pending() {
+        while (!pending_.empty()) {
+            pending_.front().trace.enqueue = FastClock::ticks();
+            if (!queue_.try_push(std::move(pending_.front()))) return false;
+            pending_.pop_front();
+        }
+        return true;
+    }
+
+    // Periodic check for hung connects and silent connections; also retries markers stuck behind a full queue
+    void arm_watchdog() {
+        auto period = policy_.stale_after.count() > 0
+            ? std::clamp(policy_.stale_after / 4, std::chrono::milliseconds(10), std::chrono::milliseconds(250))
+            : std::chrono::milliseconds(250);
+        watchdog_timer_.expires_after(period);
+        watchdog_timer_.async_wait([this](boost::system::error_code ec) {
+            if (ec || stopped_) return;
+            flush_pending();
+            uint64_t now = FastClock::ticks();
+            if (connected_ && policy_.stale_after.count() > 0) {
+                int64_t silent_ns = FastClock::elapsed_nanos(last_rx_, now);
+                if (silent_ns > std::chrono::nanoseconds(policy_.stale_after).count()) {
+                    on_disconnected("no message for " + std::to_string(silent_ns / 1'000'000) + "ms", FeedState::Stale);
+                }
+            } else if (!connected_ && !reconnect_pending_ &&
+                       FastClock::elapsed_nanos(connecting_since_, now) > std::chrono::nanoseconds(policy_.connect_timeout).count()) {
+                on_disconnected("connect timed out");
+            }
+            arm_watchdog();
+        });
+    }
+
+    SPSCQueue<RawMessage>& queue_;
+    std::string source_;
+    ReconnectPolicy policy_;
+    boost::asio::steady_timer backoff_timer_;
+    boost::asio::steady_timer watchdog_timer_;
+    std::mt19937_64 rng_;
+    std::function<void()> reconnect_;
+    std::function<void()> teardown_;
+    std::function<void()> resync_;
+    std::function<bool(FeedState)> status_gate_;
+    std::deque<RawMessage> pending_;
+    uint64_t last_rx_ = 0;
+    uint64_t connecting_since_ = 0;
+    uint32_t attempt_ = 0;
+    uint32_t connection_ = 0;
+    uint32_t reconnects_ = 0;
+    uint32_t resyncs_ = 0;
+    bool connected_ = false;
+    bool reconnect_pending_ = false;
+    bool down_reported_ = false;
+    bool stopped_ = true;
+};
+
+/**
+ * @brief Publishes the FeedStatusEvent for an in-band status marker popped by a processor.
+ *
+ * The reason view points into the marker's payload and is only valid during the publish.
+ */
+inline void publish_feed_status(EventBus& event_bus, const RawMessage& marker, std::string_view source) {
+    FeedStatusEvent event;
+    FeedStatusData& status = event.data;
+    status.timestamp = FastClock::to_epoch_nanos(marker.trace.socket_rx);
+    status.state = marker.state;
+    status.connection = marker.connection;
+    status.source = source;
+    status.reason = marker.payload;
+    event_bus.publish(event);
+}
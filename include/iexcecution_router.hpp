@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdint>
+#include "types.hpp"
+
+/**
+ * @class IExcecutionRouter
+ * @brief Entry point strategies use to send orders towards the exchanges.
+ *
+ * The base implementation accepts nothing; venue routers and decorators such as
+ * RiskCheckedRouter override the hooks they care about.
+ */
+class IExcecutionRouter {
+public:
+    virtual ~IExcecutionRouter() = default;
+
+    /**
+     * @brief Routes a new order.
+     * @param order The order to send.
+     * @return true if the order was accepted for sending.
+     */
+    virtual bool send_order(const OrderRequest& order) {
+        (void)order;
+        return false;
+    }
+
+    /**
+     * @brief Requests cancellation of a working order.
+     * @param client_order_id The client order ID used when the order was sent.
+     * @return true if the cancel was accepted for sending.
+     */
+    virtual bool cancel_order(uint64_t client_order_id) {
+        (void)client_order_id;
+        return false;
+    }
+};
@@ -66,6 +66,11 @@ class IExchange {
 
         virtual void read_message() = 0;
 
+        /**
+         * @brief Number of messages dropped because the parser queue was full.
+         */
+        virtual uint64_t dropped_messages() const = 0;
+
 
         virtual net::io_context& get_io_context() = 0;
 
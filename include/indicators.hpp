@@ -0,0 +1,331 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+#include "level_book.hpp"
+
+// Streaming indicators. Each one updates in O(1) per event and allocates only in its
+// constructor. Timestamps are int64 nanoseconds, the unit of TradeData::trade_time and
+// OrderBookData::timestamp. Each indicator tracks one instrument; the *Batch classes keep
+// many instruments as flat arrays and update them all in one vectorizable pass.
+
+/**
+ * @class Ema
+ * @brief Exponential moving average with a fixed weight per sample.
+ */
+class Ema {
+public:
+    // Weight of each new sample; span N gives alpha = 2 / (N + 1)
+    explicit Ema(double alpha) : alpha_(alpha) {
+        if (!(alpha > 0.0 && alpha <= 1.0)) throw std::invalid_argument("Ema: alpha must be in (0, 1]");
+    }
+
+    static Ema from_span(double span) { return Ema(2.0 / (span + 1.0)); }
+
+    double update(double sample) {
+        value_ = ready_ ? value_ + alpha_ * (sample - value_) : sample;
+        ready_ = true;
+        return value_;
+    }
+
+    double value() const { return value_; }
+    bool ready() const { return ready_; }
+
+private:
+    double alpha_;
+    double value_ = 0.0;
+    bool ready_ = false;
+};
+
+/**
+ * @class TimeEma
+ * @brief Exponential moving average over irregular events, decaying with elapsed time.
+ *
+ * A sample's weight is 1 - exp(-dt / tau) for the time dt since the previous one, so a burst
+ * of ticks moves the average no further than a single tick spanning the same time would.
+ */
+class TimeEma {
+public:
+    explicit TimeEma(int64_t tau_ns) : inv_tau_(1.0 / static_cast<double>(tau_ns)) {
+        if (tau_ns <= 0) throw std::invalid_argument("TimeEma: tau must be positive");
+    }
+
+    double update(int64_t timestamp, double sample) {
+        if (!ready_) {
+            value_ = sample;
+            ready_ = true;
+        } else if (timestamp > last_) {
+            const double alpha = -std::expm1(-static_cast<double>(timestamp - last_) * inv_tau_);
+            value_ += alpha * (sample - value_);
+        }
+        last_ = std::max(last_, timestamp);
+        return value_;
+    }
+
+    double value() const { return value_; }
+    bool ready() const { return ready_; }
+
+private:
+    double inv_tau_;
+    double value_ = 0.0;
+    int64_t last_ = 0;
+    bool ready_ = false;
+};
+
+/**
+ * @class TimeWindowSums
+ * @brief Running sums of K values over the samples of the last `window` nanoseconds.
+ *
+ * Samples sit in a power-of-two ring allocated once; expiry pops them from the front in
+ * O(1) amortized. If a burst fills the ring, the oldest samples are evicted early and the
+ * window briefly covers less time; size capacity for the busiest window expected. Adding and
+ * subtracting drifts, so the sums are rebuilt from the ring once per lap.
+ */
+template<size_t K>
+class TimeWindowSums {
+public:
+    TimeWindowSums(int64_t window_ns, size_t capacity) : window_(window_ns) {
+        if (window_ns <= 0) throw std::invalid_argument("TimeWindowSums: window must be positive");
+        size_t n = 2;
+        while (n < capacity) n <<= 1;
+        ring_.resize(n);
+        mask_ = n - 1;
+    }
+
+    void push(int64_t timestamp, const std::array<double, K>& values) {
+        expire(timestamp);
+        if (tail_ - head_ == ring_.size()) {
+            pop();
+        }
+        ring_[tail_ & mask_] = Sample{timestamp, values};
+        for (size_t k = 0; k < K; ++k) sums_[k] += values[k];
+        if ((++tail_ & mask_) == 0) {
+            rebuild();
+        }
+    }
+
+    // Drops samples older than now - window
+    void expire(int64_t now) {
+        const int64_t cutoff = now - window_;
+        while (head_ != tail_ && ring_[head_ & mask_].timestamp <= cutoff) {
+            pop();
+        }
+    }
+
+    double sum(size_t k) const { return sums_[k]; }
+    size_t count() const { return tail_ - head_; }
+    int64_t window() const { return window_; }
+
+private:
+    struct Sample {
+        int64_t timestamp = 0;
+        std::array<double, K> values{};
+    };
+
+    void pop() {
+        const Sample& s = ring_[head_ & mask_];
+        for (size_t k = 0; k < K; ++k) sums_[k] -= s.values[k];
+        ++head_;
+        if (head_ == tail_) sums_ = {}; // Empty: exactly zero, whatever round-off was left
+    }
+
+    void rebuild() {
+        sums_ = {};
+        for (size_t i = head_; i != tail_; ++i) {
+            for (size_t k = 0; k < K; ++k) sums_[k] += ring_[i & mask_].values[k];
+        }
+    }
+
+    const int64_t window_;
+    std::vector<Sample> ring_;
+    size_t mask_ = 0;
+    size_t head_ = 0;
+    size_t tail_ = 0;
+    std::array<double, K> sums_{};
+};
+
+/**
+ * @class TimeSma
+ * @brief Simple moving average of the samples in the last `window` nanoseconds.
+ */
+class TimeSma {
+public:
+    TimeSma(int64_t window_ns, size_t capacity = 4096) : sums_(window_ns, capacity) {}
+
+    double update(int64_t timestamp, double sample) {
+        sums_.push(timestamp, {sample});
+        return value();
+    }
+
+    void expire(int64_t now) { sums_.expire(now); }
+    double value() const { return sums_.count() ? sums_.sum(0) / sums_.count() : 0.0; }
+    size_t count() const { return sums_.count(); }
+
+private:
+    TimeWindowSums<1> sums_;
+};
+
+/**
+ * @class RollingVwap
+ * @brief Volume-weighted average trade price over the last `window` nanoseconds.
+ */
+class RollingVwap {
+public:
+    RollingVwap(int64_t window_ns, size_t capacity = 4096) : sums_(window_ns, capacity) {}
+
+    double update(int64_t timestamp, double price, double quantity) {
+        sums_.push(timestamp, {price * quantity, quantity});
+        return value();
+    }
+
+    void expire(int64_t now) { sums_.expire(now); }
+    double value() const { return sums_.sum(1) > 0.0 ? sums_.sum(0) / sums_.sum(1) : 0.0; }
+    double volume() const { return sums_.sum(1); }
+
+private:
+    TimeWindowSums<2> sums_;
+};
+
+/**
+ * @class RealizedVolatility
+ * @brief Square root of the summed squared log returns between consecutive prices over the
+ *        last `window` nanoseconds: the window's volatility, not annualized.
+ *
+ * Feed it sampled prices (mid or last trade on a timer) rather than every trade, or bid-ask
+ * bounce between trades inflates it.
+ */
+class RealizedVolatility {
+public:
+    RealizedVolatility(int64_t window_ns, size_t capacity = 4096) : sums_(window_ns, capacity) {}
+
+    double update(int64_t timestamp, double price) {
+        const double log_price = std::log(price);
+        if (has_last_) {
+            const double r = log_price - last_log_price_;
+            sums_.push(timestamp, {r * r});
+        }
+        last_log_price_ = log_price;
+        has_last_ = true;
+        return value();
+    }
+
+    void expire(int64_t now) { sums_.expire(now); }
+    double value() const { return sums_.sum(0) > 0.0 ? std::sqrt(sums_.sum(0)) : 0.0; }
+    double variance() const { return sums_.sum(0) > 0.0 ? sums_.sum(0) : 0.0; }
+    size_t returns() const { return sums_.count(); }
+
+private:
+    TimeWindowSums<1> sums_;
+    double last_log_price_ = 0.0;
+    bool has_last_ = false;
+};
+
+/**
+ * @brief +1 for a buyer-initiated trade, -1 for seller-initiated, 0 if the side is unknown.
+ *
+ * TradeData::side must be the aggressor (taker) side; the venue processors all normalize to it.
+ */
+inline int aggressor_sign(std::string_view side) {
+    if (side == "buy" || side == "Buy" || side == "BUY") return 1;
+    if (side == "sell" || side == "Sell" || side == "SELL") return -1;
+    return 0;
+}
+
+/**
+ * @class TradeFlowImbalance
+ * @brief (buy volume - sell volume) / total volume of aggressor-signed trades over the last
+ *        `window` nanoseconds, in [-1, 1].
+ */
+class TradeFlowImbalance {
+public:
+    TradeFlowImbalance(int64_t window_ns, size_t capacity = 4096) : sums_(window_ns, capacity) {}
+
+    // sign from aggressor_sign(); unsigned trades are skipped
+    double update(int64_t timestamp, double quantity, int sign) {
+        if (sign != 0) {
+            sums_.push(timestamp, {sign * quantity, quantity});
+        }
+        return value();
+    }
+
+    void expire(int64_t now) { sums_.expire(now); }
+    double value() const { return sums_.sum(1) > 0.0 ? sums_.sum(0) / sums_.sum(1) : 0.0; }
+
+private:
+    TimeWindowSums<2> sums_;
+};
+
+// Top-of-book imbalance (bid size - ask size) / (bid size + ask size), in [-1, 1]
+inline double book_imbalance(double bid_quantity, double ask_quantity) {
+    const double total = bid_quantity + ask_quantity;
+    return total > 0.0 ? (bid_quantity - ask_quantity) / total : 0.0;
+}
+
+inline double book_imbalance(const LevelBook::TopOfBook& top) {
+    return book_imbalance(top.bid_quantity, top.ask_quantity);
+}
+
+// Size-weighted mid: leans toward the side with less size, where the next trade is likelier
+inline double microprice(double bid, double bid_quantity, double ask, double ask_quantity) {
+    const double total = bid_quantity + ask_quantity;
+    return total > 0.0 ? (bid * ask_quantity + ask * bid_quantity) / total : 0.5 * (bid + ask);
+}
+
+inline double microprice(const LevelBook::TopOfBook& top) {
+    return microprice(top.bid_price, top.bid_quantity, top.ask_price, top.ask_quantity);
+}
+
+/**
+ * @class EmaBatch
+ * @brief One EMA per instrument, all sampled at once, e.g. every instrument's mid on a timer.
+ *
+ * State is one contiguous array and update() a single branch-free loop over it, so the
+ * compiler runs it four (AVX2) or eight (AVX-512) instruments per instruction.
+ */
+class EmaBatch {
+public:
+    EmaBatch(size_t instruments, double alpha) : alpha_(alpha), values_(instruments, 0.0) {
+        if (!(alpha > 0.0 && alpha <= 1.0)) throw std::invalid_argument("EmaBatch: alpha must be in (0, 1]");
+    }
+
+    // Seeds every EMA, before the first update()
+    void reset(const double* samples) {
+        for (size_t i = 0; i < values_.size(); ++i) values_[i] = samples[i];
+    }
+
+    // samples[i] for instrument i
+    void update(const double* samples) {
+        double* v = values_.data();
+        const double alpha = alpha_;
+        for (size_t i = 0; i < values_.size(); ++i) {
+            v[i] += alpha * (samples[i] - v[i]);
+        }
+    }
+
+    const double* values() const { return values_.data(); }
+    size_t size() const { return values_.size(); }
+
+private:
+    double alpha_;
+    std::vector<double> values_;
+};
+
+/**
+ * @brief Book imbalance and microprice of n instruments from top-of-book arrays, in one
+ *        vectorizable pass. Instruments with no size on either side get 0 and the plain mid.
+ */
+inline void book_signals_batch(const double* bid, const double* bid_quantity, const double* ask,
+                               const double* ask_quantity, size_t n, double* imbalance, double* micro) {
+    for (size_t i = 0; i < n; ++i) {
+        const double total = bid_quantity[i] + ask_quantity[i];
+        const bool sized = total > 0.0;
+        const double inv = 1.0 / (sized ? total : 1.0);
+        imbalance[i] = sized ? (bid_quantity[i] - ask_quantity[i]) * inv : 0.0;
+        micro[i] = sized ? (bid[i] * ask_quantity[i] + ask[i] * bid_quantity[i]) * inv : 0.5 * (bid[i] + ask[i]);
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <stdexcept>
+
+struct InstrumentInfo {
+    uint32_t id;
+    std::string source;
+    std::string symbol;
+};
+
+/**
+ * @class InstrumentRegistry
+ * @brief Assigns dense integer IDs to (source, symbol) pairs.
+ *
+ * IDs start at 0 and are contiguous so hot-path components can keep their per-instrument
+ * state in flat arrays indexed by ID. Registration happens at startup; lookups are read-only
+ * and allocation-free afterwards.
+ */
+class InstrumentRegistry {
+public:
+    static constexpr uint32_t INVALID_INSTRUMENT = UINT32_MAX;
+
+    uint32_t add(std::string_view source, std::string_view symbol) {
+        uint32_t existing = find(source, symbol);
+        if (existing != INVALID_INSTRUMENT) {
+            return existing;
+        }
+
+        uint32_t id = static_cast<uint32_t>(instruments_.size());
+        instruments_.push_back(InstrumentInfo{id, std::string(source), std::string(symbol)});
+        venue_index(source).emplace(std::string(symbol), id);
+        return id;
+    }
+
+    uint32_t find(std::string_view source, std::string_view symbol) const {
+        for (const auto& venue : venues_) {
+            if (venue.source == source) {
+                auto it = venue.symbols.find(symbol);
+                return it != venue.symbols.end() ? it->second : INVALID_INSTRUMENT;
+            }
+        }
+        return INVALID_INSTRUMENT;
+    }
+
+    const InstrumentInfo& info(uint32_t id) const {
+        if (id >= instruments_.size()) {
+            throw std::out_of_range("Unknown instrument id: " + std::to_string(id));
+        }
+        return instruments_[id];
+    }
+
+    size_t size() const { return instruments_.size(); }
+
+private:
+    // Transparent hash so lookups by string_view don't build a temporary std::string
+    struct StringHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view s) const noexcept { return std::hash<std::string_view>{}(s); }
+    };
+
+    struct VenueIndex {
+        std::string source;
+        std::unordered_map<std::string, uint32_t, StringHash, std::equal_to<>> symbols;
+    };
+
+    std::unordered_map<std::string, uint32_t, StringHash, std::equal_to<>>& venue_index(std::string_view source) {
+        for (auto& venue : venues_) {
+            if (venue.source == source) return venue.symbols;
+        }
+        venues_.push_back(VenueIndex{std::string(source), {}});
+        return venues_.back().symbols;
+    }
+
+    std::vector<InstrumentInfo> instruments_;
+    // Only a handful of venues, so a linear scan beats hashing the source
+    std::vector<VenueIndex> venues_;
+};
@@ -0,0 +1,381 @@
+#pragma once
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <boost/asio/io_context.hpp>
+#include <boost/system/error_code.hpp>
+
+#ifdef __linux__
+#include <boost/asio/posix/stream_descriptor.hpp>
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @class IoUringReceiver
+ * @brief Callbacks for a socket receiving through IoUringService, run on the io_context thread.
+ */
+class IoUringReceiver {
+public:
+    virtual ~IoUringReceiver() = default;
+    // Bytes from one completion; the buffer goes back to the kernel when this returns
+    virtual void on_receive(const char* data, size_t size) = 0;
+    // The receive is over: 0 at end of stream, otherwise a negative errno
+    virtual void on_receive_end(int result) = 0;
+};
+
+/**
+ * @class IoUringService
+ * @brief An io_uring per io_context for the feed sockets' receive path.
+ *
+ * Each socket gets one multishot recv: a single submission that keeps completing for as long
+ * as data arrives, so a busy connection costs no syscall per read (epoll costs a wait plus a
+ * recv). The kernel picks the destination from a pool of buffers provided to it up front
+ * (IORING_OP_PROVIDE_BUFFERS) and names the buffer in the completion; the receiver copies the
+ * bytes out and the buffer goes back to the pool, a batch's worth in the one submission that
+ * follows the batch. Completions are reaped when the ring's
+ * eventfd, which asio watches like any other descriptor, becomes readable, so everything still
+ * runs on the thread calling io_context::run() and the sockets' writes, timers and TLS keep
+ * using asio.
+ *
+ * Talks to the kernel through <linux/io_uring.h> directly rather than liburing. Needs Linux
+ * 6.0 for multishot recv; available() is false where the ring, the buffers or a multishot
+ * probe fails, and callers stay on epoll.
+ */
+class IoUringService : public boost::asio::execution_context::service {
+public:
+    inline static boost::asio::execution_context::id id;
+
+    static constexpr unsigned RING_ENTRIES = 256;
+    static constexpr unsigned BUFFER_COUNT = 256; // Shared by every socket on the context
+    static constexpr unsigned BUFFER_SIZE = 16 * 1024;
+
+    explicit IoUringService(boost::asio::io_context& ioc)
+        : boost::asio::execution_context::service(ioc) {
+#ifdef __linux__
+        available_ = setup(ioc) && probe_multishot();
+        if (!available_) release();
+#endif
+    }
+
+    ~IoUringService() override { release(); }
+
+    bool available() const { return available_; }
+
+    /**
+     * @brief Starts a multishot receive on a connected socket.
+     * @return Its id for cancel(), 0 if it could not be submitted.
+     */
+    uint64_t start(int fd, IoUringReceiver* receiver) {
+#ifdef __linux__
+        if (!available_ || shut_down_) return 0;
+        uint64_t id = next_id_++;
+        if (!submit_recv(fd, id)) return 0;
+        receivers_[id] = {fd, receiver};
+        if (!waiting_) wait_for_completions();
+        return id;
+#else
+        (void)fd;
+        (void)receiver;
+        return 0;
+#endif
+    }
+
+    // The receiver gets no further callbacks; the kernel's cancellation completes later
+    void cancel(uint64_t id) {
+#ifdef __linux__
+        if (receivers_.erase(id) == 0 || shut_down_) return;
+        if (io_uring_sqe* sqe = next_sqe()) {
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->fd = -1;
+            sqe->addr = id;
+            sqe->user_data = INTERNAL_ID;
+            submit();
+        }
+#else
+        (void)id;
+#endif
+    }
+
+    uint64_t completions() const { return completions_; }
+    uint64_t buffer_shortages() const { return buffer_shortages_; }
+
+private:
+    static constexpr uint64_t INTERNAL_ID = 0; // Buffer and cancel submissions
+    static constexpr uint64_t PROBE_ID = 1;
+    static constexpr uint16_t BUFFER_GROUP = 0;
+
+    struct Registration {
+        int fd;
+        IoUringReceiver* receiver;
+    };
+
+    void shutdown() override {
+        shut_down_ = true;
+        receivers_.clear();
+#ifdef __linux__
+        boost::system::error_code ignored;
+        if (eventfd_) eventfd_->close(ignored);
+#endif
+    }
+
+#ifdef __linux__
+    static int sys_setup(unsigned entries, io_uring_params* params) {
+        return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+    }
+    static int sys_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+        return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+    }
+    static int sys_register(int fd, unsigned opcode, const void* arg, unsigned count) {
+        return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, count));
+    }
+
+    static bool fail(const char* what) {
+        std::cerr << "[io_uring] " << what << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    static void* map(size_t size, int flags, int fd = -1, off_t offset = 0) {
+        void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags | MAP_POPULATE, fd, offset);
+        return p == MAP_FAILED ? nullptr : p;
+    }
+
+    bool setup(boost::asio::io_context& ioc) {
+        io_uring_params params{};
+        ring_fd_ = sys_setup(RING_ENTRIES, &params);
+        if (ring_fd_ < 0) return fail("io_uring_setup");
+        if (!(params.features & IORING_FEAT_SINGLE_MMAP)) {
+            std::cerr << "[io_uring] Kernel too old (no IORING_FEAT_SINGLE_MMAP)" << std::endl;
+            return false;
+        }
+
+        // The SQ and CQ rings share one mapping
+        ring_size_ = std::max(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+                              params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+        ring_ = map(ring_size_, MAP_SHARED, ring_fd_, IORING_OFF_SQ_RING);
+        if (!ring_) return fail("mmap rings");
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe*>(map(sqes_size_, MAP_SHARED, ring_fd_, IORING_OFF_SQES));
+        if (!sqes_) return fail("mmap sqes");
+
+        char* base = static_cast<char*>(ring_);
+        sq_head_ = reinterpret_cast<unsigned*>(base + params.sq_off.head);
+        sq_tail_ = reinterpret_cast<unsigned*>(base + params.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned*>(base + params.sq_off.ring_mask);
+        sq_entries_ = params.sq_entries;
+        sq_array_ = reinterpret_cast<unsigned*>(base + params.sq_off.array);
+        cq_head_ = reinterpret_cast<unsigned*>(base + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(base + params.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned*>(base + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(base + params.cq_off.cqes);
+
+        buffers_ = static_cast<char*>(map(size_t{BUFFER_COUNT} * BUFFER_SIZE, MAP_PRIVATE | MAP_ANONYMOUS));
+        if (!buffers_) return fail("mmap buffers");
+        provide(0, BUFFER_COUNT);
+        io_uring_cqe provided = wait_completion();
+        if (provided.res < 0) {
+            errno = -provided.res;
+            return fail("IORING_OP_PROVIDE_BUFFERS");
+        }
+
+        int efd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (efd < 0) return fail("eventfd");
+        eventfd_ = std::make_unique<boost::asio::posix::stream_descriptor>(ioc, efd);
+        if (sys_register(ring_fd_, IORING_REGISTER_EVENTFD, &efd, 1) != 0) {
+            return fail("IORING_REGISTER_EVENTFD");
+        }
+        return true;
+    }
+
+    // Multishot recv was added in 6.0; older kernels reject the flag
+    bool probe_multishot() {
+        int fds[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0) return fail("socketpair");
+        bool supported = false;
+        if (write(fds[1], "x", 1) == 1 && submit_recv(fds[0], PROBE_ID)) {
+            io_uring_cqe cqe = wait_completion();
+            supported = cqe.res == 1 && (cqe.flags & IORING_CQE_F_MORE);
+            if (cqe.flags & IORING_CQE_F_BUFFER) recycle(cqe.flags);
+        }
+        close(fds[1]); // End of stream finishes the probe's receive; its last completion is ignored
+        close(fds[0]);
+        if (!supported) std::cerr << "[io_uring] Multishot recv not supported by this kernel" << std::endl;
+        return supported && submit();
+    }
+
+    // Setup only, while nothing else is in flight
+    io_uring_cqe wait_completion() {
+        io_uring_cqe cqe{};
+        int submitted = sys_enter(ring_fd_, unsubmitted_, 1, IORING_ENTER_GETEVENTS);
+        if (submitted < 0) {
+            cqe.res = -errno;
+            return cqe;
+        }
+        unsubmitted_ -= static_cast<unsigned>(submitted);
+        unsigned head = *cq_head_;
+        cqe = cqes_[head & cq_mask_];
+        __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+        return cqe;
+    }
+
+    io_uring_sqe* next_sqe() {
+        unsigned tail = *sq_tail_;
+        if (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) == sq_entries_) {
+            submit(); // Full only if submissions failed; flush and retry once
+            if (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) == sq_entries_) return nullptr;
+        }
+        io_uring_sqe* sqe = &sqes_[tail & sq_mask_];
+        memset(sqe, 0, sizeof(*sqe));
+        sq_array_[tail & sq_mask_] = tail & sq_mask_;
+        __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+        ++unsubmitted_;
+        return sqe;
+    }
+
+    bool submit() {
+        if (unsubmitted_ == 0) return true;
+        int submitted = sys_enter(ring_fd_, unsubmitted_, 0, 0);
+        if (submitted < 0) return fail("io_uring_enter");
+        unsubmitted_ -= static_cast<unsigned>(submitted);
+        return true;
+    }
+
+    bool submit_recv(int fd, uint64_t id) {
+        io_uring_sqe* sqe = next_sqe();
+        if (!sqe) return false;
+        sqe->opcode = IORING_OP_RECV;
+        sqe->fd = fd;
+        sqe->ioprio = IORING_RECV_MULTISHOT;
+        sqe->flags = IOSQE_BUFFER_SELECT;
+        sqe->buf_group = BUFFER_GROUP;
+        sqe->user_data = id;
+        return submit();
+    }
+
+    // Queued only; goes to the kernel with the next submit
+    void provide(uint16_t bid, unsigned count) {
+        io_uring_sqe* sqe = next_sqe();
+        if (!sqe) return;
+        sqe->opcode = IORING_OP_PROVIDE_BUFFERS;
+        sqe->fd = static_cast<int>(count);
+        sqe->addr = reinterpret_cast<uint64_t>(buffers_ + size_t{bid} * BUFFER_SIZE);
+        sqe->len = BUFFER_SIZE;
+        sqe->off = bid;
+        sqe->buf_group = BUFFER_GROUP;
+        sqe->user_data = INTERNAL_ID;
+    }
+
+    void recycle(uint32_t cqe_flags) { provide(static_cast<uint16_t>(cqe_flags >> IORING_CQE_BUFFER_SHIFT), 1); }
+
+    // Armed only while receives are running, so like a socket read it keeps run() from returning
+    // only while there is something to wait for. Completions left behind are reaped on the next start
+    void wait_for_completions() {
+        waiting_ = true;
+        eventfd_->async_wait(boost::asio::posix::stream_descriptor::wait_read,
+            [this](boost::system::error_code ec) {
+                waiting_ = false;
+                if (ec || shut_down_) return;
+                uint64_t count;
+                ssize_t ignored = read(eventfd_->native_handle(), &count, sizeof(count));
+                (void)ignored;
+                reap();
+                if (!receivers_.empty() && !waiting_) wait_for_completions();
+            });
+    }
+
+    void reap() {
+        unsigned head = *cq_head_;
+        unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+        for (; head != tail; ++head) {
+            // Copied out: a receiver's callback may submit, and the slot is free once head moves
+            io_uring_cqe cqe = cqes_[head & cq_mask_];
+            __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+            ++completions_;
+            if (cqe.user_data == INTERNAL_ID) {
+                // A cancel may find its receive already finished
+                if (cqe.res < 0 && cqe.res != -ENOENT && cqe.res != -EALREADY) {
+                    errno = -cqe.res;
+                    fail("io_uring request");
+                }
+                continue;
+            }
+
+            auto it = receivers_.find(cqe.user_data);
+            if (cqe.res > 0 && (cqe.flags & IORING_CQE_F_BUFFER)) {
+                if (it != receivers_.end()) {
+                    const char* data = buffers_ + size_t{cqe.flags >> IORING_CQE_BUFFER_SHIFT} * BUFFER_SIZE;
+                    it->second.receiver->on_receive(data, static_cast<size_t>(cqe.res));
+                }
+                recycle(cqe.flags);
+            }
+            if (cqe.flags & IORING_CQE_F_MORE) continue;
+
+            // The multishot ended; the callback above may have cancelled it
+            it = receivers_.find(cqe.user_data);
+            if (it == receivers_.end()) continue;
+            int result = cqe.res;
+            if (result > 0 || result == -ENOBUFS) {
+                // Stopped early, typically with every buffer in use; they are queued to go back first
+                if (result == -ENOBUFS) ++buffer_shortages_;
+                if (submit_recv(it->second.fd, cqe.user_data)) continue;
+                result = -EIO;
+            }
+            IoUringReceiver* receiver = it->second.receiver;
+            receivers_.erase(it);
+            receiver->on_receive_end(result);
+        }
+        submit();
+    }
+#endif
+
+    void release() {
+#ifdef __linux__
+        available_ = false;
+        eventfd_.reset();
+        if (buffers_) munmap(buffers_, size_t{BUFFER_COUNT} * BUFFER_SIZE);
+        if (sqes_) munmap(sqes_, sqes_size_);
+        if (ring_) munmap(ring_, ring_size_);
+        if (ring_fd_ >= 0) close(ring_fd_);
+        buffers_ = nullptr;
+        sqes_ = nullptr;
+        ring_ = nullptr;
+        ring_fd_ = -1;
+#endif
+    }
+
+    bool available_ = false;
+    bool shut_down_ = false;
+    bool waiting_ = false;
+    std::unordered_map<uint64_t, Registration> receivers_;
+    uint64_t next_id_ = PROBE_ID + 1;
+    uint64_t completions_ = 0;
+    uint64_t buffer_shortages_ = 0;
+
+#ifdef __linux__
+    std::unique_ptr<boost::asio::posix::stream_descriptor> eventfd_; // Registered with the ring
+    int ring_fd_ = -1;
+    void* ring_ = nullptr;
+    size_t ring_size_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    size_t sqes_size_ = 0;
+    unsigned* sq_head_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned* sq_array_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned sq_entries_ = 0;
+    unsigned unsubmitted_ = 0;
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned cq_mask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+    char* buffers_ = nullptr;
+#endif
+};
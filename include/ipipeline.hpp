@@ -1,6 +1,10 @@
 #pragma once
 
 #include "event_bus.hpp"
+#include "latency_trace.hpp"
+#include "socket_tuning.hpp"
+#include "utils.hpp"
+#include "wait_strategy.hpp"
 #include <string>
 #include <memory>
 #include <boost/json.hpp>
@@ -18,6 +22,14 @@ class IPipeline {
                                 const boost::json::object& subscription_info) = 0;
         virtual void start() = 0;
         virtual void stop() = 0;
+
+        // Configuration, before start()
+        virtual void set_thread_placement(const ThreadPlacement& exchange_thread, const ThreadPlacement& parser_thread) = 0;
+        virtual void set_wait_strategy(WaitStrategy strategy) = 0;
+        virtual void set_socket_tuning(const SocketTuning& tuning) = 0;
+
+        virtual const LatencyTracer& latency_tracer() const = 0;
+        virtual uint64_t dropped_messages() const = 0;
         virtual ~IPipeline() = default;
 
 };
\ No newline at end of file
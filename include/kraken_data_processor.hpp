@@ -1,20 +1,27 @@
 #pragma once
 #include "spsc_queue.hpp"
 #include "event_bus.hpp"
+#include "latency_trace.hpp"
+#include "wait_strategy.hpp"
 #include <string>
 #include <memory>
 
 class KrakenDataProcessor {
 private:
     bool running_ = false;
-    SPSCQueue<std::string>& queue_;
+    SPSCQueue<RawMessage>& queue_;
     std::shared_ptr<EventBus> event_bus_;
+    LatencyTracer tracer_;
+    WaitStrategy wait_strategy_ = WaitStrategy::Sleep;
 
 public:
-    KrakenDataProcessor(SPSCQueue<std::string>& queue, std::shared_ptr<EventBus> event_bus);
+    KrakenDataProcessor(SPSCQueue<RawMessage>& queue, std::shared_ptr<EventBus> event_bus);
     ~KrakenDataProcessor();
 
     void start();
     void stop();
-    void parse_and_publish(const std::string& message);
+    // Before start()
+    void set_wait_strategy(WaitStrategy strategy) { wait_strategy_ = strategy; }
+    void parse_and_publish(RawMessage& message);
+    const LatencyTracer& tracer() const { return tracer_; }
 };
\ No newline at end of file
@@ -166,35 +166,9 @@ public:
     }
 
 
+    // Kraken v2 timestamps are UTC RFC3339, e.g. "2023-09-25T07:49:37.708706Z"
     static inline int64_t parse_kraken_timestamp(const char* start, size_t len) {
         if (len < 20) return 0;
-        int year, month, day, hour, minute, second;
-        int nanoseconds = 0;
-        
-        sscanf(start, "%d-%d-%dT%d:%d:%d", &year, &month, &day, &hour, &minute, &second);
-
-        const char* dot = strchr(start, '.');
-        if (dot) {
-            int i = 0;
-            char ns_str[10] = {0};
-            const char* p = dot + 1;
-            while (*p >= '0' && *p <= '9' && i < 9) ns_str[i++] = *p++;
-            nanoseconds = atoi(ns_str);
-            for (int j = i; j < 9; j++) nanoseconds *= 10;
-        }
-
-        std::tm t{};
-        t.tm_year = year - 1900;
-        t.tm_mon = month - 1;
-        t.tm_mday = day;
-        t.tm_hour = hour;
-        t.tm_min = minute;
-        t.tm_sec = second;
-
-        auto time_point = std::chrono::system_clock::from_time_t(std::mktime(&t));
-        auto duration_since_epoch = time_point.time_since_epoch();
-        int64_t nanoseconds_total = std::chrono::duration_cast<std::chrono::nanoseconds>(duration_since_epoch).count() + nanoseconds;
-        
-        return nanoseconds_total;
+        return parse_iso8601_nanos(start, len);
     }
 };
\ No newline at end of file
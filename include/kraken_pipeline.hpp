@@ -3,25 +3,36 @@
 #include "kraken_exchange.hpp"
 #include "kraken_data_processor.hpp"
 #include "event_bus.hpp"
+#include "ipipeline.hpp"
 #include <thread>
 #include <string>
 
-class KrakenPipeline {
+class KrakenPipeline : public IPipeline {
 private:
-    SPSCQueue<std::string>& queue_;
+    SPSCQueue<RawMessage>& queue_;
     std::shared_ptr<KrakenExchange> exchange_; 
     KrakenDataProcessor data_parser_;
     std::shared_ptr<EventBus> event_bus_;
     std::thread exchange_thread_;
     std::thread parser_thread_;
     bool running_ = false;
+    ThreadPlacement exchange_placement_;
+    ThreadPlacement parser_placement_;
 
 public:
-    KrakenPipeline(SPSCQueue<std::string>& queue, std::shared_ptr<EventBus> event_bus);
+    KrakenPipeline(SPSCQueue<RawMessage>& queue, std::shared_ptr<EventBus> event_bus);
     ~KrakenPipeline();
 
     void initialize(const std::string& host, const std::string& port, const std::string& target,
-                    const boost::json::object& subscription_info);
-    void start();
-    void stop();
+                    const boost::json::object& subscription_info) override;
+    void start() override;
+    void stop() override;
+    void set_thread_placement(const ThreadPlacement& exchange_thread, const ThreadPlacement& parser_thread) override {
+        exchange_placement_ = exchange_thread;
+        parser_placement_ = parser_thread;
+    }
+    void set_wait_strategy(WaitStrategy strategy) override { data_parser_.set_wait_strategy(strategy); }
+    void set_socket_tuning(const SocketTuning& tuning) override { exchange_->set_socket_tuning(tuning); }
+    const LatencyTracer& latency_tracer() const override { return data_parser_.tracer(); }
+    uint64_t dropped_messages() const override { return exchange_->dropped_messages(); }
 };
\ No newline at end of file
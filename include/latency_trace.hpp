@@ -0,0 +1,182 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <iomanip>
+#include "types.hpp"
+#include "event_bus.hpp"
+#include "fast_clock.hpp"
+#include "utils.hpp"
+
+/**
+ * @class LatencyHistogram
+ * @brief Fixed-size log-linear (HDR-style) histogram of nanosecond latencies.
+ *
+ * Values below 32ns are exact; above that each power of two is split into 32 sub-buckets,
+ * giving ~3% relative precision up to ~18 minutes. Recording is a clz and one increment.
+ * Single writer; counts are relaxed atomics so another thread can export while recording.
+ */
+class LatencyHistogram {
+public:
+    static constexpr uint32_t SUB_BUCKET_BITS = 5;
+    static constexpr uint32_t SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+    static constexpr uint32_t MAX_SHIFT = 40;
+    static constexpr uint32_t BUCKET_COUNT = (MAX_SHIFT + 1) * SUB_BUCKETS + SUB_BUCKETS;
+
+    void record(int64_t value_ns) {
+        uint64_t v = value_ns > 0 ? static_cast<uint64_t>(value_ns) : 0;
+        uint32_t idx = bucket_index(v);
+        counts_[idx].store(counts_[idx].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        total_.store(total_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (v > max_.load(std::memory_order_relaxed)) max_.store(v, std::memory_order_relaxed);
+    }
+
+    uint64_t count() const { return total_.load(std::memory_order_relaxed); }
+    uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+
+    // Returns the lower bound of the bucket holding the given percentile (0-100)
+    uint64_t percentile(double pct) const {
+        uint64_t total = count();
+        if (total == 0) return 0;
+        uint64_t target = static_cast<uint64_t>(static_cast<double>(total) * pct / 100.0);
+        if (target == 0) target = 1;
+        uint64_t seen = 0;
+        for (uint32_t i = 0; i < BUCKET_COUNT; ++i) {
+            seen += counts_[i].load(std::memory_order_relaxed);
+            if (seen >= target) return bucket_value(i);
+        }
+        return max();
+    }
+
+    // Writes the distribution in HdrHistogram's percentile text format
+    void export_percentiles(std::ostream& out) const {
+        uint64_t total = count();
+        out << std::setw(12) << "Value" << std::setw(15) << "Percentile" << std::setw(12) << "TotalCount"
+            << std::setw(16) << "1/(1-Percentile)" << "\n\n";
+        uint64_t seen = 0;
+        for (uint32_t i = 0; i < BUCKET_COUNT && total > 0; ++i) {
+            uint64_t c = counts_[i].load(std::memory_order_relaxed);
+            if (c == 0) continue;
+            seen += c;
+            double p = static_cast<double>(seen) / static_cast<double>(total);
+            out << std::setw(12) << bucket_value(i) << std::setw(15) << std::fixed << std::setprecision(12) << p
+                << std::setw(12) << seen;
+            if (p < 1.0) out << std::setw(16) << std::setprecision(2) << 1.0 / (1.0 - p);
+            out << "\n";
+        }
+        out << "#[Max = " << max() << ", Total count = " << total << "]\n";
+    }
+
+private:
+    static uint32_t bucket_index(uint64_t v) {
+        if (v < SUB_BUCKETS) return static_cast<uint32_t>(v);
+        uint32_t msb = 63 - static_cast<uint32_t>(__builtin_clzll(v));
+        uint32_t shift = msb - SUB_BUCKET_BITS;
+        if (shift > MAX_SHIFT) return BUCKET_COUNT - 1;
+        return shift * SUB_BUCKETS + static_cast<uint32_t>(v >> shift);
+    }
+
+    static uint64_t bucket_value(uint32_t idx) {
+        if (idx < SUB_BUCKETS) return idx;
+        uint32_t shift = idx / SUB_BUCKETS - 1;
+        return static_cast<uint64_t>(idx - shift * SUB_BUCKETS) << shift;
+    }
+
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> counts_{};
+    std::atomic<uint64_t> total_{0};
+    std::atomic<uint64_t> max_{0};
+};
+
+enum class TraceStage : uint8_t {
+    Network,        // exchange event time -> kernel receive, or socket receive without kernel timestamps
+                    // (wall clock, includes clock skew)
+    RxStack,        // kernel receive -> socket receive: wakeup, TLS and WebSocket decoding
+    Enqueue,        // socket receive -> pushed to SPSC queue
+    QueueWait,      // enqueue -> dequeue by the parser thread
+    Parse,          // dequeue -> event built
+    Handlers,       // event built -> all bus handlers returned
+    Total,          // socket receive -> all bus handlers returned
+    Count
+};
+
+inline const char* to_string(TraceStage stage) {
+    switch (stage) {
+        case TraceStage::Network: return "network";
+        case TraceStage::RxStack: return "rx_stack";
+        case TraceStage::Enqueue: return "enqueue";
+        case TraceStage::QueueWait: return "queue_wait";
+        case TraceStage::Parse: return "parse";
+        case TraceStage::Handlers: return "handlers";
+        case TraceStage::Total: return "total";
+        case TraceStage::Count: break;
+    }
+    return "unknown";
+}
+
+/**
+ * @class LatencyTracer
+ * @brief Per-stage latency histograms fed from completed TraceRecords.
+ *
+ * Each data processor owns one and records from its parser thread; export() can be called
+ * from any thread at any time.
+ */
+class LatencyTracer {
+public:
+    void record(const TraceRecord& trace, int64_t socket_rx_epoch_ns) {
+        // With a kernel timestamp the network stage stops at the NIC, and our own stack is split out
+        int64_t arrival_ns = trace.kernel_rx > 0 ? trace.kernel_rx : socket_rx_epoch_ns;
+        if (trace.exchange_time > 0) {
+            stage(TraceStage::Network).record(arrival_ns - trace.exchange_time);
+        }
+        if (trace.kernel_rx > 0) {
+            stage(TraceStage::RxStack).record(socket_rx_epoch_ns - trace.kernel_rx);
+        }
+        stage(TraceStage::Enqueue).record(FastClock::elapsed_nanos(trace.socket_rx, trace.enqueue));
+        stage(TraceStage::QueueWait).record(FastClock::elapsed_nanos(trace.enqueue, trace.dequeue));
+        stage(TraceStage::Parse).record(FastClock::elapsed_nanos(trace.dequeue, trace.parse_done));
+        stage(TraceStage::Handlers).record(FastClock::elapsed_nanos(trace.parse_done, trace.handler_done));
+        stage(TraceStage::Total).record(FastClock::elapsed_nanos(trace.socket_rx, trace.handler_done));
+    }
+
+    LatencyHistogram& stage(TraceStage s) { return histograms_[static_cast<size_t>(s)]; }
+    const LatencyHistogram& stage(TraceStage s) const { return histograms_[static_cast<size_t>(s)]; }
+
+    // One summary line per stage, in nanoseconds
+    void export_summary(std::ostream& out, std::string_view name) const {
+        for (size_t i = 0; i < static_cast<size_t>(TraceStage::Count); ++i) {
+            const LatencyHistogram& h = histograms_[i];
+            out << name << " " << std::left << std::setw(11) << to_string(static_cast<TraceStage>(i)) << std::right
+                << " count=" << h.count() << " p50=" << h.percentile(50.0) << " p99=" << h.percentile(99.0)
+                << " p99.9=" << h.percentile(99.9) << " max=" << h.max() << "\n";
+        }
+    }
+
+    void export_histograms(std::ostream& out, std::string_view name) const {
+        for (size_t i = 0; i < static_cast<size_t>(TraceStage::Count); ++i) {
+            out << "# " << name << " " << to_string(static_cast<TraceStage>(i)) << "\n";
+            histograms_[i].export_percentiles(out);
+            out << "\n";
+        }
+    }
+
+private:
+    std::array<LatencyHistogram, static_cast<size_t>(TraceStage::Count)> histograms_;
+};
+
+/**
+ * @brief Stamps parse completion, publishes the event, then records the finished trace.
+ *
+ * Handlers see the trace up to parse_done; handler_done is only known once publish returns.
+ */
+template<typename EventType>
+inline void publish_traced(EventBus& event_bus, EventType& event, TraceRecord& trace, LatencyTracer& tracer) {
+    trace.parse_done = FastClock::ticks();
+    event.data.trace = trace;
+    event_bus.publish(event);
+    trace.handler_done = FastClock::ticks();
+
+    // Map socket_rx onto the wall clock to compare with the exchange's own timestamp
+    int64_t rx_epoch_ns = FastClock::to_epoch_nanos(trace.socket_rx);
+    tracer.record(trace, rx_epoch_ns);
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "types.hpp"
+
+/**
+ * @class LevelBook
+ * @brief Price-level book for one instrument on one venue, maintained from OrderBookData updates.
+ *
+ * Both sides are flat vectors sorted best first (bids descending, asks ascending), so the best
+ * levels sit at the front of contiguous memory and a walk down the book is a linear scan.
+ * Updates carry absolute quantities per level: a quantity of 0 removes the level, anything else
+ * replaces it. An update marked as a snapshot replaces the whole book instead.
+ *
+ * Diffs are only applied on top of a snapshot: until one arrives, and again after clear(), every
+ * diff is ignored, so a book is either complete or empty. Sequenced diffs (first_id set, as
+ * Binance's U/u) must also be contiguous: diffs the snapshot already covers (id <= last id) are
+ * ignored, and a diff that skips IDs (first_id > last id + 1) means updates were lost, so the
+ * book is cleared and waits for the next snapshot. Unsequenced venues (Coinbase, Kraken) can't
+ * show a loss themselves; the feed's Gap or Disconnected status clears their books, and the
+ * supervisor resubscribes so the venue sends a fresh snapshot.
+ */
+class LevelBook {
+public:
+    struct TopOfBook {
+        double bid_price = 0.0;
+        double bid_quantity = 0.0;
+        double ask_price = 0.0;
+        double ask_quantity = 0.0;
+
+        bool operator==(const TopOfBook& other) const {
+            return bid_price == other.bid_price && bid_quantity == other.bid_quantity &&
+                   ask_price == other.ask_price && ask_quantity == other.ask_quantity;
+        }
+        bool operator!=(const TopOfBook& other) const { return !(*this == other); }
+    };
+
+    // Returns true if the best bid or ask (price or quantity) changed
+    bool apply(const OrderBookData& update) {
+        const TopOfBook before = top();
+        if (update.snapshot) {
+            bids_.clear();
+            asks_.clear();
+            seeded_ = true;
+        } else if (!seeded_) {
+            return false;
+        } else if (update.first_id != 0) {
+            if (update.id <= last_id_) return false;
+            if (update.first_id > last_id_ + 1) {
+                clear();
+                ++gaps_;
+                return top() != before;
+            }
+        }
+        for (const auto& level : update.bids) set_level(bids_, level, std::greater<double>());
+        for (const auto& level : update.asks) set_level(asks_, level, std::less<double>());
+        last_id_ = update.id;
+        timestamp_ = update.timestamp;
+        return top() != before;
+    }
+
+    // Feed lost, stale or gapped: nothing in the book can be trusted until it is rebuilt
+    void clear() {
+        bids_.clear();
+        asks_.clear();
+        seeded_ = false;
+        last_id_ = 0;
+    }
+
+    TopOfBook top() const {
+        TopOfBook t;
+        if (!bids_.empty()) {
+            t.bid_price = bids_.front().first;
+            t.bid_quantity = bids_.front().second;
+        }
+        if (!asks_.empty()) {
+            t.ask_price = asks_.front().first;
+            t.ask_quantity = asks_.front().second;
+        }
+        return t;
+    }
+
+    // Best first
+    const std::vector<PriceLevel>& bids() const { return bids_; }
+    const std::vector<PriceLevel>& asks() const { return asks_; }
+    bool empty() const { return bids_.empty() && asks_.empty(); }
+    int64_t timestamp() const { return timestamp_; }
+    // Last update ID applied, 0 for unsequenced venues
+    int64_t last_id() const { return last_id_; }
+    // Sequence breaks that cleared the book
+    uint64_t gaps() const { return gaps_; }
+
+private:
+    template<typename Better>
+    static void set_level(std::vector<PriceLevel>& side, const PriceLevel& level, Better better) {
+        auto it = std::lower_bound(side.begin(), side.end(), level.first,
+                                   [&](const PriceLevel& l, double price) { return better(l.first, price); });
+        const bool exists = it != side.end() && it->first == level.first;
+        if (level.second <= 0.0) {
+            if (exists) side.erase(it);
+        } else if (exists) {
+            it->second = level.second;
+        } else {
+            side.insert(it, level);
+        }
+    }
+
+    std::vector<PriceLevel> bids_;
+    std::vector<PriceLevel> asks_;
+    int64_t timestamp_ = 0;
+    int64_t last_id_ = 0;
+    uint64_t gaps_ = 0;
+    bool seeded_ = false; // A snapshot has been applied since the last clear()
+};
@@ -12,9 +12,10 @@
 #include <stdexcept>
 #include <filesystem>
 
-#include "EventBus.hpp"
+#include "event_bus.hpp"
 #include "types.hpp"
 #include "utils.hpp"
+#include "fast_clock.hpp"
 
 #define CPU_PIN 8
 
@@ -22,6 +23,7 @@ class Logger {
 private:
     quill::Logger* logger_;
     static std::string filename_;
+    static int backend_cpu_;
     static std::mutex init_mutex_;
     static bool is_initialized_;
 
@@ -37,7 +39,9 @@ private:
 
             if (!quill::Backend::is_running()) {
                 quill::BackendOptions backend_options;
-                backend_options.cpu_affinity = CPU_PIN;
+                if (backend_cpu_ >= 0) {
+                    backend_options.cpu_affinity = static_cast<uint16_t>(backend_cpu_);
+                }
                 quill::Backend::start(backend_options);
             }
 
@@ -80,7 +84,8 @@ private:
 
 public:
     // --- Initialization ---
-    static void init(const std::string& custom_filename) {
+    // backend_cpu pins quill's backend thread; -1 leaves it unpinned
+    static void init(const std::string& custom_filename, int backend_cpu = CPU_PIN) {
         std::lock_guard<std::mutex> lock(init_mutex_);
         if (is_initialized_) {
             throw std::runtime_error("Logger already initialized");
@@ -89,6 +94,7 @@ public:
             throw std::invalid_argument("Custom filename cannot be empty");
         }
         filename_ = custom_filename;
+        backend_cpu_ = backend_cpu;
         is_initialized_ = true;
 
     }
@@ -114,8 +120,9 @@ public:
 
     quill::Logger* getQuillLogger() { return logger_; }
 
+    // elapsed is socket receive to logger, in nanoseconds
     inline void logTradeEvent(const TradeEvent& event) {
-        auto elapsed = get_time_now_nano() - event.data.trade_time;
+        auto elapsed = FastClock::elapsed_nanos(event.data.trace.socket_rx, FastClock::ticks());
         LOG_INFO(logger_, "TradeEvent: source={}, symbol={}, price={:.6f}, quantity={:.4f}, trade_time={}, elapsed={}",
             event.data.source, event.data.symbol, event.data.price, event.data.quantity,
             event.data.trade_time, elapsed);
@@ -130,7 +137,7 @@ public:
     }
 
     inline void logTickerDataEvent(const TickerDataEvent& event) {
-        auto elapsed = get_time_now_nano() - event.data.timestamp;
+        auto elapsed = FastClock::elapsed_nanos(event.data.trace.socket_rx, FastClock::ticks());
         LOG_INFO(logger_, "TickerDataEvent: source={}, symbol={}, best_ask={:.6f}, best_bid={:.6f}, "
             "high_24h={:.6f}, low_24h={:.6f}, last_price={:.6f}, price_change_24h={:.6f}, elapsed={}",
             event.data.source, event.data.symbol, event.data.best_ask, event.data.best_bid, event.data.high_24h,
@@ -138,16 +145,24 @@ public:
     }
 
     inline void logOrderBookDataEvent(const OrderBookDataEvent& event) {
-        auto elapsed = get_time_now_nano() - event.data.timestamp;
+        auto elapsed = FastClock::elapsed_nanos(event.data.trace.socket_rx, FastClock::ticks());
         LOG_INFO(logger_, "OrderBookDataEvent: source={}, symbol={}, timestamp={}, elapsed={}",
             event.data.source, event.data.symbol, event.data.timestamp, elapsed);
     }
 
+    inline void logFeedStatusEvent(const FeedStatusEvent& event) {
+        static constexpr const char* states[] = {"Connected", "Disconnected", "Stale", "Gap"};
+        LOG_WARNING(logger_, "FeedStatusEvent: source={}, state={}, connection={}, reason={}, timestamp={}",
+            event.data.source, states[static_cast<int>(event.data.state)], event.data.connection,
+            event.data.reason, event.data.timestamp);
+    }
+
     void subscribeToBus(std::shared_ptr<EventBus> event_bus) {
         event_bus->subscribe<TradeEvent>([this](const TradeEvent& e) { this->logTradeEvent(e); });
         event_bus->subscribe<CandleStickDataEvent>([this](const CandleStickDataEvent& e) { this->logCandleStickDataEvent(e); });
         event_bus->subscribe<TickerDataEvent>([this](const TickerDataEvent& e) { this->logTickerDataEvent(e); });
         event_bus->subscribe<OrderBookDataEvent>([this](const OrderBookDataEvent& e) { this->logOrderBookDataEvent(e); });
+        event_bus->subscribe<FeedStatusEvent>([this](const FeedStatusEvent& e) { this->logFeedStatusEvent(e); });
     }
 
     void setLogLevel(quill::LogLevel level) {
@@ -164,5 +179,6 @@ public:
 };
 
 std::string Logger::filename_;
+int Logger::backend_cpu_ = CPU_PIN;
 std::mutex Logger::init_mutex_;
 bool Logger::is_initialized_ = false;
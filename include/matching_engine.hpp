@@ -0,0 +1,191 @@
+#pragma once
+#include <map>
+#include <deque>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <algorithm>
+#include <cstdint>
+#include "types.hpp"
+
+struct Execution {
+    uint64_t order_id;
+    uint64_t owner_id;
+    std::string client_order_id;
+    std::string symbol;
+    Side side;
+    OrderStatus status;
+    double price;
+    double quantity;
+    double last_quantity;
+    double last_price;
+    double cumulative_quantity;
+};
+
+/**
+ * @class MatchingEngine
+ * @brief Price-time priority limit order book used by the local exchange simulator.
+ *
+ * Each symbol keeps bids and asks as price levels of FIFO queues. Incoming orders match
+ * against the opposite side while they cross; limit remainders rest, market remainders are
+ * canceled. An order reusing the client order ID of one of its owner's resting orders is
+ * rejected, as Binance does, so every resting order stays cancelable. Results are returned as
+ * Execution reports for both taker and makers, tagged with the owner ID of the session that
+ * placed each order.
+ *
+ * This is a test fixture, not a hot-path component, so it favours clarity over allocation-free
+ * containers.
+ */
+class MatchingEngine {
+public:
+    std::vector<Execution> submit(uint64_t owner_id, const std::string& symbol, const std::string& client_order_id,
+                                  Side side, OrderType type, double price, double quantity) {
+        std::vector<Execution> executions;
+        if (locations_.count(key(owner_id, client_order_id))) {
+            RestingOrder duplicate{0, owner_id, client_order_id, side, price, quantity, 0.0};
+            executions.push_back(report(duplicate, symbol, OrderStatus::Rejected, 0.0, 0.0));
+            return executions;
+        }
+        Book& book = books_[symbol];
+
+        RestingOrder taker{next_order_id_++, owner_id, client_order_id, side, price, quantity, 0.0};
+        executions.push_back(report(taker, symbol, OrderStatus::Acknowledged, 0.0, 0.0));
+
+        if (side == Side::Buy) {
+            match(taker, symbol, book.asks, executions,
+                  [&](double level) { return type == OrderType::Market || level <= price; });
+        } else {
+            match(taker, symbol, book.bids, executions,
+                  [&](double level) { return type == OrderType::Market || level >= price; });
+        }
+
+        if (taker.remaining > 0.0) {
+            if (type == OrderType::Limit) {
+                if (side == Side::Buy) book.bids[price].push_back(taker);
+                else book.asks[price].push_back(taker);
+                locations_[key(owner_id, client_order_id)] = Location{symbol, side, price};
+            } else {
+                executions.push_back(report(taker, symbol, OrderStatus::Canceled, 0.0, 0.0));
+            }
+        }
+        return executions;
+    }
+
+    // Returns the cancel report, or nothing if the order is unknown or already done
+    std::vector<Execution> cancel(uint64_t owner_id, const std::string& client_order_id) {
+        std::vector<Execution> executions;
+        auto loc_it = locations_.find(key(owner_id, client_order_id));
+        if (loc_it == locations_.end()) {
+            return executions;
+        }
+        Location loc = loc_it->second;
+        locations_.erase(loc_it);
+
+        Book& book = books_[loc.symbol];
+        auto erase_from = [&](auto& side_levels) {
+            auto level_it = side_levels.find(loc.price);
+            if (level_it == side_levels.end()) return;
+            auto& queue = level_it->second;
+            auto it = std::find_if(queue.begin(), queue.end(), [&](const RestingOrder& o) {
+                return o.owner_id == owner_id && o.client_order_id == client_order_id;
+            });
+            if (it == queue.end()) return;
+            executions.push_back(report(*it, loc.symbol, OrderStatus::Canceled, 0.0, 0.0));
+            queue.erase(it);
+            if (queue.empty()) side_levels.erase(level_it);
+        };
+        if (loc.side == Side::Buy) erase_from(book.bids);
+        else erase_from(book.asks);
+        return executions;
+    }
+
+    // Drops every resting order of an owner, e.g. when its session disconnects
+    void cancel_all(uint64_t owner_id) {
+        std::vector<std::string> ids;
+        for (const auto& [k, loc] : locations_) {
+            if (k.first == owner_id) ids.push_back(k.second);
+        }
+        for (const auto& id : ids) {
+            cancel(owner_id, id);
+        }
+    }
+
+    std::pair<double, double> best_bid_ask(const std::string& symbol) const {
+        auto it = books_.find(symbol);
+        if (it == books_.end()) return {0.0, 0.0};
+        double bid = it->second.bids.empty() ? 0.0 : it->second.bids.begin()->first;
+        double ask = it->second.asks.empty() ? 0.0 : it->second.asks.begin()->first;
+        return {bid, ask};
+    }
+
+private:
+    struct RestingOrder {
+        uint64_t order_id;
+        uint64_t owner_id;
+        std::string client_order_id;
+        Side side;
+        double price;
+        double remaining;
+        double filled;
+    };
+
+    struct Book {
+        std::map<double, std::deque<RestingOrder>, std::greater<double>> bids;
+        std::map<double, std::deque<RestingOrder>, std::less<double>> asks;
+    };
+
+    struct Location {
+        std::string symbol;
+        Side side;
+        double price;
+    };
+
+    struct KeyHash {
+        size_t operator()(const std::pair<uint64_t, std::string>& k) const noexcept {
+            return std::hash<std::string>{}(k.second) ^ (std::hash<uint64_t>{}(k.first) << 1);
+        }
+    };
+
+    static std::pair<uint64_t, std::string> key(uint64_t owner_id, const std::string& client_order_id) {
+        return {owner_id, client_order_id};
+    }
+
+    Execution report(const RestingOrder& order, const std::string& symbol, OrderStatus status,
+                     double last_quantity, double last_price) const {
+        return Execution{order.order_id, order.owner_id, order.client_order_id, symbol, order.side, status,
+                         order.price, order.remaining + order.filled, last_quantity, last_price, order.filled};
+    }
+
+    template<typename Levels, typename Crosses>
+    void match(RestingOrder& taker, const std::string& symbol, Levels& levels,
+               std::vector<Execution>& executions, Crosses crosses) {
+        while (taker.remaining > 0.0 && !levels.empty() && crosses(levels.begin()->first)) {
+            auto level_it = levels.begin();
+            auto& queue = level_it->second;
+            RestingOrder& maker = queue.front();
+
+            double qty = std::min(taker.remaining, maker.remaining);
+            double px = level_it->first;
+            taker.remaining -= qty;
+            taker.filled += qty;
+            maker.remaining -= qty;
+            maker.filled += qty;
+
+            executions.push_back(report(maker, symbol,
+                maker.remaining > 0.0 ? OrderStatus::PartiallyFilled : OrderStatus::Filled, qty, px));
+            executions.push_back(report(taker, symbol,
+                taker.remaining > 0.0 ? OrderStatus::PartiallyFilled : OrderStatus::Filled, qty, px));
+
+            if (maker.remaining <= 0.0) {
+                locations_.erase(key(maker.owner_id, maker.client_order_id));
+                queue.pop_front();
+                if (queue.empty()) levels.erase(level_it);
+            }
+        }
+    }
+
+    std::unordered_map<std::string, Book> books_;
+    std::unordered_map<std::pair<uint64_t, std::string>, Location, KeyHash> locations_;
+    uint64_t next_order_id_ = 1;
+};
@@ -0,0 +1,96 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "event_bus.hpp"
+#include "event_fan_in.hpp"
+#include "fast_clock.hpp"
+#include "instrument_registry.hpp"
+#include "time_ordered_merger.hpp"
+#include "types.hpp"
+
+/**
+ * @class MergedFeed
+ * @brief One event type from several venues, delivered on a strategy thread in global
+ *        exchange-time order.
+ *
+ * The live path for TimeOrderedMerger: each venue gets its own EventFanIn lane, so every lane
+ * is in that venue's exchange-time order, and poll() drains the lanes into the merger and
+ * emits what the watermark releases. The fan-in copies own nothing but point every string
+ * view at the registry or at static storage, so items stay valid however long the merger
+ * holds them; see EventFanIn for which event types qualify.
+ *
+ * Items are stamped with trace.exchange_time, or the receive time where the venue sent none.
+ * Everything but the constructor runs on the strategy thread.
+ */
+template<typename EventType>
+class MergedFeed {
+public:
+    /**
+     * @param sources One lane per venue, e.g. {"Binance", "Coinbase", "Kraken"}.
+     * @param capacity Fan-in queue and merger ring size per lane.
+     * @param max_delay Longest an event waits for slower venues, in ns.
+     */
+    MergedFeed(std::shared_ptr<EventBus> event_bus, const InstrumentRegistry& registry,
+               const std::vector<std::string>& sources, size_t capacity, int64_t max_delay,
+               MemoryPlacement memory = {})
+        : merger_(sources.size(), capacity, max_delay) {
+        lanes_.reserve(sources.size());
+        for (const auto& source : sources) {
+            lanes_.push_back(std::make_unique<EventFanIn<EventType>>(event_bus, registry, capacity, memory, source));
+        }
+    }
+
+    MergedFeed(const MergedFeed&) = delete;
+    MergedFeed& operator=(const MergedFeed&) = delete;
+
+    /**
+     * @brief Moves every queued event into the merger and emits what is ready at `now`
+     *        (FastClock::now_nanos()), oldest first, as emit(timestamp, event).
+     * @return Number of events emitted.
+     */
+    template<typename Emit>
+    size_t poll(int64_t now, Emit&& emit) {
+        size_t emitted = 0;
+        EventType event;
+        for (size_t lane = 0; lane < lanes_.size(); ++lane) {
+            while (lanes_[lane]->try_pop(event)) {
+                const int64_t timestamp = stamp(event);
+                if (!merger_.push(lane, timestamp, std::move(event))) {
+                    // A full ring forces its oldest item out, which always makes room
+                    emitted += merger_.poll(now, emit);
+                    merger_.push(lane, timestamp, std::move(event));
+                }
+            }
+        }
+        return emitted + merger_.poll(now, emit);
+    }
+
+    // Emits everything pending regardless of the watermark, e.g. at shutdown
+    template<typename Emit>
+    size_t flush(Emit&& emit) {
+        size_t emitted = poll(FastClock::now_nanos(), emit);
+        return emitted + merger_.flush(emit);
+    }
+
+    const TimeOrderedMerger<EventType>& merger() const { return merger_; }
+    const EventFanIn<EventType>& lane(size_t index) const { return *lanes_[index]; }
+
+    // Events lost to a full fan-in queue, over every lane
+    uint64_t dropped() const {
+        uint64_t total = 0;
+        for (const auto& lane : lanes_) total += lane->dropped();
+        return total;
+    }
+
+private:
+    static int64_t stamp(const EventType& event) {
+        const TraceRecord& trace = event.data.trace;
+        return trace.exchange_time > 0 ? trace.exchange_time : FastClock::to_epoch_nanos(trace.socket_rx);
+    }
+
+    std::vector<std::unique_ptr<EventFanIn<EventType>>> lanes_;
+    TimeOrderedMerger<EventType> merger_;
+};
@@ -0,0 +1,95 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <vector>
+#include "placed_allocator.hpp"
+#include "spsc_queue.hpp"
+
+/**
+ * @class MPSCQueue
+ * @brief Bounded lock-free queue for many producer threads and one consumer.
+ *
+ * Dmitry Vyukov's array queue: every cell carries a sequence number that says whose turn it
+ * is. A producer claims a position with one CAS on the tail and then owns that cell until it
+ * publishes it by bumping the sequence, so producers never wait on each other's copies. The
+ * single consumer needs no CAS at all. try_push fails only when the queue is full, never
+ * because of contention; a producer that loses the CAS simply retries with the new tail.
+ *
+ * Order is the order in which producers won the CAS, i.e. arrival order across threads.
+ */
+template<typename T>
+class MPSCQueue {
+public:
+    // Rounded up to a power of two; memory as for SPSCQueue
+    explicit MPSCQueue(size_t capacity, MemoryPlacement memory = {})
+        : capacity_(next_power_of_2(capacity < 2 ? 2 : capacity)), mask_(capacity_ - 1),
+          cells_(capacity_, PlacedAllocator<Cell>(memory)) {
+        for (size_t i = 0; i < capacity_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    // Any thread
+    bool try_push(T&& value) {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            const size_t seq = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                // Cell is free for this lap; claim it
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+                // Lost the race, pos now holds the current tail
+            } else if (diff < 0) {
+                return false; // Full: the consumer has not freed this cell from the last lap
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer thread only
+    bool try_pop(T& value) {
+        Cell& cell = cells_[head_ & mask_];
+        const size_t seq = cell.sequence.load(std::memory_order_acquire);
+        if (seq != head_ + 1) {
+            return false; // Empty, or the producer that claimed it has not finished writing
+        }
+        value = std::move(cell.value);
+        // Free the cell for the lap after this one
+        cell.sequence.store(head_ + capacity_, std::memory_order_release);
+        ++head_;
+        return true;
+    }
+
+    size_t capacity() const { return capacity_; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        T value{};
+    };
+
+    static size_t next_power_of_2(size_t n) {
+        size_t p = 1;
+        while (p < n) {
+            p <<= 1;
+        }
+        return p;
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::vector<Cell, PlacedAllocator<Cell>> cells_;
+
+    // Align to prevent false sharing between the producers' tail and the consumer's head
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+    alignas(CACHE_LINE_SIZE) size_t head_ = 0;
+};
@@ -0,0 +1,143 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/ssl/context.hpp>
+#include "feed_arbiter.hpp"
+#include "feed_supervisor.hpp"
+#include "socket_tuning.hpp"
+#include "spsc_queue.hpp"
+#include "types.hpp"
+#include "utils.hpp"
+
+/**
+ * @struct VenueProtocol
+ * @brief How a venue takes subscriptions and how many streams a single connection may carry.
+ *
+ * A "stream" is whatever the venue subscribes by: a Binance stream name ("btcusdt@depth@100ms"),
+ * a Coinbase product ID or a Kraken symbol. Limits are public so a deployment can tighten them.
+ */
+struct VenueProtocol {
+    std::string name;
+    std::string host;
+    std::string port;
+    std::string target;
+    size_t max_streams_per_connection = 0;
+    size_t max_connections = 0;
+    // Builds the message sent right after the handshake for one connection's shard
+    std::function<std::string(const std::vector<std::string>&)> make_subscription;
+    // Undoes make_subscription. Set for venues whose books have no sequence numbers: after a Gap
+    // the shard is unsubscribed and subscribed again, and the venue answers with a fresh snapshot
+    std::function<std::string(const std::vector<std::string>&)> make_unsubscription;
+    // Identity of a message across redundant connections, see FeedArbiter
+    DedupKeyFn dedup_key = nullptr;
+
+    static VenueProtocol binance();
+    static VenueProtocol coinbase(const std::vector<std::string>& channels);
+    static VenueProtocol kraken(const std::string& channel);
+};
+
+/**
+ * @class MultiStreamConnector
+ * @brief Many WebSocket connections to one venue, all driven by a single io_context thread.
+ *
+ * Streams are sharded evenly over the fewest connections the venue's per-connection limit
+ * allows. Every connection runs on the same thread, so they can share one SPSCQueue (a single
+ * producer) or each feed their own: shard i pushes to queues[i % queues.size()].
+ * RawMessage::connection records which connection received a frame. Frames are read, and
+ * inflated when the venue accepts permessage-deflate, straight into their payload, as in the
+ * single-socket exchanges.
+ *
+ * Every connection has its own FeedSupervisor, as the single-socket exchanges do: an error or a
+ * stale feed tears that connection down and reconnects it with backoff, resending its shard's
+ * subscription, and each transition reaches the shard's queue as a FeedStatusEvent marker
+ * stamped with the connection index. After a Gap the connection resubscribes its shard in place
+ * when the venue defines make_unsubscription.
+ *
+ * With set_redundancy(copies) every shard is opened `copies` times, optionally each copy from a
+ * different local interface, and a FeedArbiter passes on only the first copy of each message.
+ * A stall on one route then costs nothing as long as another copy keeps flowing. Copies of a
+ * shard share its queue, so per-connection queues become per-shard queues, and share its status:
+ * Connected when the first copy is up, Disconnected or Stale only when the last goes down.
+ */
+class MultiStreamConnector {
+public:
+    MultiStreamConnector(VenueProtocol protocol, std::vector<SPSCQueue<RawMessage>*> queues);
+    ~MultiStreamConnector();
+
+    MultiStreamConnector(const MultiStreamConnector&) = delete;
+    MultiStreamConnector& operator=(const MultiStreamConnector&) = delete;
+
+    /**
+     * @brief Opens every shard `copies` times and arbitrates between them. Call before initialize().
+     * @param local_addresses Source IPs to bind, copy i uses local_addresses[i % size]; empty
+     *        leaves the choice to the routing table.
+     */
+    void set_redundancy(size_t copies, std::vector<std::string> local_addresses = {});
+
+    // Applied to every connection once TCP is up. Call before start()
+    void set_socket_tuning(const SocketTuning& tuning) { socket_tuning_ = tuning; }
+    // Backoff and failure detection for every connection. Call before initialize()
+    void set_reconnect_policy(const ReconnectPolicy& policy) { reconnect_policy_ = policy; }
+    // Offer permessage-deflate on every connection (on by default). Call before start()
+    void set_compression(bool enabled) { compression_ = enabled; }
+
+    // Returns false if the streams need more connections than the venue allows
+    bool initialize(const std::vector<std::string>& streams);
+
+    // Runs all connections on one thread, placed as given
+    void start(const ThreadPlacement& placement = {});
+    void stop();
+
+    size_t connection_count() const { return connections_.size(); }
+    size_t shard_count() const { return shards_.size(); }
+    size_t copies() const { return copies_; }
+    const std::vector<std::string>& shard(size_t index) const { return shards_[index]; }
+    // Null unless redundancy is enabled
+    const FeedArbiter* arbiter() const { return arbiter_.get(); }
+    size_t open_connections() const { return open_connections_.load(std::memory_order_relaxed); }
+    uint64_t received_messages() const { return received_messages_.load(std::memory_order_relaxed); }
+    uint64_t dropped_messages() const { return dropped_messages_.load(std::memory_order_relaxed); }
+    const VenueProtocol& protocol() const { return protocol_; }
+
+    // Round-robin split into ceil(n / max_per_connection) shards of near-equal size
+    static std::vector<std::vector<std::string>> shard_streams(const std::vector<std::string>& streams,
+                                                               size_t max_per_connection);
+
+private:
+    class Connection;
+
+    void on_message(FeedSupervisor& supervisor, RawMessage&& message);
+    void on_connection_closed();
+
+    VenueProtocol protocol_;
+    std::vector<SPSCQueue<RawMessage>*> queues_;
+    std::vector<std::vector<std::string>> shards_;
+    size_t copies_ = 1;
+    std::vector<std::string> local_addresses_;
+    std::unique_ptr<FeedArbiter> arbiter_;
+    SocketTuning socket_tuning_;
+    ReconnectPolicy reconnect_policy_;
+    bool compression_ = true;
+
+    boost::asio::io_context ioc_;
+    boost::asio::ssl::context ssl_ctx_;
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work_guard_;
+    boost::asio::steady_timer stop_timer_;
+    std::vector<std::shared_ptr<Connection>> connections_;
+    std::vector<uint32_t> shard_up_; // Copies of each shard currently connected, I/O thread only
+    std::thread thread_;
+    bool running_ = false;
+    bool stopping_ = false; // I/O thread only
+
+    // Written by the I/O thread only
+    std::atomic<size_t> open_connections_{0};
+    std::atomic<uint64_t> received_messages_{0};
+    std::atomic<uint64_t> dropped_messages_{0};
+};
@@ -0,0 +1,53 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "placed_allocator.hpp"
+
+/**
+ * @class ObjectPool
+ * @brief Fixed-capacity slab of preallocated objects handed out by index.
+ *
+ * All storage is allocated up front; acquire/release only move an index on a free list,
+ * so the hot path never touches the heap. Not thread-safe, each pool has a single owner thread;
+ * pass a MemoryPlacement on that thread's NUMA node to keep the slab local to it.
+ */
+template<typename T>
+class ObjectPool {
+public:
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    explicit ObjectPool(size_t capacity, MemoryPlacement memory = {})
+        : slots_(capacity, PlacedAllocator<T>(memory)), free_list_(PlacedAllocator<uint32_t>(memory)) {
+        free_list_.reserve(capacity);
+        // Push in reverse so the first acquires hand out the lowest indices
+        for (size_t i = capacity; i > 0; --i) {
+            free_list_.push_back(static_cast<uint32_t>(i - 1));
+        }
+    }
+
+    // Returns INVALID_INDEX when the pool is exhausted
+    uint32_t acquire() {
+        if (free_list_.empty()) {
+            return INVALID_INDEX;
+        }
+        uint32_t index = free_list_.back();
+        free_list_.pop_back();
+        return index;
+    }
+
+    void release(uint32_t index) {
+        slots_[index] = T{};
+        free_list_.push_back(index);
+    }
+
+    T& operator[](uint32_t index) { return slots_[index]; }
+    const T& operator[](uint32_t index) const { return slots_[index]; }
+
+    size_t capacity() const { return slots_.size(); }
+    size_t available() const { return free_list_.size(); }
+
+private:
+    std::vector<T, PlacedAllocator<T>> slots_;
+    std::vector<uint32_t, PlacedAllocator<uint32_t>> free_list_;
+};
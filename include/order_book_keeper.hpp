@@ -0,0 +1,259 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <cstdint>
+#include <cmath>
+#include "types.hpp"
+#include "event_bus.hpp"
+#include "object_pool.hpp"
+#include "order_id_map.hpp"
+
+struct OrderRecord {
+    uint64_t client_order_id = 0;
+    uint64_t exchange_order_id = 0;
+    uint32_t instrument_id = 0;
+    OrderStatus status = OrderStatus::New;
+    Side side = Side::Buy;
+    OrderType type = OrderType::Limit;
+    double price = 0.0;
+    double quantity = 0.0;
+    double filled_quantity = 0.0;
+    double avg_fill_price = 0.0;
+    int64_t created_time = 0;
+    int64_t last_update_time = 0;
+    std::string_view source;
+    std::string_view symbol;
+};
+
+struct PositionRecord {
+    double position = 0.0;
+    double avg_entry_price = 0.0;
+    double realized_pnl = 0.0;
+};
+
+/**
+ * @class OrderBookKeeper
+ * @brief OMS store tracking each order's lifecycle, positions and PnL.
+ *
+ * Order records come from a preallocated ObjectPool and are indexed by client order ID in an
+ * open-addressing OrderIdMap, so tracking an order never allocates. Positions and realized PnL
+ * are updated incrementally on each fill using average-cost accounting. Every state change is
+ * published as an OrderUpdateEvent, fills additionally as a FillEvent.
+ *
+ * Records are released as soon as the order reaches a terminal state (Filled, Canceled,
+ * Rejected), except that an order filled before its ack is kept until the ack records its
+ * exchange order ID. Single-threaded: drive it from the thread that handles execution reports,
+ * and give it a MemoryPlacement on that thread's NUMA node so the pool, index and positions
+ * live there.
+ *
+ * Every on_* call publishes on the EventBus, which holds its lock while handlers run and is not
+ * reentrant. Never call them from inside a bus handler; that deadlocks. Feed execution reports
+ * from the router's own thread, or collect them with an EventFanIn and drain it there.
+ */
+class OrderBookKeeper {
+public:
+    OrderBookKeeper(std::shared_ptr<EventBus> event_bus, size_t max_open_orders, size_t max_instruments,
+                    MemoryPlacement memory = {})
+        : event_bus_{std::move(event_bus)}, pool_(max_open_orders, memory), index_(max_open_orders, memory),
+          positions_(max_instruments, PlacedAllocator<PositionRecord>(memory)) {}
+
+    // Returns false if the ID is already in use or the pool is exhausted
+    bool on_new_order(const OrderRequest& request, int64_t timestamp) {
+        if (request.instrument_id >= positions_.size()) {
+            return false;
+        }
+        uint32_t slot = pool_.acquire();
+        if (slot == ObjectPool<OrderRecord>::INVALID_INDEX) {
+            return false;
+        }
+        if (!index_.insert(request.client_order_id, slot)) {
+            pool_.release(slot);
+            return false;
+        }
+
+        OrderRecord& order = pool_[slot];
+        order.client_order_id = request.client_order_id;
+        order.instrument_id = request.instrument_id;
+        order.status = OrderStatus::New;
+        order.side = request.side;
+        order.type = request.type;
+        order.price = request.price;
+        order.quantity = request.quantity;
+        order.created_time = timestamp;
+        order.last_update_time = timestamp;
+        order.source = request.source;
+        order.symbol = request.symbol;
+
+        publish_update(order);
+        return true;
+    }
+
+    // An ack after fills records the exchange ID but keeps the fill status
+    bool on_ack(uint64_t client_order_id, uint64_t exchange_order_id, int64_t timestamp) {
+        OrderRecord* order = find_mutable(client_order_id);
+        if (!order || !awaiting_ack(*order)) {
+            return false;
+        }
+        order->exchange_order_id = exchange_order_id;
+        if (order->status == OrderStatus::New) {
+            order->status = OrderStatus::Acknowledged;
+        }
+        order->last_update_time = timestamp;
+        publish_update(*order);
+        release_if_terminal(*order);
+        return true;
+    }
+
+    // Fills may arrive before the ack on some venues, so New is a valid starting state
+    bool on_fill(uint64_t client_order_id, double fill_quantity, double fill_price, int64_t timestamp) {
+        OrderRecord* order = find_mutable(client_order_id);
+        if (!order || !is_working(order->status) || fill_quantity <= 0.0) {
+            return false;
+        }
+
+        double new_filled = order->filled_quantity + fill_quantity;
+        order->avg_fill_price = (order->avg_fill_price * order->filled_quantity + fill_price * fill_quantity) / new_filled;
+        order->filled_quantity = new_filled;
+        order->status = new_filled + QUANTITY_EPSILON >= order->quantity ? OrderStatus::Filled : OrderStatus::PartiallyFilled;
+        order->last_update_time = timestamp;
+
+        PositionRecord& pos = positions_[order->instrument_id];
+        apply_fill(pos, order->side == Side::Buy ? fill_quantity : -fill_quantity, fill_price);
+
+        FillEvent fill_event;
+        FillData& fill = fill_event.data;
+        fill.timestamp = timestamp;
+        fill.client_order_id = order->client_order_id;
+        fill.instrument_id = order->instrument_id;
+        fill.side = order->side;
+        fill.price = fill_price;
+        fill.quantity = fill_quantity;
+        fill.position = pos.position;
+        fill.realized_pnl = pos.realized_pnl;
+        fill.source = order->source;
+        fill.symbol = order->symbol;
+        event_bus_->publish(fill_event);
+
+        publish_update(*order);
+        release_if_terminal(*order);
+        return true;
+    }
+
+    bool on_cancel(uint64_t client_order_id, int64_t timestamp) {
+        OrderRecord* order = find_mutable(client_order_id);
+        if (!order || !is_working(order->status)) {
+            return false;
+        }
+        order->status = OrderStatus::Canceled;
+        order->last_update_time = timestamp;
+        publish_update(*order);
+        release_if_terminal(*order);
+        return true;
+    }
+
+    bool on_reject(uint64_t client_order_id, int64_t timestamp) {
+        OrderRecord* order = find_mutable(client_order_id);
+        if (!order || order->status != OrderStatus::New) {
+            return false;
+        }
+        order->status = OrderStatus::Rejected;
+        order->last_update_time = timestamp;
+        publish_update(*order);
+        release_if_terminal(*order);
+        return true;
+    }
+
+    const OrderRecord* find(uint64_t client_order_id) const {
+        uint32_t slot = index_.find(client_order_id);
+        return slot == OrderIdMap::NOT_FOUND ? nullptr : &pool_[slot];
+    }
+
+    const PositionRecord& position(uint32_t instrument_id) const { return positions_[instrument_id]; }
+
+    double unrealized_pnl(uint32_t instrument_id, double mark_price) const {
+        const PositionRecord& pos = positions_[instrument_id];
+        return pos.position * (mark_price - pos.avg_entry_price);
+    }
+
+    size_t open_orders() const { return index_.size(); }
+
+private:
+    static constexpr double QUANTITY_EPSILON = 1e-12;
+
+    static bool is_working(OrderStatus status) {
+        return status == OrderStatus::New || status == OrderStatus::Acknowledged ||
+               status == OrderStatus::PartiallyFilled;
+    }
+
+    // New, or filled (partly or fully) before the venue acked it
+    static bool awaiting_ack(const OrderRecord& order) {
+        return order.status == OrderStatus::New ||
+               (order.exchange_order_id == 0 &&
+                (order.status == OrderStatus::PartiallyFilled || order.status == OrderStatus::Filled));
+    }
+
+    // Average-cost accounting: adding to a position moves the entry price, reducing realizes PnL
+    static void apply_fill(PositionRecord& pos, double signed_qty, double price) {
+        if (pos.position == 0.0 || (pos.position > 0.0) == (signed_qty > 0.0)) {
+            double new_position = pos.position + signed_qty;
+            pos.avg_entry_price = (pos.avg_entry_price * std::fabs(pos.position) + price * std::fabs(signed_qty))
+                / std::fabs(new_position);
+            pos.position = new_position;
+            return;
+        }
+
+        double closing = std::min(std::fabs(signed_qty), std::fabs(pos.position));
+        double direction = pos.position > 0.0 ? 1.0 : -1.0;
+        pos.realized_pnl += closing * (price - pos.avg_entry_price) * direction;
+
+        double new_position = pos.position + signed_qty;
+        if (std::fabs(new_position) < QUANTITY_EPSILON) {
+            pos.position = 0.0;
+            pos.avg_entry_price = 0.0;
+        } else {
+            // Flipped through zero: the remainder opens at the fill price
+            if ((new_position > 0.0) != (pos.position > 0.0)) {
+                pos.avg_entry_price = price;
+            }
+            pos.position = new_position;
+        }
+    }
+
+    OrderRecord* find_mutable(uint64_t client_order_id) {
+        uint32_t slot = index_.find(client_order_id);
+        return slot == OrderIdMap::NOT_FOUND ? nullptr : &pool_[slot];
+    }
+
+    void publish_update(const OrderRecord& order) {
+        OrderUpdateEvent update_event;
+        OrderUpdateData& update = update_event.data;
+        update.timestamp = order.last_update_time;
+        update.client_order_id = order.client_order_id;
+        update.exchange_order_id = order.exchange_order_id;
+        update.instrument_id = order.instrument_id;
+        update.status = order.status;
+        update.side = order.side;
+        update.price = order.price;
+        update.quantity = order.quantity;
+        update.filled_quantity = order.filled_quantity;
+        update.avg_fill_price = order.avg_fill_price;
+        update.source = order.source;
+        update.symbol = order.symbol;
+        event_bus_->publish(update_event);
+    }
+
+    void release_if_terminal(const OrderRecord& order) {
+        if (is_working(order.status) || (order.status == OrderStatus::Filled && awaiting_ack(order))) {
+            return;
+        }
+        uint32_t slot = index_.find(order.client_order_id);
+        index_.erase(order.client_order_id);
+        pool_.release(slot);
+    }
+
+    std::shared_ptr<EventBus> event_bus_;
+    ObjectPool<OrderRecord> pool_;
+    OrderIdMap index_;
+    std::vector<PositionRecord, PlacedAllocator<PositionRecord>> positions_;
+};
@@ -0,0 +1,112 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "placed_allocator.hpp"
+
+/**
+ * @class OrderIdMap
+ * @brief Open-addressing hash map from client order ID to pool index.
+ *
+ * Linear probing over a power-of-two table sized at construction, with backward-shift
+ * deletion so no tombstones build up under order churn. Key 0 marks an empty slot, so
+ * client order IDs must be non-zero.
+ */
+class OrderIdMap {
+public:
+    static constexpr uint32_t NOT_FOUND = UINT32_MAX;
+
+    // Table is kept at most half full for short probe sequences; memory as for ObjectPool
+    explicit OrderIdMap(size_t max_entries, MemoryPlacement memory = {})
+        : capacity_(next_power_of_2(max_entries * 2)), mask_(capacity_ - 1),
+          keys_(capacity_, EMPTY_KEY, PlacedAllocator<uint64_t>(memory)),
+          values_(capacity_, NOT_FOUND, PlacedAllocator<uint32_t>(memory)) {}
+
+    bool insert(uint64_t key, uint32_t value) {
+        if (key == EMPTY_KEY || size_ * 2 >= capacity_) {
+            return false;
+        }
+        size_t i = home_slot(key);
+        while (keys_[i] != EMPTY_KEY) {
+            if (keys_[i] == key) {
+                return false; // Duplicate
+            }
+            i = (i + 1) & mask_;
+        }
+        keys_[i] = key;
+        values_[i] = value;
+        ++size_;
+        return true;
+    }
+
+    uint32_t find(uint64_t key) const {
+        if (key == EMPTY_KEY) {
+            return NOT_FOUND;
+        }
+        size_t i = home_slot(key);
+        while (keys_[i] != EMPTY_KEY) {
+            if (keys_[i] == key) {
+                return values_[i];
+            }
+            i = (i + 1) & mask_;
+        }
+        return NOT_FOUND;
+    }
+
+    bool erase(uint64_t key) {
+        if (key == EMPTY_KEY) {
+            return false;
+        }
+        size_t i = home_slot(key);
+        while (keys_[i] != key) {
+            if (keys_[i] == EMPTY_KEY) {
+                return false;
+            }
+            i = (i + 1) & mask_;
+        }
+
+        // Shift following entries of the same probe chain back into the hole
+        size_t j = i;
+        while (true) {
+            j = (j + 1) & mask_;
+            if (keys_[j] == EMPTY_KEY) {
+                break;
+            }
+            size_t home = home_slot(keys_[j]);
+            bool home_between = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+            if (!home_between) {
+                keys_[i] = keys_[j];
+                values_[i] = values_[j];
+                i = j;
+            }
+        }
+        keys_[i] = EMPTY_KEY;
+        values_[i] = NOT_FOUND;
+        --size_;
+        return true;
+    }
+
+    size_t size() const { return size_; }
+
+private:
+    static constexpr uint64_t EMPTY_KEY = 0;
+
+    // Fibonacci hashing spreads sequential client order IDs across the table
+    size_t home_slot(uint64_t key) const {
+        return static_cast<size_t>((key * 11400714819323198485ull) >> 32) & mask_;
+    }
+
+    static size_t next_power_of_2(size_t n) {
+        size_t p = 1;
+        while (p < n) {
+            p <<= 1;
+        }
+        return p;
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::vector<uint64_t, PlacedAllocator<uint64_t>> keys_;
+    std::vector<uint32_t, PlacedAllocator<uint32_t>> values_;
+    size_t size_ = 0;
+};
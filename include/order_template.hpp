@@ -0,0 +1,128 @@
+#pragma once
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "types.hpp"
+
+/**
+ * @class OrderTemplate
+ * @brief An order-entry message serialized once, with only the per-order fields written per send.
+ *
+ * The template is the venue's complete JSON message with the placeholders {request_id},
+ * {client_order_id}, {price} and {quantity}; everything else (symbol, side, type, time in
+ * force, account fields) is fixed when the template is built. The constructor splits the text
+ * into literal segments once. render() copies the segments and formats the fields with
+ * std::to_chars into a buffer owned by the template, so sending an order builds no JSON and
+ * allocates nothing. Prices and quantities are printed with a fixed number of decimals, which
+ * should match the instrument's tick and lot size.
+ *
+ * The returned view is valid until the next render(); use one template per sending thread.
+ * OutboundQueue::send copies it, so it can be passed straight through.
+ */
+class OrderTemplate {
+public:
+    OrderTemplate(std::string text, int price_decimals = 8, int quantity_decimals = 8)
+        : text_(std::move(text)), price_decimals_(std::clamp(price_decimals, 0, 17)),
+          quantity_decimals_(std::clamp(quantity_decimals, 0, 17)) {
+        size_t literal_start = 0;
+        size_t pos = 0;
+        while ((pos = text_.find('{', pos)) != std::string::npos) {
+            Field field;
+            size_t len;
+            if (!match_placeholder(pos, field, len)) {
+                ++pos; // JSON brace
+                continue;
+            }
+            segments_.push_back({literal_start, pos - literal_start, field});
+            pos += len;
+            literal_start = pos;
+        }
+        segments_.push_back({literal_start, text_.size() - literal_start, Field::None});
+        if (segments_.size() == 1) {
+            throw std::invalid_argument("OrderTemplate has no placeholders: " + text_);
+        }
+        // Literal text plus the widest possible value for every field
+        buffer_.resize(text_.size() + (segments_.size() - 1) * MAX_FIELD_CHARS);
+    }
+
+    std::string_view render(uint64_t request_id, uint64_t client_order_id, double price, double quantity) {
+        char* out = buffer_.data();
+        char* end = out + buffer_.size();
+        for (const Segment& segment : segments_) {
+            memcpy(out, text_.data() + segment.offset, segment.length);
+            out += segment.length;
+            switch (segment.field) {
+            case Field::RequestId:     out = std::to_chars(out, end, request_id).ptr; break;
+            case Field::ClientOrderId: out = std::to_chars(out, end, client_order_id).ptr; break;
+            case Field::Price:         out = std::to_chars(out, end, price, std::chars_format::fixed, price_decimals_).ptr; break;
+            case Field::Quantity:      out = std::to_chars(out, end, quantity, std::chars_format::fixed, quantity_decimals_).ptr; break;
+            case Field::None:          break;
+            }
+        }
+        return std::string_view(buffer_.data(), static_cast<size_t>(out - buffer_.data()));
+    }
+
+    std::string_view render(uint64_t request_id, const OrderRequest& order) {
+        return render(request_id, order.client_order_id, order.price, order.quantity);
+    }
+
+    // Binance WebSocket API order.place, as spoken by tools/exchange_simulator
+    static OrderTemplate binance_place(std::string_view symbol, Side side, OrderType type,
+                                       int price_decimals = 8, int quantity_decimals = 8) {
+        std::string text = "{\"id\":\"{request_id}\",\"method\":\"order.place\",\"params\":{\"symbol\":\"";
+        text += symbol;
+        text += side == Side::Buy ? "\",\"side\":\"BUY\"" : "\",\"side\":\"SELL\"";
+        text += type == OrderType::Limit ? ",\"type\":\"LIMIT\",\"timeInForce\":\"GTC\",\"price\":\"{price}\""
+                                         : ",\"type\":\"MARKET\"";
+        text += ",\"quantity\":\"{quantity}\",\"newClientOrderId\":\"{client_order_id}\"}}";
+        return OrderTemplate(std::move(text), price_decimals, quantity_decimals);
+    }
+
+    static OrderTemplate binance_cancel(std::string_view symbol) {
+        std::string text = "{\"id\":\"{request_id}\",\"method\":\"order.cancel\",\"params\":{\"symbol\":\"";
+        text += symbol;
+        text += "\",\"origClientOrderId\":\"{client_order_id}\"}}";
+        return OrderTemplate(std::move(text));
+    }
+
+private:
+    enum class Field : uint8_t { None, RequestId, ClientOrderId, Price, Quantity };
+
+    struct Segment {
+        size_t offset;
+        size_t length;
+        Field field; // Written after the literal
+    };
+
+    // uint64 needs 20 characters; any fixed-point double with up to 17 decimals fits in 330
+    static constexpr size_t MAX_FIELD_CHARS = 330;
+
+    bool match_placeholder(size_t pos, Field& field, size_t& len) const {
+        static constexpr struct { std::string_view name; Field field; } placeholders[] = {
+            {"{request_id}", Field::RequestId},
+            {"{client_order_id}", Field::ClientOrderId},
+            {"{price}", Field::Price},
+            {"{quantity}", Field::Quantity},
+        };
+        std::string_view rest = std::string_view(text_).substr(pos);
+        for (const auto& p : placeholders) {
+            if (rest.substr(0, p.name.size()) == p.name) {
+                field = p.field;
+                len = p.name.size();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::string text_;
+    int price_decimals_;
+    int quantity_decimals_;
+    std::vector<Segment> segments_;
+    std::vector<char> buffer_;
+};
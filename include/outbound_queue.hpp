@@ -0,0 +1,133 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/dispatch.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/system/error_code.hpp>
+
+/**
+ * @class OutboundQueue
+ * @brief Per-connection write queue: any thread may send, exactly one async_write in flight.
+ *
+ * send() copies the message into a ring of slots allocated up front (a slot only grows if a
+ * message exceeds slot_size), so callers' buffers need not outlive the call and the steady
+ * state send path does not allocate. Small messages queued while a write is in flight are
+ * coalesced into one drain: the completion handler writes the next slot directly, so a burst
+ * costs one hop to the I/O thread rather than one per message. Each message still goes out as
+ * its own WebSocket frame, since the venues parse one JSON document per message.
+ *
+ * attach() once the handshake completes, detach() on teardown. Messages queued for a dead
+ * connection are discarded rather than replayed into the next session (subscriptions are
+ * resent by the exchange, and a stale order must not be sent late); send() on a detached
+ * queue fails and counts as a drop.
+ */
+template <typename Stream>
+class OutboundQueue {
+public:
+    explicit OutboundQueue(boost::asio::io_context& ioc, size_t slots = 256, size_t slot_size = 1024)
+        : ioc_(ioc), slots_(slots) {
+        for (auto& slot : slots_) slot.reserve(slot_size);
+    }
+
+    // Called on the I/O thread with any write error; the exchange's own failure path
+    void set_error_handler(std::function<void(boost::system::error_code)> handler) { on_error_ = std::move(handler); }
+
+    // I/O thread only
+    void attach(Stream& stream) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        reset();
+        stream_ = &stream;
+    }
+
+    // I/O thread only; completions of writes still in flight are ignored
+    void detach() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        reset();
+    }
+
+    // Thread-safe. False if not connected or the ring is full
+    bool send(std::string_view message) {
+        uint64_t generation;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!stream_ || count_ == slots_.size()) {
+                dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return false;
+            }
+            slots_[(head_ + count_) % slots_.size()].assign(message.data(), message.size());
+            ++count_;
+            if (writing_) return true; // The running drain picks it up
+            writing_ = true;
+            generation = generation_;
+        }
+        // Runs inline when already on the I/O thread
+        boost::asio::dispatch(ioc_, [this, generation] { write_next(generation); });
+        return true;
+    }
+
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    size_t pending() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return count_;
+    }
+
+private:
+    void reset() {
+        stream_ = nullptr;
+        ++generation_;
+        head_ = 0;
+        count_ = 0;
+        writing_ = false;
+    }
+
+    // The head slot stays owned by the write until it completes; producers only append behind it
+    void write_next(uint64_t generation) {
+        Stream* stream;
+        const std::string* slot;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (generation != generation_) return;
+            if (count_ == 0) {
+                writing_ = false;
+                return;
+            }
+            stream = stream_;
+            slot = &slots_[head_];
+        }
+        stream->async_write(boost::asio::buffer(*slot),
+            [this, generation](boost::system::error_code ec, std::size_t) { on_write(generation, ec); });
+    }
+
+    void on_write(uint64_t generation, boost::system::error_code ec) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (generation != generation_) return;
+            head_ = (head_ + 1) % slots_.size();
+            --count_;
+            if (ec) writing_ = false;
+        }
+        if (ec) {
+            if (on_error_) on_error_(ec);
+            return;
+        }
+        write_next(generation);
+    }
+
+    boost::asio::io_context& ioc_;
+    mutable std::mutex mutex_;
+    std::vector<std::string> slots_;
+    size_t head_ = 0;
+    size_t count_ = 0;
+    bool writing_ = false;
+    uint64_t generation_ = 0;
+    Stream* stream_ = nullptr;
+    std::function<void(boost::system::error_code)> on_error_;
+    std::atomic<uint64_t> dropped_{0};
+};
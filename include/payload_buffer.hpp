@@ -0,0 +1,64 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <boost/asio/buffer.hpp>
+
+/**
+ * @class PayloadBuffer
+ * @brief Beast DynamicBuffer that reads each WebSocket message straight into a RawMessage payload.
+ *
+ * Beast writes received bytes into the space returned by prepare(), and with permessage-deflate
+ * that is where the inflater writes too. Reading into this buffer instead of a flat_buffer means
+ * a compressed frame is decompressed directly into the string the parser consumes, and take()
+ * hands that string over without the copy buffers_to_string would make. Each message starts
+ * with the previous one's size reserved, so a message costs the single allocation its payload
+ * string needs anyway.
+ */
+class PayloadBuffer {
+public:
+    using const_buffers_type = boost::asio::const_buffer;
+    using mutable_buffers_type = boost::asio::mutable_buffer;
+
+    explicit PayloadBuffer(size_t max_size = 64 * 1024 * 1024) : max_size_(max_size) {}
+
+    size_t size() const { return size_; }
+    size_t max_size() const { return max_size_; }
+    size_t capacity() const { return data_.capacity(); }
+    const_buffers_type data() const { return {data_.data(), size_}; }
+
+    mutable_buffers_type prepare(size_t n) {
+        if (n > max_size_ - size_) throw std::length_error("PayloadBuffer: message exceeds max_size");
+        data_.resize(size_ + n);
+        return {data_.data() + size_, n};
+    }
+
+    void commit(size_t n) { size_ += std::min(n, data_.size() - size_); }
+
+    void consume(size_t n) {
+        n = std::min(n, size_);
+        data_.erase(0, n);
+        size_ -= n;
+    }
+
+    // The message read so far; the buffer starts empty for the next one
+    std::string take() {
+        data_.resize(size_);
+        std::string message = std::move(data_);
+        data_ = std::string();
+        data_.reserve(message.size());
+        size_ = 0;
+        return message;
+    }
+
+    void clear() {
+        data_.clear();
+        size_ = 0;
+    }
+
+private:
+    std::string data_; // May run past size_ with space prepared but not yet committed
+    size_t size_ = 0;
+    size_t max_size_;
+};
@@ -0,0 +1,262 @@
+#pragma once
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <new>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "utils.hpp"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#endif
+#endif
+
+/**
+ * @brief The NUMA node a CPU belongs to, from /sys/devices/system/cpu/cpu<N>/node<M>.
+ * @return -1 if unknown (no NUMA information, or not Linux).
+ */
+inline int numa_node_of_cpu(int cpu) {
+    if (cpu < 0) return -1;
+    std::error_code ec;
+    std::filesystem::directory_iterator it("/sys/devices/system/cpu/cpu" + std::to_string(cpu), ec);
+    for (; !ec && it != std::filesystem::directory_iterator(); it.increment(ec)) {
+        const std::string name = it->path().filename().string();
+        if (name.size() > 4 && name.compare(0, 4, "node") == 0) {
+            try {
+                return std::stoi(name.substr(4));
+            } catch (const std::exception&) {
+                return -1;
+            }
+        }
+    }
+    return -1;
+}
+
+// The node a placement puts its thread on; -1 when unplaced or unknown
+inline int numa_node_of(const ThreadPlacement& placement) {
+    if (placement.cpu >= 0) return numa_node_of_cpu(placement.cpu);
+    return placement.numa_node;
+}
+
+/**
+ * @struct MemoryPlacement
+ * @brief Where PlacedAllocator puts its memory.
+ *
+ * numa_node binds the pages to a node, -1 leaves them to first touch. huge_pages backs
+ * allocations of at least half a huge page with 2MB pages: explicit MAP_HUGETLB pages when
+ * the hugetlb pool has them (vm.nr_hugepages), transparent huge pages via madvise otherwise.
+ * On Windows large pages need the "Lock pages in memory" privilege and fall back to normal pages.
+ */
+struct MemoryPlacement {
+    int numa_node = -1;
+    bool huge_pages = false;
+
+    bool placed() const { return numa_node >= 0 || huge_pages; }
+};
+
+/**
+ * @class PlacedAllocator
+ * @brief Standard allocator for the large, long-lived buffers on the hot path.
+ *
+ * With a placement, every allocation is its own mapping: bound to the NUMA node before any
+ * page is touched (mbind on Linux, VirtualAllocExNuma on Windows), backed by huge pages if
+ * asked, and prefaulted before it is returned. Pages then land on the node no matter which
+ * thread constructs the container, and a queue or pool built at startup takes no page faults
+ * once the feeds are running. Without a placement it is plain operator new.
+ *
+ * Meant for queue rings, pools and tables sized once at startup; the page rounding makes it
+ * wasteful for small or frequent allocations. A failed bind is reported and the memory kept
+ * under the kernel's default policy.
+ */
+template<typename T>
+class PlacedAllocator {
+public:
+    using value_type = T;
+    using is_always_equal = std::false_type;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    PlacedAllocator() noexcept = default;
+    explicit PlacedAllocator(MemoryPlacement placement) noexcept : placement_(placement) {}
+    template<typename U>
+    PlacedAllocator(const PlacedAllocator<U>& other) noexcept : placement_(other.placement()) {}
+
+    const MemoryPlacement& placement() const noexcept { return placement_; }
+
+    T* allocate(size_t n) {
+        const size_t bytes = n * sizeof(T);
+        if (!placement_.placed()) {
+            return static_cast<T*>(::operator new(bytes, std::align_val_t{alignof(T)}));
+        }
+        void* p = map(bytes);
+        prefault(p, mapped_size(bytes));
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        if (!placement_.placed()) {
+            ::operator delete(p, std::align_val_t{alignof(T)});
+            return;
+        }
+#ifdef _WIN32
+        (void)n;
+        VirtualFree(p, 0, MEM_RELEASE);
+#else
+        munmap(p, mapped_size(n * sizeof(T)));
+#endif
+    }
+
+    template<typename U>
+    bool operator==(const PlacedAllocator<U>& other) const noexcept {
+        return placement_.numa_node == other.placement().numa_node && placement_.huge_pages == other.placement().huge_pages;
+    }
+    template<typename U>
+    bool operator!=(const PlacedAllocator<U>& other) const noexcept { return !(*this == other); }
+
+private:
+    bool use_huge_pages(size_t bytes) const { return placement_.huge_pages && bytes >= HUGE_PAGE_SIZE / 2; }
+
+#ifdef _WIN32
+    size_t mapped_size(size_t bytes) const { return bytes; }
+
+    void* map(size_t bytes) const {
+        DWORD node = placement_.numa_node >= 0 ? static_cast<DWORD>(placement_.numa_node) : NUMA_NO_PREFERRED_NODE;
+        if (use_huge_pages(bytes)) {
+            size_t large = GetLargePageMinimum();
+            if (large > 0) {
+                size_t rounded = (bytes + large - 1) / large * large;
+                if (void* p = VirtualAllocExNuma(GetCurrentProcess(), nullptr, rounded, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES,
+                                                 PAGE_READWRITE, node)) {
+                    return p;
+                }
+            }
+        }
+        void* p = VirtualAllocExNuma(GetCurrentProcess(), nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE, node);
+        if (!p) throw std::bad_alloc();
+        return p;
+    }
+
+    // Committed memory is zero-filled on first touch; write a byte per page to take the faults now
+    static void prefault(void* p, size_t bytes) {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        auto* c = static_cast<volatile char*>(p);
+        for (size_t off = 0; off < bytes; off += info.dwPageSize) c[off] = 0;
+    }
+#else
+    size_t mapped_size(size_t bytes) const {
+        static const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        const size_t unit = use_huge_pages(bytes) ? HUGE_PAGE_SIZE : page;
+        return (bytes + unit - 1) / unit * unit;
+    }
+
+    void* map(size_t bytes) const {
+        const size_t size = mapped_size(bytes);
+        void* p = MAP_FAILED;
+#ifdef __linux__
+        if (use_huge_pages(bytes)) {
+            p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (p == MAP_FAILED) p = map_transparent_huge(size);
+        }
+#endif
+        if (p == MAP_FAILED) p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) throw std::bad_alloc();
+        bind(p, size);
+        return p;
+    }
+
+#ifdef __linux__
+    // THP only collapses 2MB-aligned ranges: over-map by one huge page and trim both ends
+    static void* map_transparent_huge(size_t size) {
+        void* raw = mmap(nullptr, size + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) return MAP_FAILED;
+        auto base = reinterpret_cast<uintptr_t>(raw);
+        uintptr_t aligned = (base + HUGE_PAGE_SIZE - 1) & ~(uintptr_t{HUGE_PAGE_SIZE} - 1);
+        if (aligned > base) munmap(raw, aligned - base);
+        size_t tail = base + size + HUGE_PAGE_SIZE - (aligned + size);
+        if (tail > 0) munmap(reinterpret_cast<void*>(aligned + size), tail);
+        void* p = reinterpret_cast<void*>(aligned);
+        if (madvise(p, size, MADV_HUGEPAGE) != 0) {
+            std::cerr << "Error: Transparent huge pages unavailable. Errno: " << errno << std::endl;
+        }
+        return p;
+    }
+#endif
+
+    void bind(void* p, size_t bytes) const {
+        if (placement_.numa_node < 0) return;
+#ifdef __linux__
+        // Preferred rather than strict bind: a full node spills over instead of failing the allocation
+        constexpr size_t BITS = 8 * sizeof(unsigned long);
+        unsigned long mask[4] = {};
+        if (static_cast<size_t>(placement_.numa_node) >= BITS * 4) {
+            std::cerr << "Error: NUMA node " << placement_.numa_node << " out of range" << std::endl;
+            return;
+        }
+        mask[placement_.numa_node / BITS] = 1UL << (placement_.numa_node % BITS);
+        if (syscall(SYS_mbind, p, bytes, MPOL_PREFERRED, mask, BITS * 4, 0) != 0) {
+            std::cerr << "Error: Failed to bind memory to NUMA node " << placement_.numa_node << ". Errno: " << errno << std::endl;
+        }
+#else
+        (void)p;
+        (void)bytes;
+#endif
+    }
+
+    // Fault every page in now, under the binding just set, rather than on the hot path
+    static void prefault(void* p, size_t bytes) {
+#if defined(__linux__) && defined(MADV_POPULATE_WRITE)
+        if (madvise(p, bytes, MADV_POPULATE_WRITE) == 0) return;
+#endif
+        static const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        auto* c = static_cast<volatile char*>(p);
+        for (size_t off = 0; off < bytes; off += page) c[off] = 0;
+    }
+#endif
+
+    MemoryPlacement placement_;
+};
+
+/**
+ * @brief Runs make() on a short-lived thread with the given placement and returns its result.
+ *
+ * The alternative to PlacedAllocator for state that allocates through std::allocator or lives
+ * inline in an object: Linux places a page on the node of the thread that first touches it,
+ * so building the object from a thread on the owner's node puts it there. Unplaced runs inline.
+ */
+template<typename F>
+auto construct_on(const ThreadPlacement& placement, F&& make) -> decltype(make()) {
+    if (!placement.pinned()) return make();
+    std::optional<decltype(make())> result;
+    std::exception_ptr error;
+    std::atomic<bool> placed{false};
+    std::thread builder([&] {
+        // Touch nothing until the affinity is in place
+        while (!placed.load(std::memory_order_acquire)) std::this_thread::yield();
+        try {
+            result.emplace(make());
+        } catch (...) {
+            error = std::current_exception();
+        }
+    });
+    pin_thread(builder, placement);
+    placed.store(true, std::memory_order_release);
+    builder.join();
+    if (error) std::rethrow_exception(error);
+    return std::move(*result);
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <iostream>
+#include "iexcecution_router.hpp"
+#include "risk_engine.hpp"
+#include "fast_clock.hpp"
+
+/**
+ * @class RiskCheckedRouter
+ * @brief Execution router decorator that runs pre-trade risk checks before forwarding orders.
+ *
+ * Strategies hold this router instead of the venue router, so no order reaches an exchange
+ * without passing RiskEngine::check. Rejections are counted; a strategy that keeps hitting a
+ * limit would otherwise write a line per order, so only the first and every 10000th is logged.
+ */
+class RiskCheckedRouter : public IExcecutionRouter {
+public:
+    RiskCheckedRouter(RiskEngine& risk_engine, std::shared_ptr<IExcecutionRouter> downstream)
+        : risk_engine_{risk_engine}, downstream_{std::move(downstream)} {}
+
+    bool send_order(const OrderRequest& order) override {
+        RiskCheckResult result = risk_engine_.check(order, FastClock::now_nanos());
+        if (result != RiskCheckResult::Accepted) {
+            uint64_t rejected = rejected_orders_.fetch_add(1, std::memory_order_relaxed) + 1;
+            if (rejected % 10000 == 1) {
+                std::cerr << "Order " << order.client_order_id << " rejected by risk: " << to_string(result) << " ("
+                          << rejected << " rejected)\n";
+            }
+            return false;
+        }
+        return downstream_->send_order(order);
+    }
+
+    // Cancels only reduce risk, so they are never blocked
+    bool cancel_order(uint64_t client_order_id) override {
+        return downstream_->cancel_order(client_order_id);
+    }
+
+    uint64_t rejected_orders() const { return rejected_orders_.load(std::memory_order_relaxed); }
+
+private:
+    RiskEngine& risk_engine_;
+    std::shared_ptr<IExcecutionRouter> downstream_;
+    std::atomic<uint64_t> rejected_orders_{0};
+};
@@ -0,0 +1,192 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cmath>
+#include <memory>
+#include "types.hpp"
+#include "spsc_queue.hpp"
+#include "event_bus.hpp"
+#include "instrument_registry.hpp"
+
+enum class RiskCheckResult : uint8_t {
+    Accepted,
+    KillSwitchActive,
+    UnknownInstrument,
+    NoReferencePrice,
+    FatFingerPrice,
+    MaxPositionExceeded,
+    MaxNotionalExceeded,
+    OrderRateExceeded
+};
+
+inline const char* to_string(RiskCheckResult result) {
+    switch (result) {
+        case RiskCheckResult::Accepted: return "Accepted";
+        case RiskCheckResult::KillSwitchActive: return "KillSwitchActive";
+        case RiskCheckResult::UnknownInstrument: return "UnknownInstrument";
+        case RiskCheckResult::NoReferencePrice: return "NoReferencePrice";
+        case RiskCheckResult::FatFingerPrice: return "FatFingerPrice";
+        case RiskCheckResult::MaxPositionExceeded: return "MaxPositionExceeded";
+        case RiskCheckResult::MaxNotionalExceeded: return "MaxNotionalExceeded";
+        case RiskCheckResult::OrderRateExceeded: return "OrderRateExceeded";
+    }
+    return "Unknown";
+}
+
+struct RiskLimits {
+    double max_position = 0.0;           // Max absolute position in base units
+    double max_notional = 0.0;           // Max absolute position value in quote units
+    double max_price_deviation = 0.05;   // Max distance from reference price as a fraction
+    uint32_t max_orders_per_window = 0;
+    int64_t order_window_ns = 1'000'000'000;
+};
+
+/**
+ * @class RiskEngine
+ * @brief Pre-trade risk checks with constant-time, lock-free lookups.
+ *
+ * All state lives in flat arrays indexed by instrument ID (see InstrumentRegistry). Each array
+ * is written by a different thread (order path, market data, fills), so they are split onto
+ * separate cache lines to avoid false sharing. A check is a few relaxed loads and compares.
+ *
+ * The engine is ~200KB, allocate it on the heap.
+ */
+class RiskEngine {
+public:
+    static constexpr size_t MAX_INSTRUMENTS = 1024;
+
+    void set_limits(uint32_t instrument_id, const RiskLimits& limits) {
+        if (instrument_id >= MAX_INSTRUMENTS) return;
+        LimitState& ls = limits_[instrument_id];
+        ls.max_position.store(limits.max_position, std::memory_order_relaxed);
+        ls.max_notional.store(limits.max_notional, std::memory_order_relaxed);
+        ls.max_price_deviation.store(limits.max_price_deviation, std::memory_order_relaxed);
+        ls.max_orders_per_window.store(limits.max_orders_per_window, std::memory_order_relaxed);
+        ls.order_window_ns.store(limits.order_window_ns, std::memory_order_relaxed);
+        ls.window_start.store(0, std::memory_order_relaxed);
+        ls.window_count.store(0, std::memory_order_relaxed);
+        ls.enabled.store(true, std::memory_order_release);
+    }
+
+    void update_reference_price(uint32_t instrument_id, double best_bid, double best_ask) {
+        if (instrument_id >= MAX_INSTRUMENTS) return;
+        MarketState& ms = market_[instrument_id];
+        ms.best_bid.store(best_bid, std::memory_order_relaxed);
+        ms.best_ask.store(best_ask, std::memory_order_relaxed);
+    }
+
+    void on_fill(uint32_t instrument_id, Side side, double quantity) {
+        if (instrument_id >= MAX_INSTRUMENTS) return;
+        double signed_qty = side == Side::Buy ? quantity : -quantity;
+        positions_[instrument_id].position.fetch_add(signed_qty, std::memory_order_relaxed);
+    }
+
+    void set_position(uint32_t instrument_id, double position) {
+        if (instrument_id >= MAX_INSTRUMENTS) return;
+        positions_[instrument_id].position.store(position, std::memory_order_relaxed);
+    }
+
+    double position(uint32_t instrument_id) const {
+        if (instrument_id >= MAX_INSTRUMENTS) return 0.0;
+        return positions_[instrument_id].position.load(std::memory_order_relaxed);
+    }
+
+    void activate_kill_switch() { kill_switch_.store(true, std::memory_order_release); }
+    void reset_kill_switch() { kill_switch_.store(false, std::memory_order_release); }
+    bool kill_switch_active() const { return kill_switch_.load(std::memory_order_acquire); }
+
+    // Rate is checked last so orders rejected for other reasons don't use up the budget
+    RiskCheckResult check(const OrderRequest& order, int64_t now_ns) {
+        if (kill_switch_.load(std::memory_order_acquire)) {
+            return RiskCheckResult::KillSwitchActive;
+        }
+        if (order.instrument_id >= MAX_INSTRUMENTS) {
+            return RiskCheckResult::UnknownInstrument;
+        }
+
+        LimitState& ls = limits_[order.instrument_id];
+        if (!ls.enabled.load(std::memory_order_acquire)) {
+            return RiskCheckResult::UnknownInstrument;
+        }
+
+        const MarketState& ms = market_[order.instrument_id];
+        const double reference = order.side == Side::Buy
+            ? ms.best_ask.load(std::memory_order_relaxed)
+            : ms.best_bid.load(std::memory_order_relaxed);
+        if (reference <= 0.0) {
+            return RiskCheckResult::NoReferencePrice;
+        }
+
+        double price = reference;
+        if (order.type == OrderType::Limit) {
+            price = order.price;
+            double deviation = std::fabs(price - reference) / reference;
+            if (deviation > ls.max_price_deviation.load(std::memory_order_relaxed)) {
+                return RiskCheckResult::FatFingerPrice;
+            }
+        }
+
+        double signed_qty = order.side == Side::Buy ? order.quantity : -order.quantity;
+        double projected = positions_[order.instrument_id].position.load(std::memory_order_relaxed) + signed_qty;
+        if (std::fabs(projected) > ls.max_position.load(std::memory_order_relaxed)) {
+            return RiskCheckResult::MaxPositionExceeded;
+        }
+        if (std::fabs(projected) * price > ls.max_notional.load(std::memory_order_relaxed)) {
+            return RiskCheckResult::MaxNotionalExceeded;
+        }
+
+        // Fixed window counter; a race at the window boundary can let one extra order through
+        if (now_ns - ls.window_start.load(std::memory_order_relaxed) >= ls.order_window_ns.load(std::memory_order_relaxed)) {
+            ls.window_start.store(now_ns, std::memory_order_relaxed);
+            ls.window_count.store(0, std::memory_order_relaxed);
+        }
+        if (ls.window_count.fetch_add(1, std::memory_order_relaxed) >= ls.max_orders_per_window.load(std::memory_order_relaxed)) {
+            return RiskCheckResult::OrderRateExceeded;
+        }
+
+        return RiskCheckResult::Accepted;
+    }
+
+    // Keeps reference prices current from ticker updates and positions from OMS fills
+    void subscribe_to_bus(std::shared_ptr<EventBus> event_bus, const InstrumentRegistry& registry) {
+        event_bus->subscribe<TickerDataEvent>([this, &registry](const TickerDataEvent& e) {
+            uint32_t id = registry.find(e.data.source, e.data.symbol);
+            if (id != InstrumentRegistry::INVALID_INSTRUMENT) {
+                update_reference_price(id, e.data.best_bid, e.data.best_ask);
+            }
+        });
+        event_bus->subscribe<FillEvent>([this](const FillEvent& e) {
+            on_fill(e.data.instrument_id, e.data.side, e.data.quantity);
+        });
+    }
+
+private:
+    // Written by config and the order path
+    struct alignas(CACHE_LINE_SIZE) LimitState {
+        std::atomic<double> max_position{0.0};
+        std::atomic<double> max_notional{0.0};
+        std::atomic<double> max_price_deviation{0.0};
+        std::atomic<int64_t> order_window_ns{0};
+        std::atomic<int64_t> window_start{0};
+        std::atomic<uint32_t> max_orders_per_window{0};
+        std::atomic<uint32_t> window_count{0};
+        std::atomic<bool> enabled{false};
+    };
+
+    // Written by the market data thread
+    struct alignas(CACHE_LINE_SIZE) MarketState {
+        std::atomic<double> best_bid{0.0};
+        std::atomic<double> best_ask{0.0};
+    };
+
+    // Written by the fill handler
+    struct alignas(CACHE_LINE_SIZE) PositionState {
+        std::atomic<double> position{0.0};
+    };
+
+    alignas(CACHE_LINE_SIZE) std::atomic<bool> kill_switch_{false};
+    std::array<LimitState, MAX_INSTRUMENTS> limits_;
+    std::array<MarketState, MAX_INSTRUMENTS> market_;
+    std::array<PositionState, MAX_INSTRUMENTS> positions_;
+};
@@ -0,0 +1,150 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @class RollingPairStats
+ * @brief Means, variances, covariance, hedge ratio and spread z-score of two series over a
+ *        sliding window of the last N samples, updated in O(1).
+ *
+ * Samples sit in a ring allocated once. Each push adds the new sample and, once the window is
+ * full, removes the one it overwrites, both with Welford's update so the centred sums never
+ * come from differences of large raw sums. Round-off still builds up over millions of slides,
+ * so the sums are recomputed exactly from the ring once per lap (O(1) amortized).
+ *
+ * The hedge ratio is the least-squares slope of y on x; the spread is the regression residual
+ * y - (alpha + beta x), whose mean over the window is zero. Statistics are over the window
+ * (divided by N, not N - 1). Feed log prices so the ratio is scale-free.
+ */
+class RollingPairStats {
+public:
+    explicit RollingPairStats(size_t window)
+        : window_(checked_window(window)), ring_(window), inv_full_(1.0 / window), inv_short_(1.0 / (window - 1)) {}
+
+    void push(double y, double x) {
+        Sample& slot = ring_[next_];
+        if (count_ == window_) {
+            slide(slot, Sample{y, x});
+            slot = Sample{y, x};
+        } else {
+            slot = Sample{y, x};
+            add(slot);
+        }
+        if (++next_ == window_) {
+            next_ = 0;
+            recompute();
+        }
+    }
+
+    void clear() {
+        count_ = 0;
+        next_ = 0;
+        mean_y_ = mean_x_ = m2_y_ = m2_x_ = c_xy_ = 0.0;
+    }
+
+    // Every statistic below needs a full window
+    bool ready() const { return count_ == window_; }
+    size_t count() const { return count_; }
+    size_t window() const { return window_; }
+
+    double mean_y() const { return mean_y_; }
+    double mean_x() const { return mean_x_; }
+    double variance_y() const { return m2_y_ / count_; }
+    double variance_x() const { return m2_x_ / count_; }
+    double covariance() const { return c_xy_ / count_; }
+
+    // Units of x per unit of y that hedge it; 0 if x has not moved over the window
+    double hedge_ratio() const { return m2_x_ > 0.0 ? c_xy_ / m2_x_ : 0.0; }
+
+    // Variance of y left after hedging with x
+    double spread_variance() const {
+        const double residual = m2_x_ > 0.0 ? m2_y_ - c_xy_ * c_xy_ / m2_x_ : m2_y_;
+        return residual > 0.0 ? residual / count_ : 0.0;
+    }
+
+    // Residual of (y, x) against the window's regression line
+    double spread(double y, double x) const { return (y - mean_y_) - hedge_ratio() * (x - mean_x_); }
+
+    // Spread in standard deviations; 0 while the spread has no variance
+    double z_score(double y, double x) const {
+        const double variance = spread_variance();
+        return variance > 0.0 ? spread(y, x) / std::sqrt(variance) : 0.0;
+    }
+
+private:
+    struct Sample {
+        double y = 0.0;
+        double x = 0.0;
+    };
+
+    // Runs first in the initializer list, before 1 / (window - 1) is taken
+    static size_t checked_window(size_t window) {
+        if (window < 2) throw std::invalid_argument("RollingPairStats: window must be at least 2");
+        return window;
+    }
+
+    void add(const Sample& s) {
+        ++count_;
+        const double dy = s.y - mean_y_;
+        const double dx = s.x - mean_x_;
+        mean_y_ += dy / count_;
+        mean_x_ += dx / count_;
+        m2_y_ += dy * (s.y - mean_y_);
+        m2_x_ += dx * (s.x - mean_x_);
+        c_xy_ += dx * (s.y - mean_y_);
+    }
+
+    // Full window: the inverse of add() for the oldest sample, then add() for the newest. The
+    // count only moves between N and N - 1, so both divisions become precomputed reciprocals
+    void slide(const Sample& oldest, const Sample& s) {
+        double dy = oldest.y - mean_y_;
+        double dx = oldest.x - mean_x_;
+        double mean_y = mean_y_ - dy * inv_short_;
+        double mean_x = mean_x_ - dx * inv_short_;
+        m2_y_ -= (oldest.y - mean_y) * dy;
+        m2_x_ -= (oldest.x - mean_x) * dx;
+        c_xy_ -= (oldest.x - mean_x) * dy;
+
+        dy = s.y - mean_y;
+        dx = s.x - mean_x;
+        mean_y_ = mean_y + dy * inv_full_;
+        mean_x_ = mean_x + dx * inv_full_;
+        m2_y_ += dy * (s.y - mean_y_);
+        m2_x_ += dx * (s.x - mean_x_);
+        c_xy_ += dx * (s.y - mean_y_);
+    }
+
+    // Exact two-pass sums over the ring; only called as next_ wraps, when it is full
+    void recompute() {
+        double sum_y = 0.0;
+        double sum_x = 0.0;
+        for (const Sample& s : ring_) {
+            sum_y += s.y;
+            sum_x += s.x;
+        }
+        mean_y_ = sum_y * inv_full_;
+        mean_x_ = sum_x * inv_full_;
+        m2_y_ = m2_x_ = c_xy_ = 0.0;
+        for (const Sample& s : ring_) {
+            const double dy = s.y - mean_y_;
+            const double dx = s.x - mean_x_;
+            m2_y_ += dy * dy;
+            m2_x_ += dx * dx;
+            c_xy_ += dx * dy;
+        }
+    }
+
+    const size_t window_;
+    std::vector<Sample> ring_;
+    const double inv_full_;  // 1 / N
+    const double inv_short_; // 1 / (N - 1)
+    size_t next_ = 0;
+    size_t count_ = 0;
+    double mean_y_ = 0.0;
+    double mean_x_ = 0.0;
+    double m2_y_ = 0.0; // Sum of squared deviations from the mean
+    double m2_x_ = 0.0;
+    double c_xy_ = 0.0; // Sum of co-deviations
+};
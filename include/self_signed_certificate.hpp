@@ -0,0 +1,40 @@
+#pragma once
+#include <stdexcept>
+#include <boost/asio/ssl/context.hpp>
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+
+/**
+ * @brief Installs an ephemeral P-256 key and self-signed certificate for CN=localhost, valid
+ * for a day, in a server context.
+ *
+ * For the local stand-ins the exchanges are pointed at (feed_replayer, the loopback tests):
+ * the exchanges do not verify certificates, so nothing has to be provisioned on disk.
+ */
+inline void use_self_signed_certificate(boost::asio::ssl::context& ctx) {
+    EVP_PKEY* pkey = nullptr;
+    EVP_PKEY_CTX* kctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+    if (!kctx || EVP_PKEY_keygen_init(kctx) <= 0 ||
+        EVP_PKEY_CTX_set_ec_paramgen_curve_nid(kctx, NID_X9_62_prime256v1) <= 0 ||
+        EVP_PKEY_keygen(kctx, &pkey) <= 0) {
+        EVP_PKEY_CTX_free(kctx);
+        throw std::runtime_error("Failed to generate TLS key");
+    }
+    EVP_PKEY_CTX_free(kctx);
+
+    X509* cert = X509_new();
+    ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+    X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+    X509_gmtime_adj(X509_getm_notAfter(cert), 60L * 60 * 24);
+    X509_set_pubkey(cert, pkey);
+    X509_NAME* name = X509_get_subject_name(cert);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+    X509_set_issuer_name(cert, name);
+    bool ok = X509_sign(cert, pkey, EVP_sha256()) > 0 &&
+              SSL_CTX_use_certificate(ctx.native_handle(), cert) == 1 &&
+              SSL_CTX_use_PrivateKey(ctx.native_handle(), pkey) == 1;
+    X509_free(cert);
+    EVP_PKEY_free(pkey);
+    if (!ok) throw std::runtime_error("Failed to install self-signed certificate");
+}
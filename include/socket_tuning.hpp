@@ -0,0 +1,347 @@
+#pragma once
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/bind_executor.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/dispatch.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/system/error_code.hpp>
+#include "io_uring_service.hpp"
+
+#ifdef __linux__
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
+/**
+ * @struct SocketTuning
+ * @brief Per-connection socket options for feed connections, applied once TCP is connected.
+ *
+ * Everything but no_delay is opt-in: busy polling burns a core's worth of syscalls, and the
+ * right receive buffer depends on the feed's burst size. Options the platform or the process's
+ * privileges don't allow are reported and skipped; the connection still comes up.
+ */
+struct SocketTuning {
+    bool no_delay = true;
+    int receive_buffer = 0;     // SO_RCVBUF bytes, 0 keeps kernel autotuning
+    int busy_poll_us = 0;       // SO_BUSY_POLL, spin on the NIC queue this long before sleeping (Linux)
+    bool quick_ack = false;     // TCP_QUICKACK, re-armed after every receive since the kernel clears it (Linux)
+    bool rx_timestamps = false; // SO_TIMESTAMPING receive timestamps, see FeedSocket (Linux)
+    bool io_uring = false;      // Receive through IoUringService instead of epoll (Linux 6.0+)
+};
+
+/**
+ * @class FeedSocket
+ * @brief Lowest layer for the feed streams: a TCP socket with a choice of receive path.
+ *
+ * By default reads are plain asio reads (epoll). Two tunings replace them:
+ *
+ * - rx_timestamps: with SO_TIMESTAMPING the kernel attaches the time a segment arrived (stamped
+ *   by the NIC when it supports hardware timestamps, otherwise by the kernel on receive) to the
+ *   recvmsg that returns it. Asio's reads drop that control data, so this layer waits for
+ *   readability and calls recvmsg itself. last_rx_timestamp() is the arrival time of the most
+ *   recently received segment, i.e. of the bytes that completed the frame being handed up.
+ *   Frames decoded from bytes already buffered share the timestamp of the read that brought them.
+ * - io_uring: one multishot recv through the io_context's IoUringService feeds every read, see
+ *   there. Bytes that arrive with no read waiting are held here until the next one. There are
+ *   no kernel timestamps on this path, so rx_timestamps is ignored with it.
+ *
+ * Writes always go through asio. socket() is the TCP socket for connect and options; close the
+ * layer through close() (Beast's timeouts do, via beast_close_socket) so a pending io_uring
+ * read is cancelled along with the socket.
+ */
+class FeedSocket : private IoUringReceiver {
+public:
+    using executor_type = boost::asio::ip::tcp::socket::executor_type;
+    using lowest_layer_type = boost::asio::ip::tcp::socket::lowest_layer_type;
+
+    explicit FeedSocket(boost::asio::io_context& ioc) : ioc_(ioc), socket_(ioc) {}
+    ~FeedSocket() override { stop_uring(); }
+
+    FeedSocket(const FeedSocket&) = delete;
+    FeedSocket& operator=(const FeedSocket&) = delete;
+
+    executor_type get_executor() noexcept { return socket_.get_executor(); }
+    boost::asio::ip::tcp::socket& socket() { return socket_; }
+    // For asio::ssl::stream, which takes its executor from here
+    lowest_layer_type& lowest_layer() { return socket_.lowest_layer(); }
+
+    // Epoch nanoseconds, 0 until a timestamped read completes
+    int64_t last_rx_timestamp() const { return last_rx_ns_; }
+    bool timestamping() const { return timestamping_; }
+    bool using_io_uring() const { return uring_ != nullptr; }
+
+    void close(boost::system::error_code& ec) {
+        stop_uring();
+        socket_.close(ec);
+    }
+
+    friend void beast_close_socket(FeedSocket& s) {
+        boost::system::error_code ignored;
+        s.close(ignored);
+    }
+
+    /**
+     * @brief Applies the tuning to the connected socket.
+     * @return false if any requested option could not be set (each failure is logged).
+     */
+    bool apply(const SocketTuning& tuning, std::string_view source) {
+        bool ok = true;
+        boost::system::error_code ec;
+        auto report = [&](const char* option) {
+            std::cerr << "[" << source << "] " << option << ": " << ec.message() << std::endl;
+            ok = false;
+        };
+
+        if (tuning.no_delay) {
+            socket_.set_option(boost::asio::ip::tcp::no_delay(true), ec);
+            if (ec) report("TCP_NODELAY");
+        }
+        if (tuning.receive_buffer > 0) {
+            // Window scaling was settled in the handshake from tcp_rmem, so this can't grow past that
+            socket_.set_option(boost::asio::socket_base::receive_buffer_size(tuning.receive_buffer), ec);
+            if (ec) report("SO_RCVBUF");
+        }
+
+#ifdef __linux__
+        int fd = socket_.native_handle();
+        auto set = [&](int level, int name, int value, const char* option) {
+            if (setsockopt(fd, level, name, &value, sizeof(value)) != 0) {
+                ec.assign(errno, boost::system::system_category());
+                report(option);
+                return false;
+            }
+            return true;
+        };
+        if (tuning.busy_poll_us > 0) set(SOL_SOCKET, SO_BUSY_POLL, tuning.busy_poll_us, "SO_BUSY_POLL");
+        quick_ack_ = tuning.quick_ack && set(IPPROTO_TCP, TCP_QUICKACK, 1, "TCP_QUICKACK");
+
+        stop_uring();
+        uring_ = nullptr;
+        if (tuning.io_uring) {
+            IoUringService& service = boost::asio::use_service<IoUringService>(ioc_);
+            if (service.available()) {
+                uring_ = &service;
+            } else {
+                std::cerr << "[" << source << "] io_uring unavailable, receiving through epoll" << std::endl;
+                ok = false;
+            }
+        }
+        if (tuning.rx_timestamps && uring_) {
+            std::cerr << "[" << source << "] SO_TIMESTAMPING needs the epoll receive path, not enabled" << std::endl;
+            ok = false;
+        }
+        timestamping_ = tuning.rx_timestamps && !uring_ &&
+            set(SOL_SOCKET, SO_TIMESTAMPING,
+                SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE |
+                SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE, "SO_TIMESTAMPING");
+#else
+        if (tuning.busy_poll_us > 0 || tuning.quick_ack || tuning.rx_timestamps || tuning.io_uring) {
+            std::cerr << "[" << source << "] SO_BUSY_POLL, TCP_QUICKACK, SO_TIMESTAMPING and io_uring need Linux"
+                      << std::endl;
+            ok = false;
+        }
+#endif
+        return ok;
+    }
+
+    template <typename MutableBufferSequence, typename ReadHandler>
+    auto async_read_some(const MutableBufferSequence& buffers, ReadHandler&& handler) {
+        return boost::asio::async_initiate<ReadHandler, void(boost::system::error_code, std::size_t)>(
+            [this](auto handler, const MutableBufferSequence& buffers) {
+                // Zero-length reads complete at once in asio (Beast issues them); leave those to it
+                if (boost::asio::buffer_size(buffers) == 0 || (!uring_ && !timestamping_ && !quick_ack_)) {
+                    socket_.async_read_some(buffers, std::move(handler));
+                } else if (uring_) {
+                    read_uring(first_buffer(buffers), std::move(handler));
+                } else {
+                    wait_and_receive(buffers, std::move(handler));
+                }
+            },
+            handler, buffers);
+    }
+
+    template <typename ConstBufferSequence, typename WriteHandler>
+    auto async_write_some(const ConstBufferSequence& buffers, WriteHandler&& handler) {
+        return socket_.async_write_some(buffers, std::forward<WriteHandler>(handler));
+    }
+
+private:
+    // A read waiting for the io_uring receive, its handler type erased
+    struct PendingRead {
+        virtual ~PendingRead() = default;
+        virtual void complete(boost::system::error_code ec, std::size_t bytes) = 0;
+        boost::asio::mutable_buffer buffer;
+    };
+
+    template <typename Handler>
+    struct PendingReadOp : PendingRead {
+        PendingReadOp(Handler&& h, const executor_type& ex)
+            : handler(std::move(h)), executor(boost::asio::get_associated_executor(handler, ex)) {}
+
+        void complete(boost::system::error_code ec, std::size_t bytes) override {
+            boost::asio::dispatch(executor,
+                [handler = std::move(handler), ec, bytes]() mutable { std::move(handler)(ec, bytes); });
+        }
+
+        Handler handler;
+        boost::asio::associated_executor_t<Handler, executor_type> executor;
+    };
+
+    // read_some may fill just the first buffer; the SSL layer passes one anyway
+    template <typename MutableBufferSequence>
+    static boost::asio::mutable_buffer first_buffer(const MutableBufferSequence& buffers) {
+        for (auto it = boost::asio::buffer_sequence_begin(buffers); it != boost::asio::buffer_sequence_end(buffers); ++it) {
+            boost::asio::mutable_buffer b(*it);
+            if (b.size() > 0) return b;
+        }
+        return {};
+    }
+
+    template <typename Handler>
+    void read_uring(boost::asio::mutable_buffer buffer, Handler&& handler) {
+        read_ = std::make_unique<PendingReadOp<std::decay_t<Handler>>>(std::move(handler), socket_.get_executor());
+        read_->buffer = buffer;
+        if (pending_offset_ < pending_.size()) {
+            // Already here: complete through the executor, never from inside the initiation
+            std::size_t n = std::min(buffer.size(), pending_.size() - pending_offset_);
+            memcpy(buffer.data(), pending_.data() + pending_offset_, n);
+            pending_offset_ += n;
+            return post_read({}, n);
+        }
+        if (end_) return post_read(end_, 0);
+        if (!uring_id_) {
+            uring_id_ = uring_->start(socket_.native_handle(), this);
+            if (!uring_id_) return post_read(boost::asio::error::fault, 0);
+        }
+    }
+
+    void post_read(boost::system::error_code ec, std::size_t bytes) {
+        boost::asio::post(socket_.get_executor(),
+            [read = std::move(read_), ec, bytes] { read->complete(ec, bytes); });
+    }
+
+    void on_receive(const char* data, size_t size) override {
+#ifdef __linux__
+        if (quick_ack_) {
+            int one = 1;
+            setsockopt(socket_.native_handle(), IPPROTO_TCP, TCP_QUICKACK, &one, sizeof(one));
+        }
+#endif
+        size_t n = 0;
+        if (read_) {
+            n = std::min(size, read_->buffer.size());
+            memcpy(read_->buffer.data(), data, n);
+        }
+        if (n < size) {
+            if (pending_offset_ == pending_.size()) {
+                pending_.clear();
+                pending_offset_ = 0;
+            }
+            pending_.append(data + n, size - n);
+        }
+        if (read_) std::unique_ptr<PendingRead>(std::move(read_))->complete({}, n);
+    }
+
+    void on_receive_end(int result) override {
+        uring_id_ = 0;
+        end_ = result == 0 ? boost::system::error_code(boost::asio::error::eof)
+                           : boost::system::error_code(-result, boost::system::system_category());
+        if (read_) std::unique_ptr<PendingRead>(std::move(read_))->complete(end_, 0);
+    }
+
+    // Cancels the receive and aborts a waiting read; the socket is ready for a new connection
+    void stop_uring() {
+        if (uring_id_) uring_->cancel(uring_id_);
+        uring_id_ = 0;
+        if (read_) post_read(boost::asio::error::operation_aborted, 0);
+        pending_.clear();
+        pending_offset_ = 0;
+        end_ = {};
+    }
+
+    template <typename MutableBufferSequence, typename Handler>
+    void wait_and_receive(const MutableBufferSequence& buffers, Handler&& handler) {
+        socket_.async_wait(boost::asio::ip::tcp::socket::wait_read,
+            [this, buffers, handler = std::move(handler)](boost::system::error_code ec) mutable {
+                std::size_t bytes = 0;
+                if (!ec) ec = receive(buffers, bytes);
+                if (ec == boost::asio::error::would_block) return wait_and_receive(buffers, std::move(handler));
+                handler(ec, bytes);
+            });
+    }
+
+    template <typename MutableBufferSequence>
+    boost::system::error_code receive(const MutableBufferSequence& buffers, std::size_t& bytes) {
+#ifdef __linux__
+        iovec iov[16];
+        size_t count = 0;
+        for (auto it = boost::asio::buffer_sequence_begin(buffers);
+             it != boost::asio::buffer_sequence_end(buffers) && count < 16; ++it) {
+            boost::asio::mutable_buffer b(*it);
+            iov[count].iov_base = b.data();
+            iov[count].iov_len = b.size();
+            ++count;
+        }
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(scm_timestamping))];
+        msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        ssize_t n = recvmsg(socket_.native_handle(), &msg, MSG_DONTWAIT);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return boost::asio::error::would_block;
+            return boost::system::error_code(errno, boost::system::system_category());
+        }
+        if (n == 0) return boost::asio::error::eof;
+        bytes = static_cast<std::size_t>(n);
+
+        for (cmsghdr* c = CMSG_FIRSTHDR(&msg); c; c = CMSG_NXTHDR(&msg, c)) {
+            if (c->cmsg_level != SOL_SOCKET || c->cmsg_type != SCM_TIMESTAMPING) continue;
+            scm_timestamping ts;
+            memcpy(&ts, CMSG_DATA(c), sizeof(ts));
+            // ts[2] is the NIC's clock when hardware stamping is enabled on the interface
+            const timespec& t = ts.ts[2].tv_sec || ts.ts[2].tv_nsec ? ts.ts[2] : ts.ts[0];
+            last_rx_ns_ = static_cast<int64_t>(t.tv_sec) * 1'000'000'000 + t.tv_nsec;
+        }
+        if (quick_ack_) {
+            int one = 1;
+            setsockopt(socket_.native_handle(), IPPROTO_TCP, TCP_QUICKACK, &one, sizeof(one));
+        }
+        return {};
+#else
+        boost::system::error_code ec;
+        bytes = socket_.read_some(buffers, ec);
+        return ec;
+#endif
+    }
+
+    boost::asio::io_context& ioc_;
+    boost::asio::ip::tcp::socket socket_;
+    int64_t last_rx_ns_ = 0;
+    bool timestamping_ = false;
+    bool quick_ack_ = false;
+
+    IoUringService* uring_ = nullptr; // Set while the io_uring path is selected
+    uint64_t uring_id_ = 0;           // The running multishot receive, 0 if none
+    std::unique_ptr<PendingRead> read_;
+    std::string pending_;             // Received with no read waiting, consumed from pending_offset_
+    size_t pending_offset_ = 0;
+    boost::system::error_code end_;   // Why the receive ended, handed to the next read
+};
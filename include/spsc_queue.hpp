@@ -2,6 +2,7 @@
 #include <vector>
 #include <atomic>
 #include <cstddef>
+#include "placed_allocator.hpp"
 
 // Prevents false sharing by aligning to cache line size
 constexpr size_t CACHE_LINE_SIZE = 64;
@@ -9,8 +10,9 @@ constexpr size_t CACHE_LINE_SIZE = 64;
 template<typename T>
 class SPSCQueue {
 public:
-    explicit SPSCQueue(size_t capacity)
-        : capacity_(next_power_of_2(capacity)), buffer_(capacity_) {
+    // memory places and prefaults the ring, see PlacedAllocator; the default is first touch
+    explicit SPSCQueue(size_t capacity, MemoryPlacement memory = {})
+        : capacity_(next_power_of_2(capacity)), buffer_(capacity_, PlacedAllocator<T>(memory)) {
     }
 
     // Producer thread function
@@ -53,7 +55,7 @@ private:
     }
 
     const size_t capacity_; // Still const, set in initializer list
-    std::vector<T> buffer_;
+    std::vector<T, PlacedAllocator<T>> buffer_;
 
     // Align to prevent false sharing
     alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};
@@ -0,0 +1,178 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @class TimeOrderedMerger
+ * @brief Merges per-venue streams, each in exchange-time order, into one stream in global
+ *        exchange-time order.
+ *
+ * Every stream (lane) buffers its pending items in a fixed ring; a small binary heap keyed by
+ * each non-empty lane's oldest timestamp finds the next item. The oldest pending item is
+ * released once it is provably next, or once waiting longer cannot help:
+ *
+ * - every open lane has something pending, so no lane can still deliver anything older;
+ * - or the item is older than the watermark, now - max_delay: a lane that has been silent
+ *   that long is treated as having nothing older, bounding the delay a quiet venue adds;
+ * - or a lane's ring is full, which forces the oldest item out to make room.
+ *
+ * Live, `now` is the wall clock in exchange-time units (FastClock::now_nanos() for epoch-ns
+ * timestamps) and max_delay covers the spread in feed latency between venues. In backtest
+ * replay there is no wall clock: pass latest_timestamp() so the delay runs in event time, and
+ * close() each lane when its input ends so the tail drains in order.
+ *
+ * An item older than one already emitted can only have arrived after the watermark passed it.
+ * It is emitted at once, still in its lane's order, and counted in late().
+ *
+ * Items are held until released, long after the frame they were parsed from is gone, so T
+ * must own its data: an event straight off the EventBus points its string views into the
+ * parser's frame and must not be pushed. MergedFeed is the live path, feeding the lanes with
+ * EventFanIn copies whose views point at the instrument registry.
+ * Single-threaded: feed it from the consumer of the per-venue queues.
+ */
+template<typename T>
+class TimeOrderedMerger {
+public:
+    /**
+     * @param lanes Number of input streams, indexed 0..lanes-1.
+     * @param lane_capacity Pending items held per lane, rounded up to a power of two.
+     * @param max_delay Longest an item waits for slower lanes, in timestamp units.
+     */
+    TimeOrderedMerger(size_t lanes, size_t lane_capacity, int64_t max_delay)
+        : max_delay_(max_delay), open_lanes_(lanes), idle_lanes_(lanes) {
+        if (lanes == 0) throw std::invalid_argument("TimeOrderedMerger: needs at least one lane");
+        size_t capacity = 1;
+        while (capacity < lane_capacity) capacity <<= 1;
+        lanes_.resize(lanes);
+        for (auto& lane : lanes_) {
+            lane.ring.resize(capacity);
+            lane.mask = capacity - 1;
+        }
+        heap_.reserve(lanes);
+    }
+
+    // Returns false if the lane's ring is full or the lane is closed; poll() first to make room
+    bool push(size_t lane, int64_t timestamp, T&& item) {
+        Lane& l = lanes_[lane];
+        if (l.closed || l.tail - l.head == l.ring.size()) {
+            return false;
+        }
+        l.ring[l.tail & l.mask] = Entry{timestamp, std::move(item)};
+        if (l.tail++ == l.head) {
+            --idle_lanes_;
+            heap_.push_back(HeapEntry{timestamp, lane});
+            std::push_heap(heap_.begin(), heap_.end(), later);
+        }
+        if (l.tail - l.head == l.ring.size()) ++full_lanes_;
+        latest_ = std::max(latest_, timestamp);
+        return true;
+    }
+
+    // End of a lane's input: it no longer holds back the others once drained
+    void close(size_t lane) {
+        Lane& l = lanes_[lane];
+        if (l.closed) return;
+        l.closed = true;
+        --open_lanes_;
+        if (l.head == l.tail) --idle_lanes_;
+    }
+
+    /**
+     * @brief Emits every item that is ready at `now`, oldest first, as emit(timestamp, item).
+     * @return Number of items emitted.
+     */
+    template<typename Emit>
+    size_t poll(int64_t now, Emit&& emit) {
+        constexpr int64_t MIN = std::numeric_limits<int64_t>::min();
+        const int64_t watermark = now < MIN + max_delay_ ? MIN : now - max_delay_;
+        size_t emitted = 0;
+        while (!heap_.empty()) {
+            const HeapEntry top = heap_.front();
+            if (idle_lanes_ > 0 && top.timestamp > watermark && full_lanes_ == 0) {
+                break;
+            }
+            std::pop_heap(heap_.begin(), heap_.end(), later);
+            heap_.pop_back();
+
+            Lane& l = lanes_[top.lane];
+            if (l.tail - l.head == l.ring.size()) --full_lanes_;
+            Entry& entry = l.ring[l.head & l.mask];
+            ++l.head;
+            if (l.head != l.tail) {
+                heap_.push_back(HeapEntry{l.ring[l.head & l.mask].timestamp, top.lane});
+                std::push_heap(heap_.begin(), heap_.end(), later);
+            } else if (!l.closed) {
+                ++idle_lanes_;
+            }
+
+            if (entry.timestamp < last_emitted_) {
+                ++late_;
+            } else {
+                last_emitted_ = entry.timestamp;
+            }
+            emit(entry.timestamp, std::move(entry.item));
+            ++emitted;
+        }
+        emitted_ += emitted;
+        return emitted;
+    }
+
+    // Emits everything pending regardless of the watermark, e.g. at shutdown
+    template<typename Emit>
+    size_t flush(Emit&& emit) {
+        idle_lanes_ = 0;
+        size_t emitted = poll(std::numeric_limits<int64_t>::max(), emit);
+        // Every lane is empty now; open ones count as idle again
+        idle_lanes_ = open_lanes_;
+        return emitted;
+    }
+
+    // Newest timestamp pushed so far, the replay clock
+    int64_t latest_timestamp() const { return latest_; }
+    size_t pending() const {
+        size_t n = 0;
+        for (const auto& l : lanes_) n += l.tail - l.head;
+        return n;
+    }
+    uint64_t emitted() const { return emitted_; }
+    uint64_t late() const { return late_; }
+
+private:
+    struct Entry {
+        int64_t timestamp = 0;
+        T item{};
+    };
+
+    struct Lane {
+        std::vector<Entry> ring;
+        size_t mask = 0;
+        size_t head = 0;
+        size_t tail = 0;
+        bool closed = false;
+    };
+
+    struct HeapEntry {
+        int64_t timestamp;
+        size_t lane;
+    };
+
+    // Min-heap on timestamp; ties go to the lower lane so equal stamps keep a stable order
+    static bool later(const HeapEntry& a, const HeapEntry& b) {
+        return a.timestamp != b.timestamp ? a.timestamp > b.timestamp : a.lane > b.lane;
+    }
+
+    const int64_t max_delay_;
+    std::vector<Lane> lanes_;
+    std::vector<HeapEntry> heap_;
+    size_t open_lanes_;
+    size_t idle_lanes_;     // Open lanes with nothing pending; any of them blocks on the watermark
+    size_t full_lanes_ = 0; // Lanes whose ring is full; any of them forces output
+    int64_t latest_ = std::numeric_limits<int64_t>::min();
+    int64_t last_emitted_ = std::numeric_limits<int64_t>::min();
+    uint64_t emitted_ = 0;
+    uint64_t late_ = 0;
+};
@@ -0,0 +1,188 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <boost/json.hpp>
+#include "event_bus.hpp"
+#include "ipipeline.hpp"
+#include "risk_engine.hpp"
+#include "socket_tuning.hpp"
+#include "spsc_queue.hpp"
+#include "types.hpp"
+#include "utils.hpp"
+#include "wait_strategy.hpp"
+
+class MultiStreamConnector;
+
+/**
+ * @struct PipelineConfig
+ * @brief One venue feed: where to connect, what to subscribe, and where its threads run.
+ *
+ * Pipelines are named after their venue (the name strategies match OrderBookData::source
+ * against), so a topology holds at most one pipeline per venue.
+ */
+struct PipelineConfig {
+    std::string venue; // "binance", "coinbase" or "kraken"
+    std::string host;
+    std::string port = "443";
+    std::string target = "/";
+    std::vector<std::string> symbols;
+    std::vector<std::string> channels;
+    size_t queue_capacity = 8192;
+    bool huge_pages = false; // Back the queue ring with 2MB pages, see MemoryPlacement
+    ThreadPlacement exchange_thread;
+    ThreadPlacement parser_thread;
+    WaitStrategy wait_strategy = WaitStrategy::Sleep;
+    SocketTuning socket_tuning;
+    // 0: one exchange socket carries every stream. Otherwise the streams are sharded over a
+    // MultiStreamConnector, at most this many (and the venue's own cap) per connection
+    size_t max_streams_per_connection = 0;
+    // Above 1, every connection is opened this many times and a FeedArbiter keeps the first copy
+    // of each message; implies the MultiStreamConnector. Copy i binds local_addresses[i % size]
+    size_t redundancy = 1;
+    std::vector<std::string> local_addresses;
+
+    // The venue's subscribe message for symbols x channels
+    boost::json::object subscription() const;
+    // What the venue subscribes by, one entry per stream: Binance stream names, Coinbase
+    // product IDs or Kraken symbols
+    std::vector<std::string> streams() const;
+};
+
+/**
+ * @struct ScanInstrumentConfig
+ * @brief One symbol an arb_scanner watches, as each of its pipelines names it.
+ */
+struct ScanInstrumentConfig {
+    std::string name;
+    std::vector<std::string> symbols; // symbols[i] on pipelines[i]; empty if that venue doesn't list it
+};
+
+/**
+ * @struct PairConfig
+ * @brief A pair_trading pair: y hedged with x, each leg by venue and symbol.
+ */
+struct PairConfig {
+    std::string y_venue;
+    std::string y_symbol;
+    std::string x_venue;
+    std::string x_symbol;
+};
+
+/**
+ * @struct StrategyConfig
+ * @brief A strategy and the pipelines it reads, by venue name.
+ */
+struct StrategyConfig {
+    std::string type; // "cross_exchange_arb", "arb_scanner", "triangular_arb" or "pair_trading"
+    std::vector<std::string> pipelines;
+    double diff_percent = 0.0; // Minimum profit as a fraction of the bought notional
+    double fee = 0.001;
+    std::vector<double> fees;  // Per pipeline; "fee" unless overridden in "fees"
+    // cross_exchange_arb only: the one symbol traded on each pipeline, from "symbols" or, for a
+    // single-symbol pipeline, that symbol
+    std::vector<std::string> symbols;
+    // arb_scanner only
+    std::vector<ScanInstrumentConfig> instruments;
+    size_t top_n = 5;
+    // pair_trading only
+    std::vector<PairConfig> pairs;
+    size_t window = 500; // Samples the rolling statistics cover
+    double entry_z = 2.0;
+    double exit_z = 0.5;
+};
+
+/**
+ * @struct TopologyConfig
+ * @brief Everything the launcher needs to build the process, read from a JSON file.
+ *
+ * {
+ *   "log_file": "logs/events.log",
+ *   "logger_cpu": 8,
+ *   "candles": ["1s", "1m", "10vol", "100tick"], "candle_delay_ms": 200,
+ *   "risk": {"max_position": 0.0, "max_notional": 0.0, "max_price_deviation": 0.05,
+ *            "max_orders_per_window": 0, "order_window_ms": 1000},
+ *   "pipelines": [{
+ *     "venue": "binance", "host": "stream.binance.com", "port": "443", "target": "/ws",
+ *     "symbols": ["BTCUSDT"], "channels": ["depth20@100ms"], "queue_capacity": 8192,
+ *     "huge_pages": false, "max_streams_per_connection": 0,
+ *     "redundancy": 1, "local_addresses": [],
+ *     "exchange_thread": {"cpu": 2}, "parser_thread": {"numa_node": 0},
+ *     "wait_strategy": "spin",
+ *     "socket": {"no_delay": true, "receive_buffer": 0, "busy_poll_us": 0,
+ *                "quick_ack": false, "rx_timestamps": false, "io_uring": false}
+ *   }],
+ *   "strategies": [{"type": "cross_exchange_arb", "pipelines": ["binance", "coinbase"],
+ *                   "symbols": {"binance": "BTCUSDT", "coinbase": "BTC-USD"},
+ *                   "diff_percent": 0.00001, "fee": 0.001},
+ *                  {"type": "arb_scanner", "pipelines": ["binance", "coinbase", "kraken"],
+ *                   "fee": 0.001, "fees": {"kraken": 0.0026}, "top_n": 5,
+ *                   "instruments": [{"name": "BTC-USD",
+ *                                    "symbols": {"coinbase": "BTC-USD", "kraken": "BTC/USD"}}]},
+ *                  {"type": "triangular_arb", "pipelines": ["binance"], "diff_percent": 0.0005},
+ *                  {"type": "pair_trading", "pipelines": ["binance"], "window": 500,
+ *                   "entry_z": 2.0, "exit_z": 0.5,
+ *                   "pairs": [{"y": {"venue": "binance", "symbol": "ETHUSDT"},
+ *                              "x": {"venue": "binance", "symbol": "BTCUSDT"}}]}]
+ * }
+ *
+ * A cross_exchange_arb strategy keeps one book per pipeline, so "symbols" is required for any of
+ * its pipelines that carries more than one symbol. A triangular_arb strategy trades cycles among
+ * the symbols of its one pipeline. "risk" holds
+ * the pre-trade limits every pipeline symbol gets; the zero defaults reject every order.
+ *
+ * Every key but pipelines[].venue and pipelines[].host has the default shown in the structs.
+ */
+struct TopologyConfig {
+    std::string log_file = "logs/events.log";
+    int logger_cpu = -1;
+    // Bars built locally from every pipeline's trades, see BarSpec::parse; none if empty
+    std::vector<std::string> candles;
+    int64_t candle_delay_ms = 200; // Grace for trades in flight before a time bar closes
+    RiskLimits risk; // Applied to every (venue, symbol) of the pipelines
+    std::vector<PipelineConfig> pipelines;
+    std::vector<StrategyConfig> strategies;
+
+    // Throws std::invalid_argument on unreadable files, bad JSON or an inconsistent topology
+    static TopologyConfig load(const std::string& path);
+    static TopologyConfig parse(const boost::json::value& root);
+};
+
+/**
+ * @class Topology
+ * @brief Owns the queues and pipelines a TopologyConfig describes.
+ *
+ * Pipelines are built, configured and initialized in the constructor but not started: a
+ * strategy starts the pipelines it reads, start_unowned() starts the ones no strategy claims.
+ *
+ * Memory follows the parser thread's placement (the exchange thread's if the parser is
+ * unplaced). Each queue's ring is bound to that NUMA node and prefaulted, on huge pages if the
+ * pipeline asks for them. Each pipeline is constructed from a thread placed like the parser,
+ * so the processor's state is first touched there.
+ */
+class Topology {
+public:
+    Topology(const TopologyConfig& config, std::shared_ptr<EventBus> event_bus);
+    ~Topology();
+
+    Topology(const Topology&) = delete;
+    Topology& operator=(const Topology&) = delete;
+
+    // Null if no pipeline has that venue
+    IPipeline* pipeline(const std::string& venue);
+
+    void start_unowned();
+    void stop();
+
+    // Per-stage latency and drop counts of every pipeline, and arbitration where it is redundant
+    void export_summary(std::ostream& os) const;
+
+private:
+    const TopologyConfig config_;
+    std::vector<std::unique_ptr<SPSCQueue<RawMessage>>> queues_;
+    std::vector<std::unique_ptr<IPipeline>> pipelines_;
+    std::vector<IPipeline*> unowned_;
+    std::vector<const MultiStreamConnector*> connectors_; // Per pipeline, null for a single socket
+};
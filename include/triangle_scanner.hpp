@@ -0,0 +1,244 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "instrument_registry.hpp"
+#include "level_book.hpp"
+
+/**
+ * @class TriangleScanner
+ * @brief Finds profitable three-leg currency cycles within one venue, e.g. USDT -> BTC -> ETH -> USDT.
+ *
+ * Every pair of the venue in the registry is an edge of a currency graph: selling the base at the
+ * bid, or buying it at the ask. Each direction's after-fee rate is kept as a log, so a cycle
+ * is profitable when the sum of its three logs beats log(1 + min_profit); there are no
+ * divisions or products on the hot path. All triangles are enumerated once at construction,
+ * and each pair holds a contiguous list of the cycles through it with their edge indices
+ * inlined. An update therefore costs two logs plus three loads and two adds per cycle through
+ * the updated pair, and nothing for the rest of the graph.
+ *
+ * Rates use top-of-book prices only; size() caps a cycle by the top-level quantities.
+ * Single-threaded.
+ */
+class TriangleScanner {
+public:
+    struct Leg {
+        uint32_t instrument;
+        bool sell; // Sell the pair's base at the bid, otherwise buy it at the ask
+    };
+
+    struct Cycle {
+        uint32_t start;          // Currency the cycle starts and ends in
+        std::array<Leg, 3> legs;
+    };
+
+    /**
+     * @param source Venue whose instruments form the graph; other registry entries are ignored.
+     * @param fee Taker fee per leg as a fraction of notional.
+     * @param min_profit Minimum return of a cycle, e.g. 0.0005 for 5bp.
+     * @param quote_assets Suffixes that split symbols without a separator, e.g. "ETHBTC".
+     */
+    TriangleScanner(const InstrumentRegistry& registry, std::string_view source, double fee, double min_profit,
+                    std::vector<std::string> quote_assets = {"USDT", "USDC", "FDUSD", "TUSD", "BTC", "ETH", "BNB",
+                                                             "EUR", "USD", "TRY", "DAI"})
+        : log_keep_(std::log(1.0 - fee)), threshold_(std::log(1.0 + min_profit)),
+          fee_(fee), quote_assets_(std::move(quote_assets)) {
+        // Longest first so "USDT" wins over "USD"
+        std::sort(quote_assets_.begin(), quote_assets_.end(),
+                  [](const std::string& a, const std::string& b) { return a.size() > b.size(); });
+        const size_t n = registry.size();
+        pairs_.resize(n);
+        edge_log_.assign(2 * n, -std::numeric_limits<double>::infinity());
+        quotes_.resize(n);
+
+        std::unordered_map<std::string, uint32_t> currency_ids;
+        auto currency = [&](std::string_view name) {
+            auto [it, added] = currency_ids.emplace(std::string(name), static_cast<uint32_t>(currencies_.size()));
+            if (added) currencies_.emplace_back(name);
+            return it->second;
+        };
+        for (uint32_t id = 0; id < n; ++id) {
+            const InstrumentInfo& info = registry.info(id);
+            std::string_view base;
+            std::string_view quote;
+            if (info.source != source || !split_symbol(info.symbol, base, quote)) continue;
+            pairs_[id] = Pair{true, currency(base), currency(quote)};
+        }
+        build_cycles();
+    }
+
+    // Splits "BTC-USD", "BTC/USD" or "BTCUSDT" into base and quote; false if it can't
+    bool split_symbol(std::string_view symbol, std::string_view& base, std::string_view& quote) const {
+        const size_t sep = symbol.find_first_of("-/");
+        if (sep != std::string_view::npos) {
+            base = symbol.substr(0, sep);
+            quote = symbol.substr(sep + 1);
+            return !base.empty() && !quote.empty();
+        }
+        for (const auto& q : quote_assets_) {
+            if (symbol.size() > q.size() && symbol.substr(symbol.size() - q.size()) == q) {
+                base = symbol.substr(0, symbol.size() - q.size());
+                quote = symbol.substr(symbol.size() - q.size());
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Updates one pair's rates and checks every cycle through it.
+     *
+     * Calls emit(cycle_id, log_return) for each cycle whose return clears min_profit.
+     * @return Number of cycles emitted.
+     */
+    template<typename Emit>
+    size_t update(uint32_t instrument, const LevelBook::TopOfBook& top, Emit&& emit) {
+        if (instrument >= pairs_.size() || !pairs_[instrument].tradable) {
+            return 0;
+        }
+        constexpr double NONE = -std::numeric_limits<double>::infinity();
+        // Selling 1 base yields bid quote; 1 quote buys 1/ask base
+        edge_log_[2 * instrument] = top.bid_quantity > 0.0 ? std::log(top.bid_price) + log_keep_ : NONE;
+        edge_log_[2 * instrument + 1] = top.ask_quantity > 0.0 ? log_keep_ - std::log(top.ask_price) : NONE;
+        quotes_[instrument] = top;
+
+        const double* w = edge_log_.data();
+        size_t found = 0;
+        for (uint32_t k = offsets_[instrument]; k < offsets_[instrument + 1]; ++k) {
+            const Touch& t = touching_[k];
+            const double log_return = w[t.edges[0]] + w[t.edges[1]] + w[t.edges[2]];
+            if (log_return > threshold_) {
+                emit(t.cycle, log_return);
+                ++found;
+            }
+        }
+        return found;
+    }
+
+    /**
+     * @brief Largest amount of the start currency the cycle can take at the top levels.
+     */
+    double size(uint32_t cycle_id) const {
+        const Cycle& cycle = cycles_[cycle_id];
+        double cap = std::numeric_limits<double>::infinity();
+        double units = 1.0; // Units of the current currency per unit of the start currency
+        for (const Leg& leg : cycle.legs) {
+            const LevelBook::TopOfBook& q = quotes_[leg.instrument];
+            if (leg.sell) {
+                cap = std::min(cap, q.bid_quantity / units);
+                units *= q.bid_price * (1.0 - fee_);
+            } else {
+                cap = std::min(cap, q.ask_quantity * q.ask_price / units);
+                units *= (1.0 - fee_) / q.ask_price;
+            }
+        }
+        return cap;
+    }
+
+    const Cycle& cycle(uint32_t cycle_id) const { return cycles_[cycle_id]; }
+    const std::string& currency(uint32_t id) const { return currencies_[id]; }
+    // Currency a leg pays with and the one it receives
+    uint32_t from(const Leg& leg) const { return leg.sell ? pairs_[leg.instrument].base : pairs_[leg.instrument].quote; }
+    uint32_t to(const Leg& leg) const { return leg.sell ? pairs_[leg.instrument].quote : pairs_[leg.instrument].base; }
+    size_t cycles() const { return cycles_.size(); }
+
+private:
+    struct Pair {
+        bool tradable = false;
+        uint32_t base = 0;
+        uint32_t quote = 0;
+    };
+
+    // A cycle through a pair, with its edges inlined so the scan needs no further lookups
+    struct Touch {
+        std::array<uint32_t, 3> edges; // Indices into edge_log_
+        uint32_t cycle;
+    };
+
+    static uint64_t key(uint32_t a, uint32_t b) {
+        return a < b ? (uint64_t(a) << 32) | b : (uint64_t(b) << 32) | a;
+    }
+
+    // The leg that turns `from` into the other currency of the pair
+    Leg leg(uint32_t instrument, uint32_t from_currency) const {
+        return Leg{instrument, pairs_[instrument].base == from_currency};
+    }
+
+    uint32_t other(uint32_t instrument, uint32_t currency) const {
+        return pairs_[instrument].base == currency ? pairs_[instrument].quote : pairs_[instrument].base;
+    }
+
+    void build_cycles() {
+        std::unordered_map<uint64_t, uint32_t> pair_between;
+        std::vector<std::vector<uint32_t>> by_currency(currencies_.size());
+        for (uint32_t id = 0; id < pairs_.size(); ++id) {
+            if (!pairs_[id].tradable) continue;
+            pair_between.emplace(key(pairs_[id].base, pairs_[id].quote), id);
+            by_currency[pairs_[id].base].push_back(id);
+            by_currency[pairs_[id].quote].push_back(id);
+        }
+
+        // Triangles a-b, b-c, c-a, each found once
+        std::set<std::array<uint32_t, 3>> seen;
+        std::vector<std::vector<Touch>> touching(pairs_.size());
+        for (uint32_t p1 = 0; p1 < pairs_.size(); ++p1) {
+            if (!pairs_[p1].tradable) continue;
+            const uint32_t a = pairs_[p1].quote;
+            const uint32_t b = pairs_[p1].base;
+            for (uint32_t p2 : by_currency[b]) {
+                const uint32_t c = other(p2, b);
+                if (p2 == p1 || c == a) continue;
+                auto it = pair_between.find(key(c, a));
+                if (it == pair_between.end()) continue;
+                const uint32_t p3 = it->second;
+                std::array<uint32_t, 3> triangle{p1, p2, p3};
+                std::sort(triangle.begin(), triangle.end());
+                if (!seen.insert(triangle).second) continue;
+
+                // Both directions, starting from p1's quote: a -> b -> c -> a and a -> c -> b -> a
+                add_cycle(Cycle{a, {leg(p1, a), leg(p2, b), leg(p3, c)}}, touching);
+                add_cycle(Cycle{a, {leg(p3, a), leg(p2, c), leg(p1, b)}}, touching);
+            }
+        }
+
+        // Flatten into one array, grouped by pair
+        offsets_.assign(pairs_.size() + 1, 0);
+        for (uint32_t id = 0; id < pairs_.size(); ++id) {
+            offsets_[id + 1] = offsets_[id] + static_cast<uint32_t>(touching[id].size());
+            touching_.insert(touching_.end(), touching[id].begin(), touching[id].end());
+        }
+    }
+
+    void add_cycle(const Cycle& cycle, std::vector<std::vector<Touch>>& touching) {
+        const uint32_t id = static_cast<uint32_t>(cycles_.size());
+        cycles_.push_back(cycle);
+        Touch t{};
+        for (size_t i = 0; i < 3; ++i) {
+            t.edges[i] = 2 * cycle.legs[i].instrument + (cycle.legs[i].sell ? 0 : 1);
+        }
+        t.cycle = id;
+        for (const Leg& l : cycle.legs) {
+            touching[l.instrument].push_back(t);
+        }
+    }
+
+    const double log_keep_;  // log(1 - fee), added to every edge
+    const double threshold_; // log(1 + min_profit)
+    const double fee_;
+    std::vector<std::string> quote_assets_;
+    std::vector<std::string> currencies_;
+    std::vector<Pair> pairs_;           // By instrument id
+    std::vector<double> edge_log_;      // 2 * id: sell at the bid, 2 * id + 1: buy at the ask
+    std::vector<LevelBook::TopOfBook> quotes_;
+    std::vector<Cycle> cycles_;
+    std::vector<uint32_t> offsets_;     // Cycles through pair id are touching_[offsets_[id], offsets_[id + 1])
+    std::vector<Touch> touching_;
+};
@@ -8,6 +8,35 @@
 
 using PriceLevel = std::pair<double, double>;
 
+// Per-message latency trace. Stage stamps are raw FastClock ticks, exchange_time is epoch ns.
+struct TraceRecord {
+    int64_t exchange_time = 0;
+    int64_t kernel_rx = 0; // Epoch ns the NIC/kernel received the frame, 0 without SO_TIMESTAMPING
+    uint64_t socket_rx = 0;
+    uint64_t enqueue = 0;
+    uint64_t dequeue = 0;
+    uint64_t parse_done = 0;
+    uint64_t handler_done = 0;
+};
+
+enum class FeedState : uint8_t {
+    Connected,    // (Re)subscribed; books rebuild from the snapshot or deltas that follow
+    Disconnected, // Connection lost; books from this source are invalid until Connected
+    Stale,        // Connection open but silent past the staleness limit, being recycled
+    Gap           // Frames were dropped (queue full); books from this source are invalid until rebuilt
+};
+
+// Raw frame handed from the exchange thread to the parser thread
+struct RawMessage {
+    std::string payload;
+    TraceRecord trace;
+    uint32_t connection = 0; // Receiving connection when a venue is spread over several sockets
+    // In-band connection status marker: payload holds the reason instead of a frame, and it
+    // reaches the parser in order with the data around it
+    bool feed_status = false;
+    FeedState state = FeedState::Connected;
+};
+
 struct alignas(64) CandleStickData {
     int64_t open_time;
     int64_t close_time;
@@ -20,6 +49,7 @@ struct alignas(64) CandleStickData {
     std::string_view source;
     std::string_view symbol;
     std::string_view interval;
+    TraceRecord trace;
 };
 
 struct alignas(64) TradeData {
@@ -29,6 +59,7 @@ struct alignas(64) TradeData {
     std::string_view source;
     std::string_view symbol;
     std::string_view side;
+    TraceRecord trace;
 };
 
 struct alignas(64) TickerData {
@@ -45,15 +76,85 @@ struct alignas(64) TickerData {
     double low_24h;
     std::string_view source;
     std::string_view symbol;
+    TraceRecord trace;
 };
 
-struct alignas(64) OrderBookData {
+enum class Side : uint8_t {
+    Buy,
+    Sell
+};
+
+enum class OrderType : uint8_t {
+    Limit,
+    Market
+};
+
+struct alignas(64) OrderRequest {
+    uint64_t client_order_id;
+    uint32_t instrument_id;
+    Side side;
+    OrderType type;
+    double price;
+    double quantity;
+    std::string_view source;
+    std::string_view symbol;
+};
+
+enum class OrderStatus : uint8_t {
+    New,
+    Acknowledged,
+    PartiallyFilled,
+    Filled,
+    Canceled,
+    Rejected
+};
+
+struct alignas(64) OrderUpdateData {
     int64_t timestamp;
-    int64_t id;
+    uint64_t client_order_id;
+    uint64_t exchange_order_id;
+    uint32_t instrument_id;
+    OrderStatus status;
+    Side side;
+    double price;
+    double quantity;
+    double filled_quantity;
+    double avg_fill_price;
+    std::string_view source;
+    std::string_view symbol;
+};
+
+struct alignas(64) FillData {
+    int64_t timestamp;
+    uint64_t client_order_id;
+    uint32_t instrument_id;
+    Side side;
+    double price;
+    double quantity;
+    double position;
+    double realized_pnl;
+    std::string_view source;
+    std::string_view symbol;
+};
+
+struct FeedStatusData {
+    int64_t timestamp;
+    FeedState state;
+    uint32_t connection;
+    std::string_view source;
+    std::string_view reason;
+};
+
+struct alignas(64) OrderBookData {
+    int64_t timestamp = 0;
+    int64_t id = 0;       // Last update ID covered (Binance u / lastUpdateId), 0 if the venue sends none
+    int64_t first_id = 0; // First update ID covered (Binance U); non-zero marks a sequenced diff
+    bool snapshot = false; // Replaces the whole book rather than patching it
     std::vector<PriceLevel> bids;
     std::vector<PriceLevel> asks;
     std::string_view source;
     std::string_view symbol;
+    TraceRecord trace;
 };
 
 struct Event {};
@@ -72,4 +173,16 @@ struct TradeEvent : Event {
 
 struct OrderBookDataEvent : Event {
     OrderBookData data;
+};
+
+struct FeedStatusEvent : Event {
+    FeedStatusData data;
+};
+
+struct OrderUpdateEvent : Event {
+    OrderUpdateData data;
+};
+
+struct FillEvent : Event {
+    FillData data;
 };
\ No newline at end of file
@@ -7,6 +7,8 @@
 #include <stdexcept>
 #include <cstdint> 
 #include <thread> 
+#include <fstream>
+#include <vector>
 
 
 #ifdef _WIN32
@@ -80,6 +82,50 @@ inline int64_t convert_timestamp_to_milliseconds(const std::string& timestamp_st
 
 
 
+// Days since 1970-01-01 for a proleptic Gregorian date (H. Hinnant's days_from_civil)
+inline int64_t days_from_civil(int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+/**
+ * @brief Parses a UTC ISO-8601 timestamp ("2024-05-01T12:34:56.123456Z") to epoch nanoseconds.
+ *
+ * Fixed-position parse with no locale or timezone lookups, fractional seconds up to 9 digits.
+ * Returns 0 if the string is too short to hold a date and time.
+ */
+inline int64_t parse_iso8601_nanos(const char* s, size_t len) {
+    if (len < 19) return 0;
+    auto num = [s](size_t pos, size_t n) {
+        int64_t v = 0;
+        for (size_t i = 0; i < n; ++i) v = v * 10 + (s[pos + i] - '0');
+        return v;
+    };
+    int64_t days = days_from_civil(num(0, 4), static_cast<unsigned>(num(5, 2)), static_cast<unsigned>(num(8, 2)));
+    int64_t seconds = ((days * 24 + num(11, 2)) * 60 + num(14, 2)) * 60 + num(17, 2);
+
+    int64_t nanos = 0;
+    size_t i = 19;
+    if (i < len && s[i] == '.') {
+        ++i;
+        int digits = 0;
+        while (i < len && s[i] >= '0' && s[i] <= '9') {
+            if (digits < 9) {
+                nanos = nanos * 10 + (s[i] - '0');
+                ++digits;
+            }
+            ++i;
+        }
+        for (; digits < 9; ++digits) nanos *= 10;
+    }
+    return seconds * 1'000'000'000 + nanos;
+}
+
+
 template <typename T>
 inline int64_t get_time_now_impl() {
     auto now = std::chrono::system_clock::now();
@@ -151,4 +197,87 @@ inline void pin_thread_to_cpu(std::thread& t, int cpu_num) {
         std::cerr << "Error: Failed to pin thread to CPU " << cpu_num << ". Error code: " << rc << std::endl;
     }
 #endif
+}
+
+/**
+ * @brief Pins the calling thread to a specific CPU core.
+ * @param cpu_num The CPU core number to pin the thread to.
+ */
+inline void pin_current_thread_to_cpu(int cpu_num) {
+#ifdef _WIN32
+    DWORD_PTR mask = 1LL << cpu_num;
+    if (SetThreadAffinityMask(GetCurrentThread(), mask) == 0) {
+        std::cerr << "Error: Failed to pin thread to CPU " << cpu_num << ". Error code: " << GetLastError() << std::endl;
+    }
+#else
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(cpu_num, &cpuset);
+    int rc = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+    if (rc != 0) {
+        std::cerr << "Error: Failed to pin thread to CPU " << cpu_num << ". Error code: " << rc << std::endl;
+    }
+#endif
+}
+
+/**
+ * @struct ThreadPlacement
+ * @brief Where a long-running thread runs: one CPU, or any CPU of one NUMA node.
+ *
+ * cpu wins when both are set; with neither the scheduler decides.
+ */
+struct ThreadPlacement {
+    int cpu = -1;
+    int numa_node = -1;
+
+    bool pinned() const { return cpu >= 0 || numa_node >= 0; }
+};
+
+/**
+ * @brief The CPUs of a NUMA node, read from /sys/devices/system/node/node<N>/cpulist.
+ * @return Empty if the node does not exist or the platform has no such file.
+ */
+inline std::vector<int> numa_node_cpus(int node) {
+    std::vector<int> cpus;
+    std::ifstream in("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    std::string range;
+    // "0-3,8-11"
+    while (std::getline(in, range, ',')) {
+        size_t dash = range.find('-');
+        try {
+            int first = std::stoi(range.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+        } catch (const std::exception&) {
+            break;
+        }
+    }
+    return cpus;
+}
+
+/**
+ * @brief Applies a placement to a running thread; does nothing if it is not pinned.
+ */
+inline void pin_thread(std::thread& t, const ThreadPlacement& placement) {
+    if (placement.cpu >= 0) {
+        pin_thread_to_cpu(t, placement.cpu);
+        return;
+    }
+    if (placement.numa_node < 0) return;
+#ifdef _WIN32
+    std::cerr << "Error: Pinning to NUMA node " << placement.numa_node << " needs a CPU on Windows" << std::endl;
+#else
+    std::vector<int> cpus = numa_node_cpus(placement.numa_node);
+    if (cpus.empty()) {
+        std::cerr << "Error: NUMA node " << placement.numa_node << " has no CPUs" << std::endl;
+        return;
+    }
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    for (int cpu : cpus) CPU_SET(cpu, &cpuset);
+    int rc = pthread_setaffinity_np(t.native_handle(), sizeof(cpu_set_t), &cpuset);
+    if (rc != 0) {
+        std::cerr << "Error: Failed to pin thread to NUMA node " << placement.numa_node << ". Error code: " << rc << std::endl;
+    }
+#endif
 }
\ No newline at end of file
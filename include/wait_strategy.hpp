@@ -0,0 +1,49 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @enum WaitStrategy
+ * @brief What a consumer thread does when its queue is empty.
+ *
+ * Spin keeps the core hot and reacts within nanoseconds but owns the core outright, so it
+ * wants an isolated, pinned CPU. Yield gives the core to other runnable threads between
+ * polls. Sleep parks for 10µs per empty poll, the cheapest on a shared box and the slowest
+ * to notice the next message.
+ */
+enum class WaitStrategy : uint8_t {
+    Spin,
+    Yield,
+    Sleep
+};
+
+inline void idle_wait(WaitStrategy strategy) {
+    switch (strategy) {
+    case WaitStrategy::Spin:
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+        _mm_pause();
+#endif
+        break;
+    case WaitStrategy::Yield:
+        std::this_thread::yield();
+        break;
+    case WaitStrategy::Sleep:
+        std::this_thread::sleep_for(std::chrono::microseconds(10));
+        break;
+    }
+}
+
+// "spin", "yield" or "sleep"; false leaves strategy untouched
+inline bool parse_wait_strategy(std::string_view name, WaitStrategy& strategy) {
+    if (name == "spin") strategy = WaitStrategy::Spin;
+    else if (name == "yield") strategy = WaitStrategy::Yield;
+    else if (name == "sleep") strategy = WaitStrategy::Sleep;
+    else return false;
+    return true;
+}
@@ -1,11 +1,14 @@
 #include "binance_data_processor.hpp"
 #include "binance_fast_parser.hpp"
+#include "latency_trace.hpp"
+#include "feed_supervisor.hpp"
 #include <thread>
 #include <iostream>
 #include <boost/json.hpp>
 #include <boost/system/error_code.hpp>
 #include <boost/lexical_cast.hpp>
 #include <chrono>
+#include <cctype>
 #include <charconv>
 #include "utils.hpp"
 #include "simdjson.h"
@@ -16,7 +19,7 @@
 namespace json = boost::json;
 static simdjson::ondemand::parser parser;
 
-BinanceDataProcessor::BinanceDataProcessor(SPSCQueue<std::string>& queue, std::shared_ptr<EventBus> event_bus)
+BinanceDataProcessor::BinanceDataProcessor(SPSCQueue<RawMessage>& queue, std::shared_ptr<EventBus> event_bus)
     : queue_(queue), event_bus_(event_bus) {}
 
 BinanceDataProcessor::~BinanceDataProcessor() {
@@ -30,13 +33,17 @@ void BinanceDataProcessor::start() {
     }
     running_ = true;
 
-    std::string message;
+    RawMessage message;
     while (running_) {
         if (queue_.try_pop(message)) {
+            message.trace.dequeue = FastClock::ticks();
+            if (message.feed_status) {
+                publish_feed_status(*event_bus_, message, "Binance");
+                continue;
+            }
             parse_and_publish(message);
         } else {
-            // Prevent busy-waiting with a short sleep
-            std::this_thread::sleep_for(std::chrono::microseconds(10));
+            idle_wait(wait_strategy_);
         }
     }
 }
@@ -45,9 +52,9 @@ void BinanceDataProcessor::stop() {
     running_ = false;
 }
 
-void BinanceDataProcessor::parse_and_publish(const std::string& message) {
-    const char* start = message.c_str();
-    const char* end = start + message.length();
+void BinanceDataProcessor::parse_and_publish(RawMessage& message) {
+    const char* start = message.payload.c_str();
+    const char* end = start + message.payload.length();
 
 
     const char* data_start = BinanceFastParser::find_value_after_key(start, end, "data", 4);
@@ -56,7 +63,26 @@ void BinanceDataProcessor::parse_and_publish(const std::string& message) {
     const char* event_type_val = BinanceFastParser::find_value_after_key(data_start, end, "e", 1);
     const char* symbol_val = BinanceFastParser::find_value_after_key(data_start, end, "s", 1);
 
-    if (strncmp(event_type_val, "trade", 5) == 0) {
+    if (!event_type_val) {
+        // Partial book depth (<symbol>@depth<levels>) has no event type, only lastUpdateId
+        if (!BinanceFastParser::find_value_after_key(data_start, end, "lastUpdateId", 12)) return;
+        OrderBookDataEvent order_book_event;
+        order_book_event.data = BinanceFastParser::parse_partial_depth(data_start, end - data_start);
+        order_book_event.data.source = "Binance";
+        // Nor a symbol or event time: the symbol is the stream name's prefix, upper-cased in place
+        if (const char* stream_val = BinanceFastParser::find_value_after_key(start, end, "stream", 6)) {
+            char* stream = message.payload.data() + (stream_val - start);
+            char* symbol_end = stream;
+            while (symbol_end < end && *symbol_end != '@' && *symbol_end != '"') {
+                *symbol_end = static_cast<char>(std::toupper(static_cast<unsigned char>(*symbol_end)));
+                ++symbol_end;
+            }
+            order_book_event.data.symbol = std::string_view(stream, symbol_end - stream);
+        }
+        order_book_event.data.timestamp = FastClock::to_epoch_nanos(message.trace.socket_rx);
+        publish_traced(*event_bus_, order_book_event, message.trace, tracer_);
+    }
+    else if (strncmp(event_type_val, "trade", 5) == 0) {
         TradeEvent trade_event;
         TradeData& trade_data = trade_event.data;
         trade_data.source = "Binance";
@@ -85,21 +111,27 @@ void BinanceDataProcessor::parse_and_publish(const std::string& message) {
         // Extract and parse trade time "T" (this is a raw number, not a string)
         const char* time_val = BinanceFastParser::find_value_after_key(data_start, end, "T", 1);
         if (time_val) {
-            // The parser will stop at the next comma or brace
-            trade_data.trade_time = get_time_now_nano();
-            // trade_data.trade_time = time_val.;
-            // trade_data.trade_time = BinanceFastParser::parse_int64(time_val, end) * 10000;
+            // The parser will stop at the next comma or brace; trade time is in milliseconds
+            trade_data.trade_time = BinanceFastParser::parse_int64(time_val, end) * 1'000'000;
+            message.trace.exchange_time = trade_data.trade_time;
+        }
 
+        // "m" is true when the buyer was the maker, i.e. the seller was the aggressor
+        const char* maker_val = BinanceFastParser::find_value_after_key(data_start, end, "m", 1);
+        if (maker_val) {
+            trade_data.side = *maker_val == 't' ? "sell" : "buy";
         }
         
         // All data extracted, publish the event
-        event_bus_->publish(trade_event);
+        publish_traced(*event_bus_, trade_event, message.trace, tracer_);
     }
     else if(strncmp(event_type_val, "depthUpdate", 11) == 0 ){
         OrderBookDataEvent order_book_event;
 
-        order_book_event.data = BinanceFastParser::parse_depth_update(message.c_str(), strlen(message.c_str()));
-        event_bus_->publish(order_book_event);
+        order_book_event.data = BinanceFastParser::parse_depth_update(start, message.payload.length());
+        order_book_event.data.source = "Binance";
+        message.trace.exchange_time = order_book_event.data.timestamp;
+        publish_traced(*event_bus_, order_book_event, message.trace, tracer_);
 
     }
     else if ((strncmp(event_type_val, "24hrTicker", 6) == 0 )){
@@ -118,8 +150,8 @@ void BinanceDataProcessor::parse_and_publish(const std::string& message) {
         // Extract and parse price "E"
         const char* timestamp_val = BinanceFastParser::find_value_after_key(data_start, end, "E", 1);
         if (timestamp_val) {
-            // tick_data.timestamp = BinanceFastParser::parse_double(timestamp_val, end);
-            tick_data.timestamp = get_time_now_nano();
+            tick_data.timestamp = BinanceFastParser::parse_int64(timestamp_val, end) * 1'000'000;
+            message.trace.exchange_time = tick_data.timestamp;
         }
 
         // Extract symbol "c"
@@ -213,7 +245,7 @@ void BinanceDataProcessor::parse_and_publish(const std::string& message) {
                 tick_data.low_24h = BinanceFastParser::parse_double(low_24h_val, end);
             }
         }
-        event_bus_->publish(tick_event);
+        publish_traced(*event_bus_, tick_event, message.trace, tracer_);
 
     }
     else if((strncmp(event_type_val, "kline", 5) == 0 )){
@@ -229,6 +261,11 @@ void BinanceDataProcessor::parse_and_publish(const std::string& message) {
         }
         
         // const char* k_start = BinanceFastParser::find_value_after_key(start, end, "k", 4);
+
+        const char* event_time_val = BinanceFastParser::find_value_after_key(data_start, end, "E", 1);
+        if (event_time_val) {
+            message.trace.exchange_time = BinanceFastParser::parse_int64(event_time_val, end) * 1'000'000;
+        }
        
         // Extract symbol "k.t"
         const char* inteval_val = BinanceFastParser::find_value_after_key(data_start, end, "i", 1);
@@ -311,7 +348,7 @@ void BinanceDataProcessor::parse_and_publish(const std::string& message) {
             }
         }
 
-        event_bus_->publish(candlestick_event);
+        publish_traced(*event_bus_, candlestick_event, message.trace, tracer_);
 
     }
 
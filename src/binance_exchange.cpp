@@ -1,5 +1,6 @@
 #include "binance_exchange.hpp"
 #include <iostream>
+#include "fast_clock.hpp"
 #include <boost/beast/core/buffers_to_string.hpp>
 #include <boost/asio/connect.hpp>
 
@@ -11,9 +12,9 @@ namespace net = boost::asio;
 namespace ssl = net::ssl;
 using tcp = net::ip::tcp;
 
-BinanceExchange::BinanceExchange(SPSCQueue<std::string>& queue)
+BinanceExchange::BinanceExchange(SPSCQueue<RawMessage>& queue)
     : ioc_(), ctx_(ssl::context::tlsv12_client), resolver_(ioc_.get_executor()),
-      ws_(ioc_, ctx_), queue_(queue) {
+      queue_(queue), supervisor_(ioc_, queue, "Binance"), outbound_(ioc_) {
     ctx_.set_default_verify_paths();
     ctx_.set_verify_mode(ssl::verify_none);
 }
@@ -62,64 +63,105 @@ void BinanceExchange::start() {
 
     std::cout << "Connecting to: " << host_ << ":" << port_ << target_ << std::endl;
 
+    // Supervisor callbacks run on the I/O thread, which only exists while the exchange does
+    supervisor_.set_handlers([this] { connect(); }, [this] { teardown(); });
+    outbound_.set_error_handler([this](boost::system::error_code ec) { fail("Write", ec); });
+    supervisor_.start();
+    connect();
+}
+
+// The streams live in the target, so every reconnect replays the subscription
+void BinanceExchange::connect() {
+    ws_.emplace(ioc_, ctx_);
+    buffer_.clear();
     resolver_.async_resolve(host_, port_,
         std::bind_front(&BinanceExchange::on_resolve, shared_from_this()));
 }
 
+void BinanceExchange::teardown() {
+    beast::error_code ignored;
+    resolver_.cancel();
+    outbound_.detach();
+    if (ws_) beast::get_lowest_layer(*ws_).close(ignored);
+}
+
+// Operations aborted by our own teardown report back here too; the supervisor ignores repeats
+void BinanceExchange::fail(const char* what, boost::system::error_code ec) {
+    if (ec == net::error::operation_aborted || supervisor_.stopped()) return;
+    std::cerr << what << ": " << ec.message() << "\n";
+    supervisor_.on_disconnected(std::string(what) + ": " + ec.message());
+}
+
 void BinanceExchange::on_resolve(boost::system::error_code ec, tcp::resolver::results_type results) {
-    if (ec) { std::cerr << "Resolve: " << ec.message() << "\n"; return; }
-    net::async_connect(beast::get_lowest_layer(ws_), results,
+    if (ec) return fail("Resolve", ec);
+    net::async_connect(beast::get_lowest_layer(*ws_).socket(), results,
         std::bind_front(&BinanceExchange::on_connect, shared_from_this()));
 }
 
 void BinanceExchange::on_connect(boost::system::error_code ec, tcp::resolver::results_type::endpoint_type ep) {
-    if (ec) { std::cerr << "Connect: " << ec.message() << "\n"; return; }
+    if (ec) return fail("Connect", ec);
+    beast::get_lowest_layer(*ws_).apply(socket_tuning_, "Binance");
 
     host_header_ = host_;
     if (port_ != "443") host_header_ += ":" + std::to_string(ep.port());
 
-    ws_.set_option(websocket::stream_base::timeout::suggested(beast::role_type::client));
-    ws_.set_option(websocket::stream_base::decorator([](websocket::request_type& req){
+    ws_->set_option(supervisor_.stream_timeout());
+    if (compression_) {
+        // Only an offer: a venue that doesn't support it answers without the extension
+        websocket::permessage_deflate pmd;
+        pmd.client_enable = true;
+        ws_->set_option(pmd);
+    }
+    ws_->set_option(websocket::stream_base::decorator([](websocket::request_type& req){
         req.set(beast::http::field::user_agent, "Binance-Client/1.0");
     }));
 
-    ws_.next_layer().async_handshake(ssl::stream_base::client,
+    ws_->next_layer().async_handshake(ssl::stream_base::client,
         std::bind_front(&BinanceExchange::on_ssl_handshake, shared_from_this()));
 }
 
 void BinanceExchange::on_ssl_handshake(boost::system::error_code ec) {
-    if (ec) { std::cerr << "TLS handshake: " << ec.message() << "\n"; return; }
-    ws_.async_handshake(host_header_, target_.empty() ? "/ws" : target_,
+    if (ec) return fail("TLS handshake", ec);
+    ws_->async_handshake(host_header_, target_.empty() ? "/ws" : target_,
         std::bind_front(&BinanceExchange::on_handshake, shared_from_this()));
 }
 
 void BinanceExchange::on_handshake(boost::system::error_code ec) {
-    if (ec) { std::cerr << "WS handshake: " << ec.message() << "\n"; return; }
+    if (ec) return fail("WS handshake", ec);
     std::cout << "Connected to Binance!\n";
+    outbound_.attach(*ws_);
+    supervisor_.on_connected();
     read_message();
 }
 
 void BinanceExchange::read_message() {
-    ws_.async_read(buffer_, std::bind_front(&BinanceExchange::on_read, shared_from_this()));
+    ws_->async_read(buffer_, std::bind_front(&BinanceExchange::on_read, shared_from_this()));
 }
 
 void BinanceExchange::on_read(boost::system::error_code ec, std::size_t) {
-    if (ec) { std::cerr << "Read: " << ec.message() << "\n"; return; }
-
-    std::string msg = beast::buffers_to_string(buffer_.data());
-    buffer_.consume(buffer_.size());
-    if (!queue_.try_push(std::move(msg))) {
-        std::cerr << "Queue full, dropping message\n";
+    if (ec) return fail("Read", ec);
+
+    RawMessage msg;
+    msg.trace.socket_rx = FastClock::ticks();
+    msg.trace.kernel_rx = beast::get_lowest_layer(*ws_).last_rx_timestamp();
+    msg.payload = buffer_.take();
+    if (!supervisor_.push(std::move(msg))) {
+        // Log the first drop and then every 10000th; a line per drop would stall the reader
+        uint64_t dropped = dropped_messages_.load(std::memory_order_relaxed) + 1;
+        dropped_messages_.store(dropped, std::memory_order_relaxed);
+        if (dropped % 10000 == 1) {
+            std::cerr << "Queue full, dropping message (" << dropped << " dropped)\n";
+        }
     }
 
     read_message();
 }
 
+// Safe from any thread; the message is copied, so the caller's string may go away
 void BinanceExchange::send_message(const std::string& message) {
-    ws_.async_write(net::buffer(message),
-        [](beast::error_code ec, std::size_t) {
-            if (ec) std::cerr << "Write: " << ec.message() << "\n";
-        });
+    if (!outbound_.send(message)) {
+        std::cerr << "Not connected or write queue full, message dropped\n";
+    }
 }
 
 void BinanceExchange::run() {
@@ -128,7 +170,13 @@ void BinanceExchange::run() {
 
 void BinanceExchange::stop() {
     net::post(ioc_, [self = shared_from_this()](){
-        self->ws_.async_close(websocket::close_code::normal,
+        self->supervisor_.stop();
+        self->outbound_.detach();
+        if (!self->ws_ || !self->ws_->is_open()) {
+            self->teardown();
+            return;
+        }
+        self->ws_->async_close(websocket::close_code::normal,
             [self](beast::error_code ec){
                 if (ec) std::cerr << "Close: " << ec.message() << "\n";
                 else std::cout << "Closed cleanly\n";
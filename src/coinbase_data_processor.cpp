@@ -1,5 +1,7 @@
 #include "coinbase_data_processor.hpp"
 #include "coinbase_fast_parser.hpp"
+#include "latency_trace.hpp"
+#include "feed_supervisor.hpp"
 #include <thread>
 #include <iostream>
 #include <boost/json.hpp>
@@ -13,7 +15,7 @@
 namespace json = boost::json;
 static simdjson::ondemand::parser parser;
 
-CoinbaseDataProcessor::CoinbaseDataProcessor(SPSCQueue<std::string>& queue, std::shared_ptr<EventBus> event_bus)
+CoinbaseDataProcessor::CoinbaseDataProcessor(SPSCQueue<RawMessage>& queue, std::shared_ptr<EventBus> event_bus)
     : queue_(queue), event_bus_(event_bus) {}
 
 CoinbaseDataProcessor::~CoinbaseDataProcessor() {
@@ -27,13 +29,17 @@ void CoinbaseDataProcessor::start() {
     }
     running_ = true;
 
-    std::string message;
+    RawMessage message;
     while (running_) {
         if (queue_.try_pop(message)) {
+            message.trace.dequeue = FastClock::ticks();
+            if (message.feed_status) {
+                publish_feed_status(*event_bus_, message, "Coinbase");
+                continue;
+            }
             parse_and_publish(message);
         } else {
-            // Prevent busy-waiting with a short sleep
-            std::this_thread::sleep_for(std::chrono::microseconds(10));
+            idle_wait(wait_strategy_);
         }
     }
 }
@@ -42,9 +48,9 @@ void CoinbaseDataProcessor::stop() {
     running_ = false;
 }
 
-void CoinbaseDataProcessor::parse_and_publish(const std::string& message) {
-    const char* start = message.c_str();
-    const char* end = start + message.length();
+void CoinbaseDataProcessor::parse_and_publish(RawMessage& message) {
+    const char* start = message.payload.c_str();
+    const char* end = start + message.payload.length();
     
     const char* event_type_val = CoinbaseFastParser::find_value_after_key(start, end, "type", 4);
     const char* symbol_val = CoinbaseFastParser::find_value_after_key(start, end, "product_id", 10);
@@ -78,13 +84,21 @@ void CoinbaseDataProcessor::parse_and_publish(const std::string& message) {
         // Extract and parse trade time "time"
         const char* time_val = CoinbaseFastParser::find_value_after_key(start, end, "time", 4);
         if (time_val) {
+            const char* time_end = static_cast<const char*>(memchr(time_val, '"', end - time_val));
+            if (time_end) {
+                trade_data.trade_time = parse_iso8601_nanos(time_val, time_end - time_val);
+                message.trace.exchange_time = trade_data.trade_time;
+            }
+        }
 
-            trade_data.trade_time = get_time_now_nano();
-            // trade_data.trade_time = time_val;
-
+        // "side" is the maker's order; the aggressor took the other side
+        const char* side_val = CoinbaseFastParser::find_value_after_key(start, end, "side", 4);
+        if (side_val) {
+            if (strncmp(side_val, "buy", 3) == 0) trade_data.side = "sell";
+            else if (strncmp(side_val, "sell", 4) == 0) trade_data.side = "buy";
         }
         
-        event_bus_->publish(trade_event);
+        publish_traced(*event_bus_, trade_event, message.trace, tracer_);
     }
     else if (strncmp(event_type_val, "ticker", 6) == 0) {
         TickerDataEvent ticker_event;
@@ -102,10 +116,11 @@ void CoinbaseDataProcessor::parse_and_publish(const std::string& message) {
         // Extract and parse trade time "time"
         const char* time_val = CoinbaseFastParser::find_value_after_key(start, end, "time", 4);
         if (time_val) {
-
-            tick_data.timestamp = get_time_now_nano();
-            // trade_data.trade_time = time_val;
-
+            const char* time_end = static_cast<const char*>(memchr(time_val, '"', end - time_val));
+            if (time_end) {
+                tick_data.timestamp = parse_iso8601_nanos(time_val, time_end - time_val);
+                message.trace.exchange_time = tick_data.timestamp;
+            }
         }
 
 
@@ -203,12 +218,22 @@ void CoinbaseDataProcessor::parse_and_publish(const std::string& message) {
             }
         }
         
-        event_bus_->publish(ticker_event);
+        publish_traced(*event_bus_, ticker_event, message.trace, tracer_);
     }
     else if ((strncmp(event_type_val, "l2update", 8) == 0) ){
         OrderBookDataEvent order_book_event;
-        order_book_event.data = CoinbaseFastParser::parse_depth_update(message.c_str(), strlen(message.c_str()));
-        event_bus_->publish(order_book_event);
+        order_book_event.data = CoinbaseFastParser::parse_depth_update(start, message.payload.length());
+        order_book_event.data.source = "Coinbase";
+        message.trace.exchange_time = order_book_event.data.timestamp;
+        publish_traced(*event_bus_, order_book_event, message.trace, tracer_);
+    }
+    else if (strncmp(event_type_val, "snapshot", 8) == 0) {
+        // Sent on every level2 subscribe; books apply no l2update until one has arrived
+        OrderBookDataEvent order_book_event;
+        order_book_event.data = CoinbaseFastParser::parse_snapshot(start, message.payload.length());
+        order_book_event.data.source = "Coinbase";
+        order_book_event.data.timestamp = FastClock::to_epoch_nanos(message.trace.socket_rx);
+        publish_traced(*event_bus_, order_book_event, message.trace, tracer_);
     }
 }
 
@@ -1,4 +1,4 @@
-#include "CoinbaseExchange.hpp"
+#include "coinbase_exchange.hpp"
 
 #include <boost/asio/connect.hpp>
 #include <boost/beast/ssl.hpp>
@@ -9,11 +9,15 @@
 #include <openssl/buffer.h>
 #include <openssl/evp.h>
 
+#include <iostream>
 #include <sstream>
 #include <iomanip>
 #include <cstring>
 #include <stdexcept>
 
+#include "fast_clock.hpp"
+#include "http_request.hpp"
+
 namespace beast = boost::beast;
 namespace http = beast::http;
 namespace websocket = beast::websocket;
@@ -27,12 +31,13 @@ using tcp = net::ip::tcp;
 // Constructor / Destructor
 //////////////////////////////////////////////////////////////////////////
 
-CoinbaseExchange::CoinbaseExchange(SPSCQueue<std::string>& queue)
+CoinbaseExchange::CoinbaseExchange(SPSCQueue<RawMessage>& queue)
     : ioc_()
     , ctx_(ssl::context::tlsv12_client)
     , resolver_(ioc_.get_executor())
-    , ws_(ioc_, ctx_)
     , queue_(queue)
+    , supervisor_(ioc_, queue, "Coinbase")
+    , outbound_(ioc_)
 {
     ctx_.set_default_verify_paths();
     // For production, DO NOT disable verification. Kept permissive here for convenience during development.
@@ -82,51 +87,44 @@ void CoinbaseExchange::start() {
     if (running_) return;
     running_ = true;
 
-    // Resolve + connect
-    resolver_.async_resolve(host_, port_,
-        std::bind_front(&CoinbaseExchange::on_resolve, shared_from_this()));
-
-    // run io_context in separate thread
-    run_thread_ = std::thread([this]() {
-        try {
-            ioc_.run();
-        } catch (const std::exception &e) {
-            std::cerr << "[CoinbaseExchange] io_context exception: " << e.what() << std::endl;
-        }
+    // Supervisor callbacks run on the I/O thread, which only exists while the exchange does
+    supervisor_.set_handlers([this] { connect(); }, [this] { teardown(); });
+    // level2 has no sequence numbers: after a Gap, only a new subscription brings a fresh snapshot
+    supervisor_.set_resync([this] {
+        send_message(subscription_message("unsubscribe"));
+        send_message(subscription_message("subscribe"));
     });
+    outbound_.set_error_handler([this](boost::system::error_code ec) { fail("Write", ec); });
+    supervisor_.start();
+    connect();
 }
 
+// Blocks on the caller's thread, like the other exchanges; the pipeline owns that thread
 void CoinbaseExchange::run() {
-    // deprecated (we run in background thread)
-    if (!running_) start();
-    if (run_thread_.joinable()) run_thread_.join();
+    ioc_.run();
 }
 
 void CoinbaseExchange::stop() {
     if (!running_) return;
     running_ = false;
 
+    // Once the supervisor's timers and the socket are gone, run() returns
+    // Captures this: the destructor calls stop(), and the handler can't outlive ioc_ anyway
     net::post(ioc_, [this]() {
-        beast::error_code ec;
-        ws_.next_layer().shutdown(ec);
-        ws_.next_layer().next_layer().close(ec);
-        ws_.async_close(websocket::close_code::normal, [this](beast::error_code ec) {
-            if (ec) std::cerr << "[CoinbaseExchange] Close error: " << ec.message() << std::endl;
-        });
+        supervisor_.stop();
+        teardown();
     });
-
-    ioc_.stop();
-    if (run_thread_.joinable()) run_thread_.join();
 }
 
+// Safe from any thread; the message is copied, so the caller's string may go away
 void CoinbaseExchange::send_message(const std::string& message) {
-    net::post(ioc_, [this, message]() {
-        ws_.async_write(net::buffer(message), std::bind_front(&CoinbaseExchange::on_write, shared_from_this()));
-    });
+    if (!outbound_.send(message)) {
+        std::cerr << "[CoinbaseExchange] Not connected or write queue full, message dropped" << std::endl;
+    }
 }
 
 void CoinbaseExchange::read_message() {
-    ws_.async_read(buffer_, std::bind_front(&CoinbaseExchange::on_read, shared_from_this()));
+    ws_->async_read(buffer_, std::bind_front(&CoinbaseExchange::on_read, shared_from_this()));
 }
 
 CoinbaseExchange::OrderBook CoinbaseExchange::snapshot_orderbook() {
@@ -138,68 +136,106 @@ CoinbaseExchange::OrderBook CoinbaseExchange::snapshot_orderbook() {
 // Networking callbacks
 //////////////////////////////////////////////////////////////////////////
 
+void CoinbaseExchange::connect() {
+    ws_.emplace(ioc_, ctx_);
+    buffer_.clear();
+    resolver_.async_resolve(host_, port_,
+        std::bind_front(&CoinbaseExchange::on_resolve, shared_from_this()));
+}
+
+void CoinbaseExchange::teardown() {
+    beast::error_code ignored;
+    resolver_.cancel();
+    outbound_.detach();
+    if (ws_) beast::get_lowest_layer(*ws_).close(ignored);
+}
+
+// Operations aborted by our own teardown report back here too; the supervisor ignores repeats
+void CoinbaseExchange::fail(const char* what, boost::system::error_code ec) {
+    if (ec == net::error::operation_aborted || supervisor_.stopped()) return;
+    std::cerr << "[CoinbaseExchange] " << what << " error: " << ec.message() << std::endl;
+    supervisor_.on_disconnected(std::string(what) + ": " + ec.message());
+}
+
 void CoinbaseExchange::on_resolve(boost::system::error_code ec, tcp::resolver::results_type results) {
-    if (ec) {
-        std::cerr << "[CoinbaseExchange] Resolve error: " << ec.message() << std::endl;
-        return;
-    }
+    if (ec) return fail("Resolve", ec);
 
     // SNI
-    if (!SSL_set_tlsext_host_name(ws_.next_layer().native_handle(), host_.c_str())) {
+    if (!SSL_set_tlsext_host_name(ws_->next_layer().native_handle(), host_.c_str())) {
         beast::error_code ssl_ec{static_cast<int>(::ERR_get_error()), net::error::get_ssl_category()};
-        std::cerr << "[CoinbaseExchange] SSL SNI error: " << ssl_ec.message() << std::endl;
-        return;
+        return fail("SSL SNI", ssl_ec);
     }
 
-    net::async_connect(beast::get_lowest_layer(ws_), results,
+    net::async_connect(beast::get_lowest_layer(*ws_).socket(), results,
         std::bind_front(&CoinbaseExchange::on_connect, shared_from_this()));
 }
 
 void CoinbaseExchange::on_connect(boost::system::error_code ec, tcp::resolver::results_type::endpoint_type ep) {
-    if (ec) {
-        std::cerr << "[CoinbaseExchange] Connect error: " << ec.message() << std::endl;
-        return;
-    }
+    if (ec) return fail("Connect", ec);
+    beast::get_lowest_layer(*ws_).apply(socket_tuning_, "Coinbase");
 
     // handshake TLS
-    ws_.next_layer().async_handshake(ssl::stream_base::client, std::bind_front(&CoinbaseExchange::on_ssl_handshake, shared_from_this()));
+    ws_->next_layer().async_handshake(ssl::stream_base::client, std::bind_front(&CoinbaseExchange::on_ssl_handshake, shared_from_this()));
 }
 
 void CoinbaseExchange::on_ssl_handshake(boost::system::error_code ec) {
-    if (ec) {
-        std::cerr << "[CoinbaseExchange] SSL handshake error: " << ec.message() << std::endl;
-        return;
-    }
+    if (ec) return fail("SSL handshake", ec);
 
     // Set common options
-    ws_.set_option(websocket::stream_base::timeout::suggested(beast::role_type::client));
-    ws_.set_option(websocket::stream_base::decorator([this](websocket::request_type& req) {
+    ws_->set_option(supervisor_.stream_timeout());
+    if (compression_) {
+        // Only an offer: a venue that doesn't support it answers without the extension
+        websocket::permessage_deflate pmd;
+        pmd.client_enable = true;
+        ws_->set_option(pmd);
+    }
+    ws_->set_option(websocket::stream_base::decorator([this](websocket::request_type& req) {
         req.set(http::field::user_agent, "CoinbaseClient/1.0");
         // If you want to set headers per the authentication docs, it's better to include auth fields in the subscribe payload
     }));
 
     // handshake websocket
-    ws_.async_handshake(host_, target_, std::bind_front(&CoinbaseExchange::on_handshake, shared_from_this()));
+    ws_->async_handshake(host_, target_, std::bind_front(&CoinbaseExchange::on_handshake, shared_from_this()));
 }
 
 void CoinbaseExchange::on_handshake(boost::system::error_code ec) {
-    if (ec) {
-        std::cerr << "[CoinbaseExchange] Handshake error: " << ec.message() << std::endl;
-        return;
-    }
+    if (ec) return fail("Handshake", ec);
 
     std::cout << "[CoinbaseExchange] WebSocket connected." << std::endl;
 
-    // Build subscription JSON
+    // Whatever we held is stale after a reconnect; the snapshot fetches below rebuild it
+    {
+        std::lock_guard<std::mutex> lock(orderbook_mutex_);
+        orderbook_.bids.clear();
+        orderbook_.asks.clear();
+        orderbook_.last_sequence = 0;
+    }
+
+    // Rebuilt per connection so the auth timestamp is fresh on every reconnect
+    outbound_.attach(*ws_);
+    send_message(subscription_message("subscribe"));
+    supervisor_.on_connected();
+
+    // For L2: fetch REST snapshot(s) for products BEFORE applying WS updates.
+    // Start snapshot fetches in background threads if multiple products.
+    for (auto &pid : product_ids_) {
+        std::thread([this, pid]() { recover_snapshot_for_product(pid); }).detach();
+    }
+
+    read_message();
+}
+
+// "subscribe" or "unsubscribe" for every product and channel
+std::string CoinbaseExchange::subscription_message(const char* type) const {
     boost::json::object subscribe_msg;
-    subscribe_msg["type"] = "subscribe";
+    subscribe_msg["type"] = type;
 
     // product_ids
     boost::json::array pids;
     if (!product_ids_.empty()) {
         for (auto &p : product_ids_) pids.push_back(p);
-    } else if (subscription_info_.contains("product_ids") && subscription_info_["product_ids"].is_array()) {
-        for (auto &v : subscription_info_["product_ids"].as_array()) pids.push_back(v);
+    } else if (subscription_info_.contains("product_ids") && subscription_info_.at("product_ids").is_array()) {
+        for (auto &v : subscription_info_.at("product_ids").as_array()) pids.push_back(v);
     }
     subscribe_msg["product_ids"] = pids;
 
@@ -207,8 +243,8 @@ void CoinbaseExchange::on_handshake(boost::system::error_code ec) {
     boost::json::array chs;
     if (!channels_.empty()) {
         for (auto &c : channels_) chs.push_back(c);
-    } else if (subscription_info_.contains("channels") && subscription_info_["channels"].is_array()) {
-        for (auto &v : subscription_info_["channels"].as_array()) chs.push_back(v);
+    } else if (subscription_info_.contains("channels") && subscription_info_.at("channels").is_array()) {
+        for (auto &v : subscription_info_.at("channels").as_array()) chs.push_back(v);
     }
     subscribe_msg["channels"] = chs;
 
@@ -225,25 +261,7 @@ void CoinbaseExchange::on_handshake(boost::system::error_code ec) {
         subscribe_msg["passphrase"] = passphrase_;
         subscribe_msg["timestamp"] = timestamp;
     }
-
-    std::string msg = json::serialize(subscribe_msg);
-    send_message(msg);
-
-    // For L2: fetch REST snapshot(s) for products BEFORE applying WS updates.
-    // Start snapshot fetches in background threads if multiple products.
-    for (auto &pid : product_ids_) {
-        std::thread([this, pid]() { recover_snapshot_for_product(pid); }).detach();
-    }
-
-    read_message();
-}
-
-void CoinbaseExchange::on_write(boost::system::error_code ec, std::size_t bytes_transferred) {
-    if (ec) {
-        std::cerr << "[CoinbaseExchange] Write error: " << ec.message() << std::endl;
-        return;
-    }
-    (void)bytes_transferred;
+    return json::serialize(subscribe_msg);
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -251,17 +269,23 @@ void CoinbaseExchange::on_write(boost::system::error_code ec, std::size_t bytes_
 //////////////////////////////////////////////////////////////////////////
 
 void CoinbaseExchange::on_read(boost::system::error_code ec, std::size_t /*bytes_transferred*/) {
-    if (ec) {
-        std::cerr << "[CoinbaseExchange] Read error: " << ec.message() << std::endl;
-        return;
-    }
+    if (ec) return fail("Read", ec);
 
+    uint64_t rx_ticks = FastClock::ticks();
     std::string msg = beast::buffers_to_string(buffer_.data());
     buffer_.consume(buffer_.size());
 
     // Push raw message into queue (so other consumers see raw feed)
-    if (!queue_.try_push(msg)) {
-        std::cerr << "[CoinbaseExchange] Queue full, dropping raw message\n";
+    RawMessage raw{msg, {}};
+    raw.trace.socket_rx = rx_ticks;
+    raw.trace.kernel_rx = beast::get_lowest_layer(*ws_).last_rx_timestamp();
+    if (!supervisor_.push(std::move(raw))) {
+        // Log the first drop and then every 10000th; a line per drop would stall the reader
+        uint64_t dropped = dropped_messages_.load(std::memory_order_relaxed) + 1;
+        dropped_messages_.store(dropped, std::memory_order_relaxed);
+        if (dropped % 10000 == 1) {
+            std::cerr << "[CoinbaseExchange] Queue full, dropping raw message (" << dropped << " dropped)\n";
+        }
     }
 
     // Parse JSON and handle known message types.
@@ -331,7 +355,7 @@ void CoinbaseExchange::handle_l2update_msg(const json::object& obj) {
     std::string product = obj.at("product_id").as_string().c_str();
     int64_t seq = obj.at("sequence").as_int64();
 
-    std::lock_guard<std::mutex> lock(orderbook_mutex_);
+    std::unique_lock<std::mutex> lock(orderbook_mutex_);
     // Ensure we have a base snapshot
     if (orderbook_.last_sequence == 0) {
         // No snapshot loaded yet; fetch now
@@ -375,7 +399,7 @@ void CoinbaseExchange::handle_full_msg(const json::object& obj) {
     std::string product = obj.at("product_id").as_string().c_str();
     int64_t seq = obj.at("sequence").as_int64();
 
-    std::lock_guard<std::mutex> lock(orderbook_mutex_);
+    std::unique_lock<std::mutex> lock(orderbook_mutex_);
     if (orderbook_.last_sequence == 0) {
         lock.unlock();
         recover_snapshot_for_product(product);
@@ -5,7 +5,7 @@
 
 namespace json = boost::json;
 
-CoinbasePipeline::CoinbasePipeline(SPSCQueue<std::string>& queue, std::shared_ptr<EventBus> event_bus)
+CoinbasePipeline::CoinbasePipeline(SPSCQueue<RawMessage>& queue, std::shared_ptr<EventBus> event_bus)
     : queue_(queue), exchange_(std::make_shared<CoinbaseExchange>(queue)), 
       data_parser_(queue, event_bus), event_bus_(event_bus) {}
 
@@ -16,7 +16,8 @@ CoinbasePipeline::~CoinbasePipeline() {
 void CoinbasePipeline::initialize(const std::string& host, const std::string& port,
                                 const std::string& target, const boost::json::object& subscription_info) {
     exchange_->initialize(host, port, target, subscription_info);
-    name = "coinbase";
+    // Same as the source field of the events its processor publishes
+    name = "Coinbase";
 
 }
 
@@ -54,14 +55,12 @@ void CoinbasePipeline::start() {
 
     // Pin the network I/O thread, which is the most latency-sensitive.
     if (exchange_thread_.joinable()) {
-        pin_thread_to_cpu(exchange_thread_, 4);
-        std::cout << "Pinned exchange thread to CPU 1." << std::endl;
+        pin_thread(exchange_thread_, exchange_placement_);
     }
 
     // Pin the data parsing thread to a different core to run in parallel without contention.
     if (parser_thread_.joinable()) {
-        pin_thread_to_cpu(parser_thread_, 5);
-        std::cout << "Pinned parser thread to CPU 2." << std::endl;
+        pin_thread(parser_thread_, parser_placement_);
     }
 
 
@@ -1,5 +1,7 @@
-#include "KrakenDataProcessor.hpp"
-#include "KrakenFastParser.hpp"
+#include "kraken_data_processor.hpp"
+#include "kraken_fast_parser.hpp"
+#include "latency_trace.hpp"
+#include "feed_supervisor.hpp"
 #include <thread>
 #include <iostream>
 #include <boost/json.hpp>
@@ -11,7 +13,7 @@
 
 namespace json = boost::json;
 
-KrakenDataProcessor::KrakenDataProcessor(SPSCQueue<std::string>& queue, std::shared_ptr<EventBus> event_bus)
+KrakenDataProcessor::KrakenDataProcessor(SPSCQueue<RawMessage>& queue, std::shared_ptr<EventBus> event_bus)
     : queue_(queue), event_bus_(event_bus) {}
 
 KrakenDataProcessor::~KrakenDataProcessor() {
@@ -25,13 +27,17 @@ void KrakenDataProcessor::start() {
     }
     running_ = true;
 
-    std::string message;
+    RawMessage message;
     while (running_) {
         if (queue_.try_pop(message)) {
+            message.trace.dequeue = FastClock::ticks();
+            if (message.feed_status) {
+                publish_feed_status(*event_bus_, message, "Kraken");
+                continue;
+            }
             parse_and_publish(message);
         } else {
-            // Prevent busy-waiting with a short sleep
-            std::this_thread::sleep_for(std::chrono::microseconds(10));
+            idle_wait(wait_strategy_);
         }
     }
 }
@@ -40,9 +46,9 @@ void KrakenDataProcessor::stop() {
     running_ = false;
 }
 
-void KrakenDataProcessor::parse_and_publish(const std::string& message){
-    const char* start = message.c_str();
-    const char* end = start + message.length();
+void KrakenDataProcessor::parse_and_publish(RawMessage& message){
+    const char* start = message.payload.c_str();
+    const char* end = start + message.payload.length();
 
     const char* channel_val = KrakenFastParser::find_value_after_key(start, end, "channel", 7);
     const char* type_val = KrakenFastParser::find_value_after_key(start, end, "type", 4);
@@ -55,8 +61,6 @@ void KrakenDataProcessor::parse_and_publish(const std::string& message){
             TradeEvent trade_event;
             TradeData& trade_data = trade_event.data;
 
-            trade_data.trade_time = get_time_now_nano();
-
             const char* data_start = KrakenFastParser::find_value_after_key(start, end, "data", 4);
            
             if (data_start) {
@@ -70,6 +74,7 @@ void KrakenDataProcessor::parse_and_publish(const std::string& message){
                         const char* side_start = KrakenFastParser::find_value_after_key(p, end, "side", 4);
                         const char* price_start = KrakenFastParser::find_value_after_key(p, end, "price", 5);
                         const char* qty_start = KrakenFastParser::find_value_after_key(p, end, "qty", 3);
+                        const char* time_start = KrakenFastParser::find_value_after_key(p, end, "timestamp", 9);
 
                         if (symbol_start) {
                             const char* symbol_end = symbol_start;
@@ -92,7 +97,15 @@ void KrakenDataProcessor::parse_and_publish(const std::string& message){
                             trade_data.quantity = KrakenFastParser::parse_double(qty_start, qty_end);
                         }
 
-                        event_bus_->publish(trade_event);
+                        if (time_start) {
+                            const char* time_end = static_cast<const char*>(memchr(time_start, '"', end - time_start));
+                            if (time_end) {
+                                trade_data.trade_time = KrakenFastParser::parse_kraken_timestamp(time_start, time_end - time_start);
+                                message.trace.exchange_time = trade_data.trade_time;
+                            }
+                        }
+
+                        publish_traced(*event_bus_, trade_event, message.trace, tracer_);
 
                         // Find the end of the current object
                         const char* obj_end = qty_start;
@@ -224,6 +237,7 @@ void KrakenDataProcessor::parse_and_publish(const std::string& message){
                             const char* close_time_end = static_cast<const char*>(memchr(close_time_val + 1, '"', obj_end - (close_time_val + 1)));
                             if (close_time_end) {
                                 candle_data.close_time = KrakenFastParser::parse_kraken_timestamp(close_time_val + 1, close_time_end - (close_time_val + 1));
+                                message.trace.exchange_time = candle_data.close_time;
                             }
                         } else {
                             const char* close_time_end = close_time_val;
@@ -231,14 +245,15 @@ void KrakenDataProcessor::parse_and_publish(const std::string& message){
                                 ++close_time_end;
                             }
                             candle_data.close_time = KrakenFastParser::parse_int64(close_time_val, close_time_end);
+                            message.trace.exchange_time = candle_data.close_time;
                         }
                     }
                     
                     // Set source field
-                    candle_data.source = std::string_view("kraken", 6);
+                    candle_data.source = "Kraken";
                 }
             }
-            event_bus_->publish(candlestick_event);
+            publish_traced(*event_bus_, candlestick_event, message.trace, tracer_);
         }
 
         else if(channel_sv == "ticker") {
@@ -249,8 +264,8 @@ void KrakenDataProcessor::parse_and_publish(const std::string& message){
             if (data_start) {
                 const char* ticker_obj_start = static_cast<const char*>(memchr(data_start, '{', end - data_start));
                 if (ticker_obj_start) {
-                    // Update timestamp
-                    ticker_data.timestamp = get_time_now_nano();
+                    // Kraken tickers carry no exchange timestamp, stamp the local receive time
+                    ticker_data.timestamp = FastClock::to_epoch_nanos(message.trace.socket_rx);
                     
                     // Parse symbol
                     const char* symbol_val = KrakenFastParser::find_value_after_key(ticker_obj_start, end, "symbol", 6);
@@ -332,13 +347,16 @@ void KrakenDataProcessor::parse_and_publish(const std::string& message){
                     }
                 }
             }
-            event_bus_->publish(ticker_data_event);
+            publish_traced(*event_bus_, ticker_data_event, message.trace, tracer_);
         }
 
         else if(channel_sv == "book"){
             OrderBookDataEvent order_book_event;
             OrderBookData& order_book_data = order_book_event.data;
-            order_book_data.timestamp = get_time_now_nano();
+            order_book_data.source = "Kraken";
+            // Sent on every (re)subscribe: replaces the book rather than patching it
+            const char* type_val = KrakenFastParser::find_value_after_key(start, end, "type", 4);
+            order_book_data.snapshot = type_val && end - type_val > 8 && memcmp(type_val, "snapshot", 8) == 0;
 
             const char* data_start = KrakenFastParser::find_value_after_key(start, end, "data", 4);
             if (data_start) {
@@ -368,6 +386,16 @@ void KrakenDataProcessor::parse_and_publish(const std::string& message){
                         order_book_data.symbol = std::string_view(symbol_val, symbol_end - symbol_val);
                     }
 
+                    // Book updates carry the exchange timestamp, snapshots don't
+                    const char* time_val = KrakenFastParser::find_value_after_key(book_obj_start, book_obj_end, "timestamp", 9);
+                    if (time_val) {
+                        const char* time_end = static_cast<const char*>(memchr(time_val, '"', book_obj_end - time_val));
+                        if (time_end) {
+                            order_book_data.timestamp = KrakenFastParser::parse_kraken_timestamp(time_val, time_end - time_val);
+                            message.trace.exchange_time = order_book_data.timestamp;
+                        }
+                    }
+
                     // Parse bids
                     const char* bids_start = KrakenFastParser::find_value_after_key(book_obj_start, book_obj_end, "bids", 4);
                     if (bids_start) {
@@ -419,7 +447,7 @@ void KrakenDataProcessor::parse_and_publish(const std::string& message){
                     }
                 }
             }
-            event_bus_->publish(order_book_event);
+            publish_traced(*event_bus_, order_book_event, message.trace, tracer_);
         }
     }
 }
\ No newline at end of file
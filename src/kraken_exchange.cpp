@@ -1,5 +1,6 @@
-#include "KrakenExchange.hpp"
+#include "kraken_exchange.hpp"
 #include <iostream>
+#include "fast_clock.hpp"
 #include <boost/beast/core/buffers_to_string.hpp>
 #include <boost/asio/connect.hpp>
 
@@ -11,9 +12,9 @@ namespace net = boost::asio;
 namespace ssl = net::ssl;
 using tcp = net::ip::tcp;
 
-KrakenExchange::KrakenExchange(SPSCQueue<std::string>& queue)
+KrakenExchange::KrakenExchange(SPSCQueue<RawMessage>& queue)
     : ioc_(), ctx_(ssl::context::tlsv12_client), resolver_(ioc_.get_executor()),
-      ws_(ioc_, ctx_), queue_(queue) {
+      queue_(queue), supervisor_(ioc_, queue, "Kraken"), outbound_(ioc_) {
     ctx_.set_default_verify_paths();
     ctx_.set_verify_mode(ssl::verify_none);
 }
@@ -58,56 +59,88 @@ void KrakenExchange::start() {
     } else {
         throw std::runtime_error("Kraken: subscription_info must be an object");
     }
+    subscription_message_ = json::serialize(subscription_info_);
+    json::object unsubscribe = subscription_info_;
+    unsubscribe["method"] = "unsubscribe";
+    unsubscription_message_ = json::serialize(unsubscribe);
+
+    // Supervisor callbacks run on the I/O thread, which only exists while the exchange does
+    supervisor_.set_handlers([this] { connect(); }, [this] { teardown(); });
+    // Book updates carry no sequence numbers, so after a Gap the book needs a new snapshot, and
+    // Kraken only sends one for a fresh subscription (a second subscribe is refused)
+    supervisor_.set_resync([this] {
+        send_message(unsubscription_message_);
+        send_message(subscription_message_);
+    });
+    outbound_.set_error_handler([this](boost::system::error_code ec) { fail("Write", ec); });
+    supervisor_.start();
+    connect();
+}
+
+void KrakenExchange::connect() {
+    ws_.emplace(ioc_, ctx_);
+    buffer_.clear();
     resolver_.async_resolve(host_, port_,
         std::bind_front(&KrakenExchange::on_resolve, shared_from_this()));
 }
 
+void KrakenExchange::teardown() {
+    beast::error_code ignored;
+    resolver_.cancel();
+    outbound_.detach();
+    if (ws_) beast::get_lowest_layer(*ws_).close(ignored);
+}
+
+// Operations aborted by our own teardown report back here too; the supervisor ignores repeats
+void KrakenExchange::fail(const char* what, boost::system::error_code ec) {
+    if (ec == net::error::operation_aborted || supervisor_.stopped()) return;
+    std::cerr << what << " error: " << ec.message() << std::endl;
+    supervisor_.on_disconnected(std::string(what) + ": " + ec.message());
+}
+
 void KrakenExchange::on_resolve(boost::system::error_code ec, tcp::resolver::results_type results) {
-    if (ec) {
-        std::cerr << "Resolve error: " << ec.message() << std::endl;
-        return;
-    }
+    if (ec) return fail("Resolve", ec);
 
-    if (!SSL_set_tlsext_host_name(ws_.next_layer().native_handle(), host_.c_str())) {
+    if (!SSL_set_tlsext_host_name(ws_->next_layer().native_handle(), host_.c_str())) {
         beast::error_code ssl_ec{static_cast<int>(::ERR_get_error()), net::error::get_ssl_category()};
-        std::cerr << "SSL SNI error: " << ssl_ec.message() << std::endl;
-        return;
+        return fail("SSL SNI", ssl_ec);
     }
 
     net::async_connect(
-        beast::get_lowest_layer(ws_), results,
-        std::bind_front(&KrakenExchange::on_connect, this));
+        beast::get_lowest_layer(*ws_).socket(), results,
+        std::bind_front(&KrakenExchange::on_connect, shared_from_this()));
 }
 
 void KrakenExchange::on_connect(boost::system::error_code ec, tcp::resolver::results_type::endpoint_type ep) {
-    if (ec) {
-        std::cerr << "Connect error: " << ec.message() << std::endl;
-        return;
-    }
+    if (ec) return fail("Connect", ec);
+    beast::get_lowest_layer(*ws_).apply(socket_tuning_, "Kraken");
 
-    ws_.next_layer().async_handshake(
+    ws_->next_layer().async_handshake(
         ssl::stream_base::client,
-        std::bind_front(&KrakenExchange::on_ssl_handshake, this));
+        std::bind_front(&KrakenExchange::on_ssl_handshake, shared_from_this()));
 }
 
 void KrakenExchange::on_ssl_handshake(boost::system::error_code ec) {
-    if (ec) {
-        std::cerr << "SSL handshake error: " << ec.message() << std::endl;
-        return;
+    if (ec) return fail("SSL handshake", ec);
+
+    ws_->set_option(supervisor_.stream_timeout());
+    if (compression_) {
+        // Only an offer: a venue that doesn't support it answers without the extension
+        websocket::permessage_deflate pmd;
+        pmd.client_enable = true;
+        ws_->set_option(pmd);
     }
-
-    ws_.set_option(websocket::stream_base::timeout::suggested(beast::role_type::client));
-    ws_.set_option(websocket::stream_base::decorator(
+    ws_->set_option(websocket::stream_base::decorator(
         [this](websocket::request_type& req) {
             req.set(http::field::user_agent, "Kraken-Client/1.0");
         }));
 
-    ws_.async_handshake(host_, target_,
-        std::bind_front(&KrakenExchange::on_handshake, this));
+    ws_->async_handshake(host_, target_,
+        std::bind_front(&KrakenExchange::on_handshake, shared_from_this()));
 }
 
 void KrakenExchange::on_handshake(boost::system::error_code ec) {
-    if (ec) { std::cerr << "WS handshake: " << ec.message() << "\n"; return; }
+    if (ec) return fail("WS handshake", ec);
     std::cout << "Connected to Kraken!\n";
 
     //     // Send single subscription message (like Coinbase)
@@ -130,32 +163,41 @@ void KrakenExchange::on_handshake(boost::system::error_code ec) {
     //         send_message(msg);
     //     }
     
-    std::string msg = json::serialize(subscription_info_);
-    send_message(msg);
+    // Resent on every reconnect; the snapshot that follows rebuilds the book
+    outbound_.attach(*ws_);
+    send_message(subscription_message_);
+    supervisor_.on_connected();
     read_message();
 }
 
 void KrakenExchange::read_message() {
-    ws_.async_read(buffer_, std::bind_front(&KrakenExchange::on_read, shared_from_this()));
+    ws_->async_read(buffer_, std::bind_front(&KrakenExchange::on_read, shared_from_this()));
 }
 
 void KrakenExchange::on_read(boost::system::error_code ec, std::size_t) {
-    if (ec) { std::cerr << "Read: " << ec.message() << "\n"; return; }
-
-    std::string msg = beast::buffers_to_string(buffer_.data());
-    buffer_.consume(buffer_.size());
-    if (!queue_.try_push(std::move(msg))) {
-        std::cerr << "Queue full, dropping message\n";
+    if (ec) return fail("Read", ec);
+
+    RawMessage msg;
+    msg.trace.socket_rx = FastClock::ticks();
+    msg.trace.kernel_rx = beast::get_lowest_layer(*ws_).last_rx_timestamp();
+    msg.payload = buffer_.take();
+    if (!supervisor_.push(std::move(msg))) {
+        // Log the first drop and then every 10000th; a line per drop would stall the reader
+        uint64_t dropped = dropped_messages_.load(std::memory_order_relaxed) + 1;
+        dropped_messages_.store(dropped, std::memory_order_relaxed);
+        if (dropped % 10000 == 1) {
+            std::cerr << "Queue full, dropping message (" << dropped << " dropped)\n";
+        }
     }
 
     read_message();
 }
 
+// Safe from any thread; the message is copied, so the caller's string may go away
 void KrakenExchange::send_message(const std::string& message) {
-    ws_.async_write(net::buffer(message),
-        [](beast::error_code ec, std::size_t) {
-            if (ec) std::cerr << "Write: " << ec.message() << "\n";
-        });
+    if (!outbound_.send(message)) {
+        std::cerr << "Not connected or write queue full, message dropped\n";
+    }
 }
 
 void KrakenExchange::run() {
@@ -164,7 +206,13 @@ void KrakenExchange::run() {
 
 void KrakenExchange::stop() {
     net::post(ioc_, [self = shared_from_this()](){
-        self->ws_.async_close(websocket::close_code::normal,
+        self->supervisor_.stop();
+        self->outbound_.detach();
+        if (!self->ws_ || !self->ws_->is_open()) {
+            self->teardown();
+            return;
+        }
+        self->ws_->async_close(websocket::close_code::normal,
             [self](beast::error_code ec){
                 if (ec) std::cerr << "Close: " << ec.message() << "\n";
                 else std::cout << "Closed\n";
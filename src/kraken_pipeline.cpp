@@ -4,7 +4,7 @@
 
 namespace json = boost::json;
 
-KrakenPipeline::KrakenPipeline(SPSCQueue<std::string>& queue, std::shared_ptr<EventBus> event_bus)
+KrakenPipeline::KrakenPipeline(SPSCQueue<RawMessage>& queue, std::shared_ptr<EventBus> event_bus)
     : queue_(queue), exchange_(std::make_shared<KrakenExchange>(queue)), 
       data_parser_(queue, event_bus), event_bus_(event_bus) {}
 
@@ -15,7 +15,8 @@ KrakenPipeline::~KrakenPipeline() {
 void KrakenPipeline::initialize(const std::string& host, const std::string& port,
                                 const std::string& target, const boost::json::object& subscription_info) {
     exchange_->initialize(host, port, target, subscription_info);
-    name = "kraken";
+    // Same as the source field of the events its processor publishes
+    name = "Kraken";
 
 }
 
@@ -51,6 +52,10 @@ void KrakenPipeline::start() {
         }
     });
 
+    // Unpinned unless set_thread_placement() says otherwise
+    pin_thread(exchange_thread_, exchange_placement_);
+    pin_thread(parser_thread_, parser_placement_);
+
     std::cout << "KrakenPipeline started with market feed and processor threads." << std::endl;
 }
 
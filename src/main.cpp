@@ -1,15 +1,21 @@
-#include "binance_pipeline.hpp"
-#include "coinbase_pipeline.hpp"
-#include "KrakenPipeline.hpp"
-#include "SPSCQueue.hpp"
-#include "EventBus.hpp"
+#include <algorithm>
 #include <iostream>
-#include <boost/json.hpp>
 #include <csignal>
 #include <memory>
-#include <Logger.hpp>
-#include "strats/simple_cross_exchange_arb.hpp"
-namespace json = boost::json;
+#include <thread>
+#include <chrono>
+#include "event_bus.hpp"
+#include "logger.hpp"
+#include "topology.hpp"
+#include "candle_aggregator.hpp"
+#include "instrument_registry.hpp"
+#include "risk_checked_router.hpp"
+#include "risk_engine.hpp"
+#include "strats/arb_scanner_strat.hpp"
+#include "strats/pair_trading_strat.hpp"
+#include "strats/simple_cross_exchange_arb_strat.hpp"
+#include "strats/triangular_arb_strat.hpp"
+#include "fast_clock.hpp"
 
 volatile sig_atomic_t g_running = 1;
 
@@ -17,91 +23,142 @@ void signal_handler(int) {
     g_running = 0;
 }
 
-int main() {
+// Usage: main [topology.json], see TopologyConfig for the format
+int main(int argc, char** argv) {
     try {
+        const std::string config_path = argc > 1 ? argv[1] : "config/topology.json";
+        TopologyConfig config = TopologyConfig::load(config_path);
+
         // Set up signal handling for graceful shutdown
         std::signal(SIGINT, signal_handler);
         std::signal(SIGTERM, signal_handler);
 
-        // Create queue and event bus
-        SPSCQueue<std::string> binance_queue(8192); 
-        SPSCQueue<std::string> coinbase_queue(8192); 
+        // Calibrate the TSC clock before any feed stamps a message, then keep it anchored to wall time
+        FastClock::start_calibration_thread();
 
         auto event_bus = std::make_shared<EventBus>();
 
-        Logger::init("logs/events.log");
+        Logger::init(config.log_file, config.logger_cpu);
 
         Logger& logger = Logger::getInstance();
         
         logger.subscribeToBus(event_bus);
 
-        auto execution_router = std::make_shared<IExcecutionRouter>();
-
-
-
-        BinancePipeline binance_pipeline(binance_queue, event_bus);
-        CoinbasePipeline coinbase_pipeline(coinbase_queue, event_bus);
-        // KrakenPipeline pipeline(queue, event_bus);
-
-        json::object binance_subscription_info = {
-            // {"streams", json::array{"ethusdt@trade"}}
-            {"streams", json::array{"btcusdt@depth@100ms"}}
-            // {"streams", json::array{"btcusdt@ticker"}}
-            // {"streams", json::array{"btcusdt@kline_1s"}}
-
-        };
-
-        json::object coinbase_subscription_info = {
-            {"product_ids", json::array{"BTC-USD"}},
-            // {"channels", json::array{"matches"}}
-            {"channels", json::array{"level2_batch"}}
-            // {"channels", json::array{"ticker"}}
-
-        };
-
-        // json::object subscription_info = {
-        //     {"symbol", json::array{"BTC/USD", "MATIC/GBP"}},
-        //     {"channel", json::array{"trade"}}
-
-        // };
+        // Queues and pipelines, configured and initialized but not started
+        Topology topology(config, event_bus);
 
-        boost::json::object subscription_info;
-        subscription_info["method"] = "subscribe";
-
-        boost::json::object params;
-        params["channel"] = "trade";   // channel type
-        params["symbol"] = json::array{ "BTC/USD" }; // symbols as array
-
-        subscription_info["params"] = params;
-
-        binance_pipeline.initialize("stream.binance.com", "443", "/ws", binance_subscription_info);
+        // Every (venue, symbol) the pipelines stream, under the source name their events carry
+        InstrumentRegistry instruments;
+        for (const auto& p : config.pipelines) {
+            for (const auto& symbol : p.symbols) instruments.add(topology.pipeline(p.venue)->name, symbol);
+        }
 
-        coinbase_pipeline.initialize("ws-feed.exchange.coinbase.com", "443", "/", coinbase_subscription_info);
+        // Strategies route through the risk checks; nothing sits behind them yet, so accepted
+        // orders stop at the base router
+        auto risk_engine = std::make_unique<RiskEngine>();
+        for (uint32_t id = 0; id < instruments.size(); ++id) {
+            risk_engine->set_limits(id, config.risk);
+        }
+        risk_engine->subscribe_to_bus(event_bus, instruments);
+        auto execution_router = std::make_shared<RiskCheckedRouter>(*risk_engine, std::make_shared<IExcecutionRouter>());
+
+        // Local candles from trades, built on this thread and published like the venues' own
+        std::unique_ptr<TradeCandles> candles;
+        if (!config.candles.empty()) {
+            std::vector<BarSpec> specs;
+            for (const auto& c : config.candles) specs.push_back(BarSpec::parse(c));
+            candles = std::make_unique<TradeCandles>(event_bus, instruments, specs);
+        }
 
-        int16_t diff_percent = 0.00001; 
-        CrossExchangeArb arbitrage_strategy(
-            event_bus,
-            logger, // Pass the logger reference
-            execution_router,
-            binance_pipeline,
-            coinbase_pipeline,
-            diff_percent);
-            
-        arbitrage_strategy.start();
+        std::vector<std::unique_ptr<IStrategy>> strategies;
+        for (const auto& s : config.strategies) {
+            if (s.type == "arb_scanner") {
+                std::vector<IPipeline*> pipelines;
+                for (const auto& venue : s.pipelines) pipelines.push_back(topology.pipeline(venue));
+                std::vector<ScanRow> rows;
+                for (const auto& i : s.instruments) rows.push_back(ScanRow{i.name, i.symbols});
+                strategies.push_back(std::make_unique<ArbScannerStrat>(
+                    event_bus,
+                    logger,
+                    execution_router,
+                    std::move(pipelines),
+                    std::move(rows),
+                    s.fees,
+                    s.diff_percent,
+                    s.top_n));
+                continue;
+            }
+            if (s.type == "pair_trading") {
+                std::vector<IPipeline*> pipelines;
+                for (const auto& venue : s.pipelines) pipelines.push_back(topology.pipeline(venue));
+                std::vector<PairSpec> pairs;
+                for (const auto& p : s.pairs) {
+                    pairs.push_back(PairSpec{topology.pipeline(p.y_venue)->name, p.y_symbol,
+                                             topology.pipeline(p.x_venue)->name, p.x_symbol});
+                }
+                strategies.push_back(std::make_unique<PairTradingStrat>(
+                    event_bus,
+                    logger,
+                    execution_router,
+                    std::move(pipelines),
+                    pairs,
+                    s.window,
+                    s.entry_z,
+                    s.exit_z));
+                continue;
+            }
+            if (s.type == "triangular_arb") {
+                auto p = std::find_if(config.pipelines.begin(), config.pipelines.end(),
+                                      [&](const PipelineConfig& p) { return p.venue == s.pipelines[0]; });
+                strategies.push_back(std::make_unique<TriangularArbStrat>(
+                    event_bus,
+                    logger,
+                    execution_router,
+                    *topology.pipeline(s.pipelines[0]),
+                    p->symbols,
+                    s.fee,
+                    s.diff_percent));
+                continue;
+            }
+            strategies.push_back(std::make_unique<CrossExchangeArb>(
+                event_bus,
+                logger,
+                execution_router,
+                *topology.pipeline(s.pipelines[0]),
+                *topology.pipeline(s.pipelines[1]),
+                s.symbols[0],
+                s.symbols[1],
+                s.diff_percent,
+                s.fee));
+        }
 
-        // // Start pipeline
-        // binance_pipeline.start();
-        // coinbase_pipeline.start();
+        // Strategies start the pipelines they read
+        for (auto& strategy : strategies) {
+            strategy->start();
+        }
+        topology.start_unowned();
 
         // Run until interrupted
+        const int64_t candle_delay = config.candle_delay_ms * 1'000'000;
         while (g_running) {
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            if (candles) {
+                candles->poll(FastClock::now_nanos() - candle_delay, [&](const CandleStickData& candle) {
+                    event_bus->publish(CandleStickDataEvent{{}, candle});
+                });
+            }
         }
 
         // Stop pipeline
         std::cout << "Shutting down..." << std::endl;
-        binance_pipeline.stop();
-        coinbase_pipeline.stop();
+        for (auto& strategy : strategies) {
+            strategy->stop();
+        }
+        topology.stop();
+        FastClock::stop_calibration_thread();
+
+        // Per-stage socket-to-handler latency, in nanoseconds
+        topology.export_summary(std::cout);
 
         return 0;
     } catch (const std::exception& e) {
@@ -0,0 +1,411 @@
+#include "multi_stream_connector.hpp"
+#include <iostream>
+#include <optional>
+#include <boost/asio/connect.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/ssl.hpp>
+#include <boost/beast/websocket.hpp>
+#include <boost/beast/websocket/ssl.hpp>
+#include <boost/json.hpp>
+#include "fast_clock.hpp"
+#include "outbound_queue.hpp"
+#include "payload_buffer.hpp"
+#include "utils.hpp"
+
+namespace beast = boost::beast;
+namespace websocket = beast::websocket;
+namespace net = boost::asio;
+namespace ssl = net::ssl;
+namespace json = boost::json;
+using tcp = net::ip::tcp;
+
+//////////////////////////////////////////////////////////////////////////
+// Venue protocols
+//////////////////////////////////////////////////////////////////////////
+
+VenueProtocol VenueProtocol::binance() {
+    VenueProtocol p;
+    p.name = "binance";
+    p.host = "stream.binance.com";
+    p.port = "9443";
+    p.target = "/stream";
+    p.max_streams_per_connection = 1024; // Binance's documented cap per connection
+    p.max_connections = 300;             // Connection attempts allowed per 5 minutes per IP
+    // Subscribing by message rather than URL keeps the handshake target short for large shards
+    p.make_subscription = [](const std::vector<std::string>& streams) {
+        json::array params;
+        for (const auto& s : streams) params.emplace_back(s);
+        return json::serialize(json::object{{"method", "SUBSCRIBE"}, {"params", params}, {"id", 1}});
+    };
+    p.dedup_key = &FeedArbiter::binance_key;
+    return p;
+}
+
+VenueProtocol VenueProtocol::coinbase(const std::vector<std::string>& channels) {
+    VenueProtocol p;
+    p.name = "coinbase";
+    p.host = "ws-feed.exchange.coinbase.com";
+    p.port = "443";
+    p.target = "/";
+    p.max_streams_per_connection = 100;  // No published cap; keeps level2 bursts per socket bounded
+    p.max_connections = 50;
+    auto message = [channels](const char* type, const std::vector<std::string>& product_ids) {
+        json::array products;
+        for (const auto& id : product_ids) products.emplace_back(id);
+        json::array chs;
+        for (const auto& c : channels) chs.emplace_back(c);
+        return json::serialize(json::object{{"type", type}, {"product_ids", products}, {"channels", chs}});
+    };
+    p.make_subscription = [message](const std::vector<std::string>& ids) { return message("subscribe", ids); };
+    p.make_unsubscription = [message](const std::vector<std::string>& ids) { return message("unsubscribe", ids); };
+    p.dedup_key = &FeedArbiter::coinbase_key;
+    return p;
+}
+
+VenueProtocol VenueProtocol::kraken(const std::string& channel) {
+    VenueProtocol p;
+    p.name = "kraken";
+    p.host = "ws.kraken.com";
+    p.port = "443";
+    p.target = "/v2";
+    p.max_streams_per_connection = 100;  // No published cap; same reasoning as Coinbase
+    p.max_connections = 50;
+    auto message = [channel](const char* method, const std::vector<std::string>& symbols) {
+        json::array syms;
+        for (const auto& s : symbols) syms.emplace_back(s);
+        json::object params{{"channel", channel}, {"symbol", syms}};
+        return json::serialize(json::object{{"method", method}, {"params", params}});
+    };
+    // Kraken refuses a second subscribe to the same channel, so a resync unsubscribes first
+    p.make_subscription = [message](const std::vector<std::string>& symbols) { return message("subscribe", symbols); };
+    p.make_unsubscription = [message](const std::vector<std::string>& symbols) { return message("unsubscribe", symbols); };
+    p.dedup_key = &FeedArbiter::kraken_key;
+    return p;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Connection
+//////////////////////////////////////////////////////////////////////////
+
+class MultiStreamConnector::Connection : public std::enable_shared_from_this<MultiStreamConnector::Connection> {
+public:
+    Connection(MultiStreamConnector& owner, uint32_t index, uint32_t shard, std::string local_address)
+        : owner_(owner), index_(index), shard_(shard), local_address_(std::move(local_address)),
+          resolver_(owner.ioc_),
+          supervisor_(owner.ioc_, *owner.queues_[shard % owner.queues_.size()],
+                      owner.protocol_.name + "#" + std::to_string(index), owner.reconnect_policy_),
+          outbound_(owner.ioc_, 8) {
+        supervisor_.set_connection(index);
+        supervisor_.set_status_gate([this](FeedState state) { return gate_status(state); });
+    }
+
+    void start() {
+        // Supervisor callbacks run on the I/O thread, which only exists while the connector does
+        supervisor_.set_handlers([this] { connect(); }, [this] { teardown(); });
+        if (owner_.protocol_.make_unsubscription) {
+            supervisor_.set_resync([this] { resubscribe(); });
+        }
+        outbound_.set_error_handler([this](beast::error_code ec) { fail("Write", ec); });
+        supervisor_.start();
+        connect();
+    }
+
+    void close() {
+        supervisor_.stop();
+        if (!ws_ || !ws_->is_open()) {
+            teardown();
+            return;
+        }
+        ws_->async_close(websocket::close_code::normal,
+            [self = shared_from_this()](beast::error_code ec) {
+                if (ec) self->log_error("Close", ec);
+                self->teardown();
+            });
+    }
+
+private:
+    // Every attempt gets a fresh stream and resends the shard's subscription
+    void connect() {
+        ws_.emplace(owner_.ioc_, owner_.ssl_ctx_);
+        buffer_.clear();
+        resolver_.async_resolve(owner_.protocol_.host, owner_.protocol_.port,
+            beast::bind_front_handler(&Connection::on_resolve, shared_from_this()));
+    }
+
+    void teardown() {
+        beast::error_code ignored;
+        resolver_.cancel();
+        outbound_.detach();
+        if (ws_) beast::get_lowest_layer(*ws_).close(ignored);
+        mark_closed();
+    }
+
+    // Operations aborted by our own teardown report back here too; the supervisor ignores repeats
+    void fail(const char* what, beast::error_code ec) {
+        if (ec == net::error::operation_aborted || supervisor_.stopped()) return;
+        log_error(what, ec);
+        supervisor_.on_disconnected(std::string(what) + ": " + ec.message());
+    }
+
+    void on_resolve(beast::error_code ec, tcp::resolver::results_type results) {
+        if (ec) return fail("Resolve", ec);
+        if (local_address_.empty()) {
+            net::async_connect(beast::get_lowest_layer(*ws_).socket(), results,
+                beast::bind_front_handler(&Connection::on_connect, shared_from_this()));
+            return;
+        }
+
+        // async_connect over a range reopens the socket per endpoint, losing the bind, so
+        // connect to the first endpoint of the local address's family directly
+        net::ip::address local = net::ip::make_address(local_address_, ec);
+        if (ec) return fail("Local address", ec);
+        for (const auto& entry : results) {
+            tcp::endpoint remote = entry.endpoint();
+            if (remote.address().is_v4() != local.is_v4()) continue;
+            tcp::socket& socket = beast::get_lowest_layer(*ws_).socket();
+            socket.open(remote.protocol(), ec);
+            if (!ec) socket.bind(tcp::endpoint(local, 0), ec);
+            if (ec) return fail("Bind", ec);
+            socket.async_connect(remote,
+                [self = shared_from_this(), remote](beast::error_code ec) { self->on_connect(ec, remote); });
+            return;
+        }
+        fail("Resolve", net::error::address_family_not_supported);
+    }
+
+    void on_connect(beast::error_code ec, tcp::resolver::results_type::endpoint_type) {
+        if (ec) return fail("Connect", ec);
+        beast::get_lowest_layer(*ws_).apply(owner_.socket_tuning_, owner_.protocol_.name);
+
+        // SNI, required by CDN-fronted endpoints
+        if (!SSL_set_tlsext_host_name(ws_->next_layer().native_handle(), owner_.protocol_.host.c_str())) {
+            std::cerr << "[" << owner_.protocol_.name << "#" << index_ << "] Failed to set SNI\n";
+        }
+        ws_->next_layer().async_handshake(ssl::stream_base::client,
+            beast::bind_front_handler(&Connection::on_ssl_handshake, shared_from_this()));
+    }
+
+    void on_ssl_handshake(beast::error_code ec) {
+        if (ec) return fail("TLS handshake", ec);
+        ws_->set_option(supervisor_.stream_timeout());
+        if (owner_.compression_) {
+            // Only an offer: a venue that doesn't support it answers without the extension
+            websocket::permessage_deflate pmd;
+            pmd.client_enable = true;
+            ws_->set_option(pmd);
+        }
+        ws_->async_handshake(owner_.protocol_.host, owner_.protocol_.target,
+            beast::bind_front_handler(&Connection::on_handshake, shared_from_this()));
+    }
+
+    void on_handshake(beast::error_code ec) {
+        if (ec) return fail("WS handshake", ec);
+        open_ = true;
+        owner_.open_connections_.store(owner_.open_connections_.load(std::memory_order_relaxed) + 1,
+                                       std::memory_order_relaxed);
+
+        outbound_.attach(*ws_);
+        send(owner_.protocol_.make_subscription(owner_.shards_[shard_]));
+        supervisor_.on_connected();
+        read_message();
+    }
+
+    // Frames were dropped: the shard's books are cleared downstream and need a fresh snapshot
+    void resubscribe() {
+        send(owner_.protocol_.make_unsubscription(owner_.shards_[shard_]));
+        send(owner_.protocol_.make_subscription(owner_.shards_[shard_]));
+    }
+
+    void send(const std::string& message) {
+        if (!message.empty() && !outbound_.send(message)) {
+            std::cerr << "[" << owner_.protocol_.name << "#" << index_ << "] Write queue full, message dropped\n";
+        }
+    }
+
+    void read_message() {
+        ws_->async_read(buffer_, beast::bind_front_handler(&Connection::on_read, shared_from_this()));
+    }
+
+    void on_read(beast::error_code ec, std::size_t) {
+        if (ec) return fail("Read", ec);
+
+        RawMessage msg;
+        msg.trace.socket_rx = FastClock::ticks();
+        msg.trace.kernel_rx = beast::get_lowest_layer(*ws_).last_rx_timestamp();
+        msg.payload = buffer_.take();
+        msg.connection = index_;
+        owner_.on_message(supervisor_, std::move(msg));
+
+        read_message();
+    }
+
+    // Copies of a shard are one feed downstream: it is up while any copy is, so only the first
+    // copy up and the last copy down reach the processor
+    bool gate_status(FeedState state) {
+        if (state == FeedState::Gap) return true; // Lost frames, whichever copy dropped them
+        uint32_t& up = owner_.shard_up_[shard_];
+        if (state == FeedState::Connected) {
+            if (!counted_up_) {
+                counted_up_ = true;
+                ++up;
+            }
+            return up == 1;
+        }
+        if (counted_up_) {
+            counted_up_ = false;
+            --up;
+        }
+        return up == 0;
+    }
+
+    void mark_closed() {
+        if (!open_) return;
+        open_ = false;
+        owner_.on_connection_closed();
+    }
+
+    void log_error(const char* what, beast::error_code ec) {
+        std::cerr << "[" << owner_.protocol_.name << "#" << index_ << "] " << what << ": " << ec.message() << "\n";
+    }
+
+    MultiStreamConnector& owner_;
+    uint32_t index_;
+    uint32_t shard_;
+    std::string local_address_;
+    tcp::resolver resolver_;
+    std::optional<websocket::stream<beast::ssl_stream<FeedSocket>>> ws_; // Recreated per connection
+    PayloadBuffer buffer_; // Frames are read, and inflated, straight into the payload
+    FeedSupervisor supervisor_;
+    OutboundQueue<websocket::stream<beast::ssl_stream<FeedSocket>>> outbound_; // Subscriptions only
+    bool open_ = false;
+    bool counted_up_ = false; // Included in the shard's count of copies up
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Connector
+//////////////////////////////////////////////////////////////////////////
+
+MultiStreamConnector::MultiStreamConnector(VenueProtocol protocol, std::vector<SPSCQueue<RawMessage>*> queues)
+    : protocol_(std::move(protocol)), queues_(std::move(queues)), ioc_(1),
+      ssl_ctx_(ssl::context::tlsv12_client), work_guard_(net::make_work_guard(ioc_)), stop_timer_(ioc_) {
+    ssl_ctx_.set_default_verify_paths();
+    ssl_ctx_.set_verify_mode(ssl::verify_none);
+    if (queues_.empty()) {
+        throw std::invalid_argument("MultiStreamConnector needs at least one queue");
+    }
+}
+
+MultiStreamConnector::~MultiStreamConnector() {
+    stop();
+}
+
+std::vector<std::vector<std::string>> MultiStreamConnector::shard_streams(const std::vector<std::string>& streams,
+                                                                          size_t max_per_connection) {
+    if (streams.empty() || max_per_connection == 0) return {};
+    size_t shard_count = (streams.size() + max_per_connection - 1) / max_per_connection;
+    std::vector<std::vector<std::string>> shards(shard_count);
+    for (auto& shard : shards) shard.reserve(streams.size() / shard_count + 1);
+    for (size_t i = 0; i < streams.size(); ++i) {
+        shards[i % shard_count].push_back(streams[i]);
+    }
+    return shards;
+}
+
+void MultiStreamConnector::set_redundancy(size_t copies, std::vector<std::string> local_addresses) {
+    copies_ = copies > 0 ? copies : 1;
+    local_addresses_ = std::move(local_addresses);
+}
+
+bool MultiStreamConnector::initialize(const std::vector<std::string>& streams) {
+    if (running_) {
+        std::cerr << "[" << protocol_.name << "] Cannot re-shard while running" << std::endl;
+        return false;
+    }
+    if (copies_ > 1 && !protocol_.dedup_key) {
+        std::cerr << "[" << protocol_.name << "] Redundant connections need a dedup key function" << std::endl;
+        return false;
+    }
+    auto shards = shard_streams(streams, protocol_.max_streams_per_connection);
+    if (shards.size() * copies_ > protocol_.max_connections) {
+        std::cerr << "[" << protocol_.name << "] " << streams.size() << " streams need " << shards.size() * copies_
+                  << " connections, limit is " << protocol_.max_connections << std::endl;
+        return false;
+    }
+    shards_ = std::move(shards);
+    shard_up_.assign(shards_.size(), 0);
+
+    // Copies of a shard are adjacent: connection i carries shard i / copies
+    connections_.clear();
+    for (uint32_t i = 0; i < shards_.size() * copies_; ++i) {
+        std::string local = local_addresses_.empty() ? std::string() : local_addresses_[(i % copies_) % local_addresses_.size()];
+        connections_.push_back(std::make_shared<Connection>(*this, i, static_cast<uint32_t>(i / copies_), std::move(local)));
+    }
+    arbiter_ = copies_ > 1 ? std::make_unique<FeedArbiter>(protocol_.dedup_key, connections_.size()) : nullptr;
+
+    std::cout << "[" << protocol_.name << "] " << streams.size() << " streams over " << shards_.size()
+              << " shards x " << copies_ << " copies, " << queues_.size() << " queue(s)" << std::endl;
+    return true;
+}
+
+void MultiStreamConnector::start(const ThreadPlacement& placement) {
+    if (running_) {
+        std::cerr << "[" << protocol_.name << "] Connector already running!" << std::endl;
+        return;
+    }
+    running_ = true;
+
+    for (auto& connection : connections_) {
+        net::post(ioc_, [connection] { connection->start(); });
+    }
+
+    thread_ = std::thread([this] {
+        try {
+            ioc_.run();
+        } catch (const std::exception& e) {
+            std::cerr << "[" << protocol_.name << "] io_context exception: " << e.what() << std::endl;
+        }
+    });
+    pin_thread(thread_, placement);
+}
+
+void MultiStreamConnector::stop() {
+    if (!running_) return;
+    running_ = false;
+
+    net::post(ioc_, [this] {
+        stopping_ = true;
+        for (auto& connection : connections_) connection->close();
+        // Backstop for peers that never answer the close frame
+        stop_timer_.expires_after(std::chrono::seconds(1));
+        stop_timer_.async_wait([this](beast::error_code ec) {
+            if (!ec) ioc_.stop();
+        });
+        if (open_connections_.load(std::memory_order_relaxed) == 0) stop_timer_.cancel();
+    });
+    work_guard_.reset();
+    if (thread_.joinable()) thread_.join();
+    open_connections_.store(0, std::memory_order_relaxed); // Backstop may have cut closes short
+}
+
+void MultiStreamConnector::on_message(FeedSupervisor& supervisor, RawMessage&& message) {
+    received_messages_.store(received_messages_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    // A copy that loses arbitration still shows its connection is alive
+    supervisor.on_frame(message.trace.socket_rx);
+    if (arbiter_ && !arbiter_->accept(message.connection, message)) return; // A faster copy already went through
+    if (!supervisor.push(std::move(message))) {
+        // Log the first drop and then every 10000th; a line per drop would stall the reader
+        uint64_t dropped = dropped_messages_.load(std::memory_order_relaxed) + 1;
+        dropped_messages_.store(dropped, std::memory_order_relaxed);
+        if (dropped % 10000 == 1) {
+            std::cerr << "[" << protocol_.name << "] Queue full, dropping message (" << dropped << " dropped)\n";
+        }
+    }
+}
+
+void MultiStreamConnector::on_connection_closed() {
+    size_t open = open_connections_.load(std::memory_order_relaxed);
+    if (open > 0) open_connections_.store(open - 1, std::memory_order_relaxed);
+    if (stopping_ && open <= 1) stop_timer_.cancel();
+}
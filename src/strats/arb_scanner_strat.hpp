@@ -0,0 +1,126 @@
+#pragma once
+#include "istrategy.hpp"
+#include "ipipeline.hpp"
+#include "arb_scanner.hpp"
+#include "instrument_registry.hpp"
+#include "level_book.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @struct ScanRow
+ * @brief One symbol as each venue names it.
+ */
+struct ScanRow {
+    std::string name;                 // e.g. "BTC-USD"
+    std::vector<std::string> symbols; // symbols[i] on pipelines[i]; empty if that venue doesn't list it
+};
+
+/**
+ * @class ArbScannerStrat
+ * @brief Scans every symbol across every pipeline for cross-venue arbitrage.
+ *
+ * Each (venue, symbol) gets an InstrumentRegistry id and a LevelBook. When an update moves a
+ * book's top, only that symbol's row of the ArbScanner is re-evaluated; if the row then holds
+ * an opportunity, the current ranking across all symbols is reported, best first.
+ */
+class ArbScannerStrat : public IStrategy {
+public:
+    /**
+     * @param fees Taker fee per pipeline, as a fraction of notional.
+     * @param diff_percent Minimum profit as a fraction of the bought notional.
+     * @param top_n Opportunities reported per ranking.
+     */
+    ArbScannerStrat(
+        std::shared_ptr<EventBus> event_bus,
+        Logger& logger,
+        std::shared_ptr<IExcecutionRouter> execution_router,
+        std::vector<IPipeline*> pipelines,
+        std::vector<ScanRow> rows,
+        const std::vector<double>& fees,
+        double diff_percent,
+        size_t top_n = 5
+    )
+    : IStrategy(event_bus, logger, execution_router),
+      pipelines_{std::move(pipelines)},
+      rows_{std::move(rows)},
+      scanner_{fees, diff_percent},
+      top_n_{top_n} {
+        if (fees.size() != pipelines_.size()) {
+            throw std::invalid_argument("ArbScannerStrat: one fee per pipeline");
+        }
+        for (const auto& row : rows_) {
+            if (row.symbols.size() != pipelines_.size()) {
+                throw std::invalid_argument("ArbScannerStrat: row '" + row.name + "' needs one symbol slot per pipeline");
+            }
+            const uint32_t r = scanner_.add_row();
+            for (uint32_t v = 0; v < pipelines_.size(); ++v) {
+                if (row.symbols[v].empty()) continue;
+                const uint32_t id = registry_.add(pipelines_[v]->name, row.symbols[v]);
+                scanner_.bind(id, r, v);
+                if (id >= venue_of_.size()) venue_of_.resize(id + 1);
+                venue_of_[id] = v;
+            }
+        }
+        books_.resize(registry_.size());
+        ranked_.reserve(rows_.size());
+    }
+
+    void start() override {
+        for (auto* pipeline : pipelines_) {
+            pipeline->start();
+        }
+
+        event_bus_->subscribe<OrderBookDataEvent>([this](const OrderBookDataEvent& orderbook_data) {
+            const OrderBookData& update = orderbook_data.data;
+            const uint32_t id = registry_.find(update.source, update.symbol);
+            if (id == InstrumentRegistry::INVALID_INSTRUMENT || !books_[id].apply(update)) {
+                return;
+            }
+            if (scanner_.update(id, books_[id].top())) {
+                report();
+            }
+        });
+
+        // Quotes from a dropped or stale feed are void until the venue resubscribes and sends fresh data
+        event_bus_->subscribe<FeedStatusEvent>([this](const FeedStatusEvent& status) {
+            if (status.data.state == FeedState::Connected) return;
+            for (uint32_t v = 0; v < pipelines_.size(); ++v) {
+                if (status.data.source != pipelines_[v]->name) continue;
+                for (uint32_t id = 0; id < books_.size(); ++id) {
+                    if (venue_of_[id] == v) books_[id].clear();
+                }
+                scanner_.clear_venue(v);
+            }
+        });
+    }
+
+    void stop() override {
+        for (auto* pipeline : pipelines_) {
+            pipeline->stop();
+        }
+    }
+
+private:
+    void report() {
+        scanner_.ranked(ranked_, top_n_);
+        for (size_t i = 0; i < ranked_.size(); ++i) {
+            const ArbScanner::Opportunity& opp = ranked_[i];
+            std::cout << "[SCAN #" << i + 1 << "] " << rows_[opp.row].name
+                      << " BUY " << pipelines_[opp.buy_venue]->name << " @ " << opp.buy_price
+                      << " SELL " << pipelines_[opp.sell_venue]->name << " @ " << opp.sell_price
+                      << " VOLUME: " << opp.quantity
+                      << " EXPECTED PROFIT: " << opp.profit << std::endl;
+        }
+    }
+
+    std::vector<IPipeline*> pipelines_;
+    std::vector<ScanRow> rows_;
+    InstrumentRegistry registry_;
+    ArbScanner scanner_;
+    std::vector<LevelBook> books_;    // By instrument id
+    std::vector<uint32_t> venue_of_;  // By instrument id
+    std::vector<ArbScanner::Opportunity> ranked_;
+    size_t top_n_;
+};
@@ -1,5 +1,185 @@
-class PairTradingStrat{
+#pragma once
+#include "istrategy.hpp"
+#include "ipipeline.hpp"
+#include "instrument_registry.hpp"
+#include "rolling_pair_stats.hpp"
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
 
+/**
+ * @struct PairSpec
+ * @brief Two instruments traded against each other: y is hedged with x.
+ */
+struct PairSpec {
+    std::string y_source; // OrderBookData/TradeData source, e.g. "Binance"
+    std::string y_symbol;
+    std::string x_source;
+    std::string x_symbol;
+};
 
-    
-}
\ No newline at end of file
+/**
+ * @class PairTradingStrat
+ * @brief Mean-reversion on the spread between paired instruments.
+ *
+ * Every trade or ticker of either leg samples the pair's log prices into a RollingPairStats,
+ * which keeps the hedge ratio and spread statistics over the last `window` samples in O(1).
+ * Once the window is full the strategy goes short the spread (sell y, buy beta x) when its
+ * z-score rises above entry_z, long when it falls below -entry_z, and flat again once |z|
+ * drops under exit_z.
+ *
+ * All per-pair state is allocated in the constructor. Instruments are looked up once per event
+ * and fan out to the pairs they belong to through a flat index, so hundreds of pairs share one
+ * thread and a tick allocates nothing.
+ */
+class PairTradingStrat : public IStrategy {
+public:
+    enum class Position : uint8_t {
+        Flat,
+        LongSpread, // Long y, short x
+        ShortSpread // Short y, long x
+    };
+
+    /**
+     * @param pipelines Pipelines the legs come from, started and stopped with the strategy.
+     * @param window Samples the statistics cover.
+     * @param entry_z Spread z-score that opens a position.
+     * @param exit_z Spread z-score that closes it.
+     */
+    PairTradingStrat(
+        std::shared_ptr<EventBus> event_bus,
+        Logger& logger,
+        std::shared_ptr<IExcecutionRouter> execution_router,
+        std::vector<IPipeline*> pipelines,
+        const std::vector<PairSpec>& pairs,
+        size_t window,
+        double entry_z = 2.0,
+        double exit_z = 0.5
+    )
+    : IStrategy(event_bus, logger, execution_router),
+      pipelines_{std::move(pipelines)},
+      entry_z_{entry_z},
+      exit_z_{exit_z} {
+        if (exit_z_ < 0.0 || exit_z_ >= entry_z_) {
+            throw std::invalid_argument("PairTradingStrat: need 0 <= exit_z < entry_z");
+        }
+        pairs_.reserve(pairs.size());
+        for (const auto& spec : pairs) {
+            const uint32_t y = registry_.add(spec.y_source, spec.y_symbol);
+            const uint32_t x = registry_.add(spec.x_source, spec.x_symbol);
+            if (x == y) throw std::invalid_argument("PairTradingStrat: " + spec.y_symbol + " paired with itself");
+            pairs_.push_back(Pair{y, x, RollingPairStats(window)});
+        }
+        log_prices_.assign(registry_.size(), std::numeric_limits<double>::quiet_NaN());
+
+        // Pairs by instrument, flattened: legs_[leg_offsets_[id], leg_offsets_[id + 1])
+        leg_offsets_.assign(registry_.size() + 1, 0);
+        for (const auto& pair : pairs_) {
+            ++leg_offsets_[pair.y + 1];
+            ++leg_offsets_[pair.x + 1];
+        }
+        for (size_t id = 0; id < registry_.size(); ++id) {
+            leg_offsets_[id + 1] += leg_offsets_[id];
+        }
+        legs_.resize(leg_offsets_.back());
+        std::vector<uint32_t> fill(leg_offsets_.begin(), leg_offsets_.end() - 1);
+        for (uint32_t p = 0; p < pairs_.size(); ++p) {
+            legs_[fill[pairs_[p].y]++] = p;
+            legs_[fill[pairs_[p].x]++] = p;
+        }
+    }
+
+    void start() override {
+        for (auto* pipeline : pipelines_) {
+            pipeline->start();
+        }
+
+        event_bus_->subscribe<TradeEvent>([this](const TradeEvent& trade) {
+            on_price(trade.data.source, trade.data.symbol, trade.data.price);
+        });
+
+        event_bus_->subscribe<TickerDataEvent>([this](const TickerDataEvent& ticker) {
+            const TickerData& t = ticker.data;
+            const bool quoted = t.best_bid > 0.0 && t.best_ask > 0.0;
+            on_price(t.source, t.symbol, quoted ? 0.5 * (t.best_bid + t.best_ask) : t.last_price);
+        });
+
+        // A gap in either leg breaks the sample series; start the window over
+        event_bus_->subscribe<FeedStatusEvent>([this](const FeedStatusEvent& status) {
+            if (status.data.state == FeedState::Connected) return;
+            for (uint32_t id = 0; id < registry_.size(); ++id) {
+                if (registry_.info(id).source != status.data.source) continue;
+                log_prices_[id] = std::numeric_limits<double>::quiet_NaN();
+                for (uint32_t k = leg_offsets_[id]; k < leg_offsets_[id + 1]; ++k) {
+                    pairs_[legs_[k]].stats.clear();
+                }
+            }
+        });
+    }
+
+    void stop() override {
+        for (auto* pipeline : pipelines_) {
+            pipeline->stop();
+        }
+    }
+
+    Position position(uint32_t pair) const { return pairs_[pair].position; }
+    const RollingPairStats& stats(uint32_t pair) const { return pairs_[pair].stats; }
+
+private:
+    struct Pair {
+        uint32_t y;
+        uint32_t x;
+        RollingPairStats stats;
+        Position position = Position::Flat;
+    };
+
+    void on_price(std::string_view source, std::string_view symbol, double price) {
+        const uint32_t id = registry_.find(source, symbol);
+        if (id == InstrumentRegistry::INVALID_INSTRUMENT || price <= 0.0) {
+            return;
+        }
+        log_prices_[id] = std::log(price);
+
+        for (uint32_t k = leg_offsets_[id]; k < leg_offsets_[id + 1]; ++k) {
+            const uint32_t p = legs_[k];
+            Pair& pair = pairs_[p];
+            const double y = log_prices_[pair.y];
+            const double x = log_prices_[pair.x];
+            if (std::isnan(y) || std::isnan(x)) continue; // Other leg not priced yet
+            pair.stats.push(y, x);
+            if (pair.stats.ready()) {
+                signal(p, pair.stats.z_score(y, x));
+            }
+        }
+    }
+
+    void signal(uint32_t p, double z) {
+        Pair& pair = pairs_[p];
+        Position next = pair.position;
+        if (pair.position == Position::Flat) {
+            if (z > entry_z_) next = Position::ShortSpread;
+            else if (z < -entry_z_) next = Position::LongSpread;
+        } else if (std::fabs(z) < exit_z_) {
+            next = Position::Flat;
+        }
+        if (next == pair.position) return;
+        pair.position = next;
+
+        const char* action = next == Position::Flat ? "EXIT" : next == Position::LongSpread ? "BUY SPREAD" : "SELL SPREAD";
+        std::cout << "[PAIR] " << action << " " << registry_.info(pair.y).symbol << " / "
+                  << registry_.info(pair.x).symbol << " Z: " << z
+                  << " HEDGE RATIO: " << pair.stats.hedge_ratio() << std::endl;
+    }
+
+    std::vector<IPipeline*> pipelines_;
+    InstrumentRegistry registry_;
+    std::vector<Pair> pairs_;
+    std::vector<double> log_prices_;    // By instrument id; NaN until the first price
+    std::vector<uint32_t> leg_offsets_; // By instrument id, into legs_
+    std::vector<uint32_t> legs_;        // Pair indices
+    double entry_z_;
+    double exit_z_;
+};
@@ -1,48 +1,77 @@
-#include "IStrategy.hpp"
-#include "IPipeline.hpp"
+#pragma once
+#include "istrategy.hpp"
+#include "ipipeline.hpp"
+#include "level_book.hpp"
+#include "cross_arb_search.hpp"
 #include <iomanip> 
+#include <optional>
 
 struct TradeOpportunity {
-    double price_buy;
-    double price_sell;
+    double price_buy;  // Limit price for the buy leg, the worst ask swept
+    double price_sell; // Limit price for the sell leg, the worst bid swept
     double volume;
     double expected_profit;
+    std::string_view buy_source;
+    std::string_view sell_source;
 };
 
 
+/**
+ * @class CrossExchangeArb
+ * @brief Buys on one venue and sells on the other whenever the books cross by more than fees.
+ *
+ * Each venue's book is a LevelBook kept up to date in place from its OrderBookDataEvents. When
+ * an update moves either top of book, both directions (buy on 1 / sell on 2 and the reverse)
+ * are evaluated with walk_cross, which sweeps the two books in a single pass and accounts for
+ * the taker fee on each leg. Updates below the top are applied but trigger no search. Each
+ * book holds one symbol, so updates for any other symbol a pipeline carries are ignored.
+ *
+ * A book is only traded while it is known to be complete. LevelBook rebuilds from snapshots
+ * (Binance's partial-depth stream, "depth20@100ms") and checks the U/u continuity of Binance
+ * diffs, clearing itself on a break. Every FeedStatusEvent but Connected clears the venue's
+ * book too, including the Gap the supervisor queues after frames are dropped.
+ */
 class CrossExchangeArb : public IStrategy {
 public:
+    /**
+     * @param symbol_1, symbol_2 The symbol traded on each pipeline, as in OrderBookData::symbol.
+     * @param diff_percent Minimum profit as a fraction of the bought notional, e.g. 0.0001 for 1bp.
+     * @param fee Taker fee per leg as a fraction of notional (e.g. 0.001 for 0.1%).
+     */
     CrossExchangeArb(
         std::shared_ptr<EventBus> event_bus,
         Logger& logger,
         std::shared_ptr<IExcecutionRouter> execution_router,
         IPipeline& pipeline_1,
         IPipeline& pipeline_2,
-        int16_t diff_percent,
-        double fee = 0.001 // trading fee as fraction (e.g. 0.1%)
+        std::string symbol_1,
+        std::string symbol_2,
+        double diff_percent,
+        double fee = 0.001
     )
     : IStrategy(event_bus, logger, execution_router),
       pipeline_1_{pipeline_1},
       pipeline_2_{pipeline_2},
+      symbol_1_{std::move(symbol_1)},
+      symbol_2_{std::move(symbol_2)},
       diff_percent_{diff_percent},
       fee_{fee} {}
 
-    void print_orderbook(const OrderBookData& ob) {
-        std::cout << "=== OrderBook [" << ob.symbol << "] from " << ob.source << " ===\n";
-        std::cout << "Timestamp: " << ob.timestamp << " | ID: " << ob.id << "\n";
+    void print_orderbook(const LevelBook& book, std::string_view source) {
+        std::cout << "=== OrderBook from " << source << " ===\n";
+        std::cout << "Timestamp: " << book.timestamp() << "\n";
 
         std::cout << "Asks:\n";
-        for (const auto& [price, volume] : ob.asks) {
+        for (const auto& [price, volume] : book.asks()) {
             std::cout << "  Price: " << std::fixed << std::setprecision(8) << price
                     << " | Volume: " << std::fixed << std::setprecision(8) << volume << "\n";
         }
 
         std::cout << "Bids:\n";
-        for (const auto& [price, volume] : ob.bids) {
+        for (const auto& [price, volume] : book.bids()) {
             std::cout << "  Price: " << std::fixed << std::setprecision(8) << price
                     << " | Volume: " << std::fixed << std::setprecision(8) << volume << "\n";
         }
-        // std::cout << "============================================\n";
     }
 
     void start() override {
@@ -50,26 +79,39 @@ public:
         pipeline_2_.start();
 
         event_bus_->subscribe<OrderBookDataEvent>([this](const OrderBookDataEvent& orderbook_data) { 
-            print_orderbook(orderbook_data.data);
-            if (orderbook_data.data.source == pipeline_1_.name) {
-                orderbook_1_ = orderbook_data.data;
-            } else if (orderbook_data.data.source == pipeline_2_.name) {
-                orderbook_2_ = orderbook_data.data;
+            const OrderBookData& update = orderbook_data.data;
+            bool top_changed;
+            if (update.source == pipeline_1_.name && update.symbol == symbol_1_) {
+                top_changed = book_1_.apply(update);
+            } else if (update.source == pipeline_2_.name && update.symbol == symbol_2_) {
+                top_changed = book_2_.apply(update);
+            } else {
+                return;
             }
 
-            if (orderbook_1_.has_value() && orderbook_2_.has_value()) {
-                auto opp = should_trade(orderbook_1_.value(), orderbook_2_.value());
+            if (top_changed) {
+                auto opp = should_trade();
                 if (opp.has_value()) {
                     execute(opp.value());
                 }
             }
         });
+
+        // A book from a dropped, stale or gapped feed is invalid until the venue sends a fresh snapshot
+        event_bus_->subscribe<FeedStatusEvent>([this](const FeedStatusEvent& status) {
+            if (status.data.state == FeedState::Connected) return;
+            if (status.data.source == pipeline_1_.name) {
+                book_1_.clear();
+            } else if (status.data.source == pipeline_2_.name) {
+                book_2_.clear();
+            }
+        });
     }
 
 
     void execute(const TradeOpportunity& opp) {
-        std::cout << "[ARBITRAGE] BUY @ " << opp.price_buy
-                  << " SELL @ " << opp.price_sell
+        std::cout << "[ARBITRAGE] BUY " << opp.buy_source << " @ " << opp.price_buy
+                  << " SELL " << opp.sell_source << " @ " << opp.price_sell
                   << " VOLUME: " << opp.volume
                   << " EXPECTED PROFIT: " << opp.expected_profit << std::endl;
     }
@@ -79,38 +121,30 @@ public:
         pipeline_2_.stop();
     }
 
-    std::optional<TradeOpportunity> should_trade(const OrderBookData& obA, const OrderBookData& obB) { 
-        TradeOpportunity best{0,0,0,0};
-        size_t depth = std::min<size_t>(5, std::min(obA.asks.size(), obB.bids.size()));
-
-        for (size_t i = 0; i < depth; ++i) {
-            double ask_price = obA.asks[i].first;
-            double ask_vol   = obA.asks[i].second;
-            for (size_t j = 0; j < depth; ++j) {
-                double bid_price = obB.bids[j].first;
-                double bid_vol   = obB.bids[j].second;
-
-                double tradable_vol = std::min(ask_vol, bid_vol);
-                double spread = bid_price - ask_price;
-                double adjusted = spread - fee_ * (ask_price + bid_price) / 2;
-                double profit = adjusted * tradable_vol;
-
-                if (profit > best.expected_profit) {
-                    best = TradeOpportunity{ask_price, bid_price, tradable_vol, profit};
-                }
-            }
+    // The more profitable direction, if either clears fees and diff_percent
+    std::optional<TradeOpportunity> should_trade() const {
+        if (book_1_.empty() || book_2_.empty()) {
+            return std::nullopt;
         }
-        if (best.expected_profit > 0) {
-            return best;
+        CrossFill buy_1 = walk_cross(book_1_.asks(), book_2_.bids(), fee_);
+        CrossFill buy_2 = walk_cross(book_2_.asks(), book_1_.bids(), fee_);
+        const bool first = buy_1.profit >= buy_2.profit;
+        const CrossFill& best = first ? buy_1 : buy_2;
+        if (best.profit <= 0.0 || best.profit < diff_percent_ * best.buy_notional) {
+            return std::nullopt;
         }
-        return std::nullopt;
+        return TradeOpportunity{best.buy_limit, best.sell_limit, best.quantity, best.profit,
+                                first ? pipeline_1_.name : pipeline_2_.name,
+                                first ? pipeline_2_.name : pipeline_1_.name};
     }
 
 private:
     IPipeline& pipeline_1_;
     IPipeline& pipeline_2_;
-    std::optional<OrderBookData> orderbook_1_;
-    std::optional<OrderBookData> orderbook_2_;
-    int16_t diff_percent_;
+    std::string symbol_1_;
+    std::string symbol_2_;
+    LevelBook book_1_;
+    LevelBook book_2_;
+    double diff_percent_;
     double fee_;
 };
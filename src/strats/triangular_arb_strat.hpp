@@ -0,0 +1,96 @@
+#pragma once
+#include "istrategy.hpp"
+#include "ipipeline.hpp"
+#include "instrument_registry.hpp"
+#include "level_book.hpp"
+#include "triangle_scanner.hpp"
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @class TriangularArbStrat
+ * @brief Trades three-leg currency cycles within one venue, e.g. USDT -> BTC -> ETH -> USDT.
+ *
+ * Every symbol the pipeline streams gets an InstrumentRegistry id and a LevelBook. When an
+ * update moves a book's top, the TriangleScanner checks only the cycles through that pair.
+ */
+class TriangularArbStrat : public IStrategy {
+public:
+    /**
+     * @param symbols The pipeline's symbols, as its OrderBookData names them.
+     * @param fee Taker fee per leg as a fraction of notional.
+     * @param diff_percent Minimum return of a cycle as a fraction, e.g. 0.0005 for 5bp.
+     */
+    TriangularArbStrat(
+        std::shared_ptr<EventBus> event_bus,
+        Logger& logger,
+        std::shared_ptr<IExcecutionRouter> execution_router,
+        IPipeline& pipeline,
+        const std::vector<std::string>& symbols,
+        double fee,
+        double diff_percent
+    )
+    : IStrategy(event_bus, logger, execution_router),
+      pipeline_{pipeline},
+      registry_{register_symbols(pipeline.name, symbols)},
+      scanner_{registry_, pipeline.name, fee, diff_percent},
+      books_(registry_.size()) {}
+
+    void start() override {
+        pipeline_.start();
+
+        event_bus_->subscribe<OrderBookDataEvent>([this](const OrderBookDataEvent& orderbook_data) {
+            const OrderBookData& update = orderbook_data.data;
+            if (update.source != pipeline_.name) return;
+            const uint32_t id = registry_.find(update.source, update.symbol);
+            if (id == InstrumentRegistry::INVALID_INSTRUMENT || !books_[id].apply(update)) {
+                return;
+            }
+            scanner_.update(id, books_[id].top(), [this](uint32_t cycle, double log_return) {
+                execute(cycle, log_return);
+            });
+        });
+
+        // Rates from a dropped or stale feed are void until the venue resubscribes and sends fresh data
+        event_bus_->subscribe<FeedStatusEvent>([this](const FeedStatusEvent& status) {
+            if (status.data.state == FeedState::Connected || status.data.source != pipeline_.name) return;
+            for (uint32_t id = 0; id < books_.size(); ++id) {
+                books_[id].clear();
+                scanner_.update(id, LevelBook::TopOfBook{}, [](uint32_t, double) {});
+            }
+        });
+    }
+
+    void execute(uint32_t cycle_id, double log_return) {
+        const TriangleScanner::Cycle& cycle = scanner_.cycle(cycle_id);
+        std::cout << "[TRIANGLE] " << scanner_.currency(cycle.start);
+        for (const auto& leg : cycle.legs) {
+            const LevelBook::TopOfBook top = books_[leg.instrument].top();
+            std::cout << " -> " << scanner_.currency(scanner_.to(leg)) << " (" << (leg.sell ? "SELL " : "BUY ")
+                      << registry_.info(leg.instrument).symbol << " @ " << (leg.sell ? top.bid_price : top.ask_price)
+                      << ")";
+        }
+        std::cout << " SIZE: " << scanner_.size(cycle_id) << " " << scanner_.currency(cycle.start)
+                  << " RETURN: " << std::expm1(log_return) << std::endl;
+    }
+
+    void stop() override {
+        pipeline_.stop();
+    }
+
+private:
+    static InstrumentRegistry register_symbols(const std::string& source, const std::vector<std::string>& symbols) {
+        InstrumentRegistry registry;
+        for (const auto& symbol : symbols) {
+            registry.add(source, symbol);
+        }
+        return registry;
+    }
+
+    IPipeline& pipeline_;
+    InstrumentRegistry registry_;
+    TriangleScanner scanner_;
+    std::vector<LevelBook> books_; // By instrument id
+};
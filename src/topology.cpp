@@ -0,0 +1,457 @@
+#include "topology.hpp"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include "arb_scanner.hpp"
+#include "binance_pipeline.hpp"
+#include "candle_aggregator.hpp"
+#include "coinbase_pipeline.hpp"
+#include "connector_pipeline.hpp"
+#include "kraken_pipeline.hpp"
+#include "placed_allocator.hpp"
+
+namespace json = boost::json;
+
+static const json::object& as_object(const json::value& value, const std::string& what) {
+    if (!value.is_object()) throw std::invalid_argument("Topology: " + what + " must be an object");
+    return value.as_object();
+}
+
+static std::string get_string(const json::object& obj, const char* key, const std::string& fallback) {
+    const json::value* v = obj.if_contains(key);
+    if (!v) return fallback;
+    if (!v->is_string()) throw std::invalid_argument(std::string("Topology: '") + key + "' must be a string");
+    return std::string(v->as_string());
+}
+
+static int64_t get_int(const json::object& obj, const char* key, int64_t fallback) {
+    const json::value* v = obj.if_contains(key);
+    if (!v) return fallback;
+    if (!v->is_int64()) throw std::invalid_argument(std::string("Topology: '") + key + "' must be an integer");
+    return v->as_int64();
+}
+
+static double get_double(const json::object& obj, const char* key, double fallback) {
+    const json::value* v = obj.if_contains(key);
+    if (!v) return fallback;
+    if (v->is_double()) return v->as_double();
+    if (v->is_int64()) return static_cast<double>(v->as_int64());
+    throw std::invalid_argument(std::string("Topology: '") + key + "' must be a number");
+}
+
+static bool get_bool(const json::object& obj, const char* key, bool fallback) {
+    const json::value* v = obj.if_contains(key);
+    if (!v) return fallback;
+    if (!v->is_bool()) throw std::invalid_argument(std::string("Topology: '") + key + "' must be true or false");
+    return v->as_bool();
+}
+
+static std::vector<std::string> get_strings(const json::object& obj, const char* key) {
+    std::vector<std::string> out;
+    const json::value* v = obj.if_contains(key);
+    if (!v) return out;
+    if (!v->is_array()) throw std::invalid_argument(std::string("Topology: '") + key + "' must be an array of strings");
+    for (const auto& item : v->as_array()) {
+        if (!item.is_string()) throw std::invalid_argument(std::string("Topology: '") + key + "' must be an array of strings");
+        out.emplace_back(item.as_string());
+    }
+    return out;
+}
+
+static ThreadPlacement parse_placement(const json::object& obj, const char* key) {
+    ThreadPlacement placement;
+    const json::value* v = obj.if_contains(key);
+    if (!v) return placement;
+    const json::object& p = as_object(*v, key);
+    placement.cpu = static_cast<int>(get_int(p, "cpu", -1));
+    placement.numa_node = static_cast<int>(get_int(p, "numa_node", -1));
+    return placement;
+}
+
+static SocketTuning parse_socket_tuning(const json::object& obj) {
+    SocketTuning tuning;
+    const json::value* v = obj.if_contains("socket");
+    if (!v) return tuning;
+    const json::object& s = as_object(*v, "socket");
+    tuning.no_delay = get_bool(s, "no_delay", tuning.no_delay);
+    tuning.receive_buffer = static_cast<int>(get_int(s, "receive_buffer", tuning.receive_buffer));
+    tuning.busy_poll_us = static_cast<int>(get_int(s, "busy_poll_us", tuning.busy_poll_us));
+    tuning.quick_ack = get_bool(s, "quick_ack", tuning.quick_ack);
+    tuning.rx_timestamps = get_bool(s, "rx_timestamps", tuning.rx_timestamps);
+    tuning.io_uring = get_bool(s, "io_uring", tuning.io_uring);
+    return tuning;
+}
+
+static RiskLimits parse_risk_limits(const json::object& obj) {
+    RiskLimits limits;
+    const json::value* v = obj.if_contains("risk");
+    if (!v) return limits;
+    const json::object& r = as_object(*v, "risk");
+    limits.max_position = get_double(r, "max_position", limits.max_position);
+    limits.max_notional = get_double(r, "max_notional", limits.max_notional);
+    limits.max_price_deviation = get_double(r, "max_price_deviation", limits.max_price_deviation);
+    int64_t orders = get_int(r, "max_orders_per_window", limits.max_orders_per_window);
+    int64_t window_ms = get_int(r, "order_window_ms", limits.order_window_ns / 1'000'000);
+    if (limits.max_position < 0.0 || limits.max_notional < 0.0 || limits.max_price_deviation < 0.0 || orders < 0 ||
+        orders > UINT32_MAX) {
+        throw std::invalid_argument("Topology: risk limits must not be negative");
+    }
+    if (window_ms < 1) throw std::invalid_argument("Topology: order_window_ms must be at least 1");
+    limits.max_orders_per_window = static_cast<uint32_t>(orders);
+    limits.order_window_ns = window_ms * 1'000'000;
+    return limits;
+}
+
+static PipelineConfig parse_pipeline(const json::value& value) {
+    const json::object& obj = as_object(value, "pipeline");
+    PipelineConfig p;
+    p.venue = get_string(obj, "venue", "");
+    if (p.venue != "binance" && p.venue != "coinbase" && p.venue != "kraken") {
+        throw std::invalid_argument("Topology: unknown venue '" + p.venue + "'");
+    }
+    p.host = get_string(obj, "host", "");
+    if (p.host.empty()) throw std::invalid_argument("Topology: pipeline '" + p.venue + "' has no host");
+    p.port = get_string(obj, "port", p.port);
+    p.target = get_string(obj, "target", p.target);
+    p.symbols = get_strings(obj, "symbols");
+    p.channels = get_strings(obj, "channels");
+    if (p.symbols.empty() || p.channels.empty()) {
+        throw std::invalid_argument("Topology: pipeline '" + p.venue + "' needs symbols and channels");
+    }
+    if (p.venue == "kraken" && p.channels.size() != 1) {
+        throw std::invalid_argument("Topology: a Kraken pipeline subscribes to exactly one channel");
+    }
+    int64_t capacity = get_int(obj, "queue_capacity", static_cast<int64_t>(p.queue_capacity));
+    if (capacity < 2) throw std::invalid_argument("Topology: queue_capacity must be at least 2");
+    p.queue_capacity = static_cast<size_t>(capacity);
+    p.huge_pages = get_bool(obj, "huge_pages", p.huge_pages);
+    p.exchange_thread = parse_placement(obj, "exchange_thread");
+    p.parser_thread = parse_placement(obj, "parser_thread");
+    std::string wait = get_string(obj, "wait_strategy", "sleep");
+    if (!parse_wait_strategy(wait, p.wait_strategy)) {
+        throw std::invalid_argument("Topology: unknown wait_strategy '" + wait + "'");
+    }
+    p.socket_tuning = parse_socket_tuning(obj);
+    int64_t max_streams = get_int(obj, "max_streams_per_connection", 0);
+    if (max_streams < 0) throw std::invalid_argument("Topology: max_streams_per_connection must not be negative");
+    p.max_streams_per_connection = static_cast<size_t>(max_streams);
+    int64_t redundancy = get_int(obj, "redundancy", static_cast<int64_t>(p.redundancy));
+    if (redundancy < 1) throw std::invalid_argument("Topology: redundancy must be at least 1");
+    p.redundancy = static_cast<size_t>(redundancy);
+    p.local_addresses = get_strings(obj, "local_addresses");
+    return p;
+}
+
+// Index of venue in the strategy's pipelines
+static size_t pipeline_index(const StrategyConfig& s, const std::string& venue) {
+    auto it = std::find(s.pipelines.begin(), s.pipelines.end(), venue);
+    if (it == s.pipelines.end()) {
+        throw std::invalid_argument("Topology: '" + venue + "' is not one of the strategy's pipelines");
+    }
+    return static_cast<size_t>(it - s.pipelines.begin());
+}
+
+static ScanInstrumentConfig parse_scan_instrument(const StrategyConfig& s, const json::value& value) {
+    const json::object& obj = as_object(value, "instrument");
+    ScanInstrumentConfig instrument;
+    instrument.name = get_string(obj, "name", "");
+    if (instrument.name.empty()) throw std::invalid_argument("Topology: instrument has no name");
+    instrument.symbols.resize(s.pipelines.size());
+    const json::value* symbols = obj.if_contains("symbols");
+    if (!symbols) throw std::invalid_argument("Topology: instrument '" + instrument.name + "' has no symbols");
+    for (const auto& entry : as_object(*symbols, "symbols")) {
+        if (!entry.value().is_string()) throw std::invalid_argument("Topology: 'symbols' values must be strings");
+        instrument.symbols[pipeline_index(s, std::string(entry.key()))] = std::string(entry.value().as_string());
+    }
+    return instrument;
+}
+
+// {"venue": ..., "symbol": ...}, the venue one of the strategy's pipelines
+static void parse_pair_leg(const StrategyConfig& s, const json::object& obj, const char* key, std::string& venue,
+                           std::string& symbol) {
+    const json::value* v = obj.if_contains(key);
+    if (!v) throw std::invalid_argument(std::string("Topology: pair has no '") + key + "' leg");
+    const json::object& leg = as_object(*v, key);
+    venue = get_string(leg, "venue", "");
+    symbol = get_string(leg, "symbol", "");
+    if (symbol.empty()) throw std::invalid_argument(std::string("Topology: pair leg '") + key + "' has no symbol");
+    pipeline_index(s, venue);
+}
+
+static StrategyConfig parse_strategy(const json::value& value) {
+    const json::object& obj = as_object(value, "strategy");
+    StrategyConfig s;
+    s.type = get_string(obj, "type", "");
+    if (s.type != "cross_exchange_arb" && s.type != "arb_scanner" && s.type != "triangular_arb" &&
+        s.type != "pair_trading") {
+        throw std::invalid_argument("Topology: unknown strategy type '" + s.type + "'");
+    }
+    s.pipelines = get_strings(obj, "pipelines");
+    if (s.type == "cross_exchange_arb" && s.pipelines.size() != 2) {
+        throw std::invalid_argument("Topology: cross_exchange_arb reads exactly two pipelines");
+    }
+    if (s.type == "pair_trading" && s.pipelines.empty()) {
+        throw std::invalid_argument("Topology: pair_trading reads at least one pipeline");
+    }
+    if (s.type == "triangular_arb" && s.pipelines.size() != 1) {
+        throw std::invalid_argument("Topology: triangular_arb reads exactly one pipeline");
+    }
+    if (s.type == "arb_scanner" && (s.pipelines.size() < 2 || s.pipelines.size() > ArbScanner::MAX_VENUES)) {
+        throw std::invalid_argument("Topology: arb_scanner reads 2 to " + std::to_string(ArbScanner::MAX_VENUES) +
+                                    " pipelines");
+    }
+    s.diff_percent = get_double(obj, "diff_percent", s.diff_percent);
+    s.fee = get_double(obj, "fee", s.fee);
+    s.fees.assign(s.pipelines.size(), s.fee);
+    if (const json::value* fees = obj.if_contains("fees")) {
+        for (const auto& entry : as_object(*fees, "fees")) {
+            const json::value& fee = entry.value();
+            if (!fee.is_double() && !fee.is_int64()) throw std::invalid_argument("Topology: 'fees' values must be numbers");
+            s.fees[pipeline_index(s, std::string(entry.key()))] =
+                fee.is_double() ? fee.as_double() : static_cast<double>(fee.as_int64());
+        }
+    }
+    if (s.type == "cross_exchange_arb") {
+        s.symbols.resize(s.pipelines.size());
+        if (const json::value* symbols = obj.if_contains("symbols")) {
+            for (const auto& entry : as_object(*symbols, "symbols")) {
+                if (!entry.value().is_string()) throw std::invalid_argument("Topology: 'symbols' values must be strings");
+                s.symbols[pipeline_index(s, std::string(entry.key()))] = std::string(entry.value().as_string());
+            }
+        }
+    }
+    if (s.type == "arb_scanner") {
+        const json::value* instruments = obj.if_contains("instruments");
+        if (!instruments || !instruments->is_array() || instruments->as_array().empty()) {
+            throw std::invalid_argument("Topology: arb_scanner needs a non-empty 'instruments' array");
+        }
+        for (const auto& i : instruments->as_array()) s.instruments.push_back(parse_scan_instrument(s, i));
+        int64_t top_n = get_int(obj, "top_n", static_cast<int64_t>(s.top_n));
+        if (top_n < 1) throw std::invalid_argument("Topology: top_n must be at least 1");
+        s.top_n = static_cast<size_t>(top_n);
+    }
+    if (s.type == "pair_trading") {
+        const json::value* pairs = obj.if_contains("pairs");
+        if (!pairs || !pairs->is_array() || pairs->as_array().empty()) {
+            throw std::invalid_argument("Topology: pair_trading needs a non-empty 'pairs' array");
+        }
+        for (const auto& p : pairs->as_array()) {
+            const json::object& pair = as_object(p, "pair");
+            PairConfig config;
+            parse_pair_leg(s, pair, "y", config.y_venue, config.y_symbol);
+            parse_pair_leg(s, pair, "x", config.x_venue, config.x_symbol);
+            s.pairs.push_back(std::move(config));
+        }
+        int64_t window = get_int(obj, "window", static_cast<int64_t>(s.window));
+        if (window < 2) throw std::invalid_argument("Topology: window must be at least 2");
+        s.window = static_cast<size_t>(window);
+        s.entry_z = get_double(obj, "entry_z", s.entry_z);
+        s.exit_z = get_double(obj, "exit_z", s.exit_z);
+    }
+    return s;
+}
+
+static std::string to_lower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return s;
+}
+
+static json::array to_array(const std::vector<std::string>& items) {
+    json::array out;
+    for (const auto& item : items) out.emplace_back(item);
+    return out;
+}
+
+json::object PipelineConfig::subscription() const {
+    if (venue == "binance") {
+        // "btcusdt@depth@100ms"
+        json::array streams;
+        for (const auto& symbol : symbols) {
+            for (const auto& channel : channels) streams.emplace_back(to_lower(symbol) + "@" + channel);
+        }
+        return json::object{{"streams", std::move(streams)}};
+    }
+    if (venue == "coinbase") {
+        return json::object{{"product_ids", to_array(symbols)}, {"channels", to_array(channels)}};
+    }
+    json::object params{{"channel", channels.front()}, {"symbol", to_array(symbols)}};
+    return json::object{{"method", "subscribe"}, {"params", std::move(params)}};
+}
+
+std::vector<std::string> PipelineConfig::streams() const {
+    if (venue != "binance") return symbols;
+    std::vector<std::string> out;
+    for (const auto& symbol : symbols) {
+        for (const auto& channel : channels) out.push_back(to_lower(symbol) + "@" + channel);
+    }
+    return out;
+}
+
+// The venue's protocol pointed at the configured endpoint, with the configured shard size
+static VenueProtocol venue_protocol(const PipelineConfig& p) {
+    VenueProtocol protocol = p.venue == "binance"    ? VenueProtocol::binance()
+                             : p.venue == "coinbase" ? VenueProtocol::coinbase(p.channels)
+                                                     : VenueProtocol::kraken(p.channels.front());
+    protocol.host = p.host;
+    protocol.port = p.port;
+    // Binance's processor reads the combined-stream format, which only /stream delivers
+    if (p.venue != "binance") protocol.target = p.target;
+    if (p.max_streams_per_connection > 0) {
+        protocol.max_streams_per_connection = std::min(protocol.max_streams_per_connection, p.max_streams_per_connection);
+    }
+    return protocol;
+}
+
+template<typename Processor>
+static std::unique_ptr<IPipeline> make_connector_pipeline(const PipelineConfig& p, std::string source,
+                                                          SPSCQueue<RawMessage>& queue,
+                                                          std::shared_ptr<EventBus> event_bus,
+                                                          const MultiStreamConnector*& connector) {
+    auto pipeline = std::make_unique<ConnectorPipeline<Processor>>(std::move(source), venue_protocol(p), p.streams(),
+                                                                   queue, std::move(event_bus));
+    pipeline->connector().set_redundancy(p.redundancy, p.local_addresses);
+    connector = &pipeline->connector();
+    return pipeline;
+}
+
+// connector is set when the pipeline runs on a MultiStreamConnector
+static std::unique_ptr<IPipeline> make_pipeline(const PipelineConfig& p, SPSCQueue<RawMessage>& queue,
+                                                std::shared_ptr<EventBus> event_bus,
+                                                const MultiStreamConnector*& connector) {
+    connector = nullptr;
+    if (p.max_streams_per_connection > 0 || p.redundancy > 1) {
+        if (p.venue == "binance") {
+            return make_connector_pipeline<BinanceDataProcessor>(p, "Binance", queue, event_bus, connector);
+        }
+        if (p.venue == "coinbase") {
+            return make_connector_pipeline<CoinbaseDataProcessor>(p, "Coinbase", queue, event_bus, connector);
+        }
+        return make_connector_pipeline<KrakenDataProcessor>(p, "Kraken", queue, event_bus, connector);
+    }
+    if (p.venue == "binance") return std::make_unique<BinancePipeline>(queue, event_bus);
+    if (p.venue == "coinbase") return std::make_unique<CoinbasePipeline>(queue, event_bus);
+    return std::make_unique<KrakenPipeline>(queue, event_bus);
+}
+
+TopologyConfig TopologyConfig::load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) throw std::invalid_argument("Topology: cannot open " + path);
+    std::stringstream text;
+    text << in.rdbuf();
+
+    boost::system::error_code ec;
+    json::value root = json::parse(text.str(), ec);
+    if (ec) throw std::invalid_argument("Topology: " + path + ": " + ec.message());
+    return parse(root);
+}
+
+TopologyConfig TopologyConfig::parse(const json::value& root) {
+    const json::object& obj = as_object(root, "topology");
+    TopologyConfig config;
+    config.log_file = get_string(obj, "log_file", config.log_file);
+    config.logger_cpu = static_cast<int>(get_int(obj, "logger_cpu", config.logger_cpu));
+    config.candles = get_strings(obj, "candles");
+    for (const auto& candle : config.candles) {
+        BarSpec::parse(candle);
+    }
+    config.candle_delay_ms = get_int(obj, "candle_delay_ms", config.candle_delay_ms);
+    if (config.candle_delay_ms < 0) throw std::invalid_argument("Topology: candle_delay_ms must not be negative");
+    config.risk = parse_risk_limits(obj);
+
+    const json::value* pipelines = obj.if_contains("pipelines");
+    if (!pipelines || !pipelines->is_array() || pipelines->as_array().empty()) {
+        throw std::invalid_argument("Topology: 'pipelines' must be a non-empty array");
+    }
+    for (const auto& p : pipelines->as_array()) {
+        PipelineConfig pipeline = parse_pipeline(p);
+        for (const auto& existing : config.pipelines) {
+            if (existing.venue == pipeline.venue) {
+                throw std::invalid_argument("Topology: more than one '" + pipeline.venue + "' pipeline");
+            }
+        }
+        config.pipelines.push_back(std::move(pipeline));
+    }
+
+    if (const json::value* strategies = obj.if_contains("strategies")) {
+        if (!strategies->is_array()) throw std::invalid_argument("Topology: 'strategies' must be an array");
+        for (const auto& s : strategies->as_array()) {
+            StrategyConfig strategy = parse_strategy(s);
+            for (size_t i = 0; i < strategy.pipelines.size(); ++i) {
+                const std::string& venue = strategy.pipelines[i];
+                auto p = std::find_if(config.pipelines.begin(), config.pipelines.end(),
+                                      [&](const PipelineConfig& p) { return p.venue == venue; });
+                if (p == config.pipelines.end()) {
+                    throw std::invalid_argument("Topology: strategy reads unknown pipeline '" + venue + "'");
+                }
+                // One book per pipeline: a multi-symbol pipeline would mix its symbols in it
+                if (strategy.type == "cross_exchange_arb" && strategy.symbols[i].empty()) {
+                    if (p->symbols.size() != 1) {
+                        throw std::invalid_argument("Topology: cross_exchange_arb needs a 'symbols' entry for '" +
+                                                    venue + "', which carries more than one symbol");
+                    }
+                    strategy.symbols[i] = p->symbols.front();
+                }
+            }
+            config.strategies.push_back(std::move(strategy));
+        }
+    }
+    return config;
+}
+
+Topology::Topology(const TopologyConfig& config, std::shared_ptr<EventBus> event_bus) : config_(config) {
+    for (const auto& p : config_.pipelines) {
+        // The parser owns the queue's read side and all processor state, so both go on its node
+        const ThreadPlacement& owner = p.parser_thread.pinned() ? p.parser_thread : p.exchange_thread;
+        MemoryPlacement memory{numa_node_of(owner), p.huge_pages};
+        auto queue = std::make_unique<SPSCQueue<RawMessage>>(p.queue_capacity, memory);
+        const MultiStreamConnector* connector = nullptr;
+        std::unique_ptr<IPipeline> pipeline = construct_on(owner, [&] {
+            return make_pipeline(p, *queue, event_bus, connector);
+        });
+        pipeline->set_thread_placement(p.exchange_thread, p.parser_thread);
+        pipeline->set_wait_strategy(p.wait_strategy);
+        pipeline->set_socket_tuning(p.socket_tuning);
+        pipeline->initialize(p.host, p.port, p.target, p.subscription());
+
+        bool owned = std::any_of(config_.strategies.begin(), config_.strategies.end(), [&](const StrategyConfig& s) {
+            return std::find(s.pipelines.begin(), s.pipelines.end(), p.venue) != s.pipelines.end();
+        });
+        if (!owned) unowned_.push_back(pipeline.get());
+
+        queues_.push_back(std::move(queue));
+        pipelines_.push_back(std::move(pipeline));
+        connectors_.push_back(connector);
+    }
+}
+
+Topology::~Topology() {
+    stop();
+}
+
+IPipeline* Topology::pipeline(const std::string& venue) {
+    for (size_t i = 0; i < pipelines_.size(); ++i) {
+        if (config_.pipelines[i].venue == venue) return pipelines_[i].get();
+    }
+    return nullptr;
+}
+
+void Topology::start_unowned() {
+    for (IPipeline* pipeline : unowned_) pipeline->start();
+}
+
+void Topology::stop() {
+    // Pipelines stop idempotently, whoever started them
+    for (auto& pipeline : pipelines_) pipeline->stop();
+}
+
+void Topology::export_summary(std::ostream& os) const {
+    for (size_t i = 0; i < pipelines_.size(); ++i) {
+        const std::string& venue = config_.pipelines[i].venue;
+        pipelines_[i]->latency_tracer().export_summary(os, venue);
+        os << venue << " dropped_messages " << pipelines_[i]->dropped_messages() << "\n";
+        if (connectors_[i] && connectors_[i]->arbiter()) connectors_[i]->arbiter()->report(os, venue);
+    }
+}
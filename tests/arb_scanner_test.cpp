@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "arb_scanner.hpp"
+
+class ArbScannerTest : public ::testing::Test {
+protected:
+    static LevelBook::TopOfBook quote(double bid, double bid_quantity, double ask, double ask_quantity) {
+        return LevelBook::TopOfBook{bid, bid_quantity, ask, ask_quantity};
+    }
+
+    // Two rows over three venues; instrument id = row * 3 + venue
+    void SetUp() override {
+        for (uint32_t row = 0; row < 2; ++row) {
+            scanner_.add_row();
+            for (uint32_t venue = 0; venue < 3; ++venue) scanner_.bind(row * 3 + venue, row, venue);
+        }
+    }
+
+    ArbScanner scanner_{{0.0, 0.0, 0.0}, 0.0};
+};
+
+TEST_F(ArbScannerTest, RejectsVenueCountsOutsideTheRegisterWidth) {
+    EXPECT_THROW(ArbScanner({0.001}, 0.0), std::invalid_argument);
+    EXPECT_THROW(ArbScanner({0.0, 0.0, 0.0, 0.0, 0.0}, 0.0), std::invalid_argument);
+    EXPECT_THROW(scanner_.bind(99, 5, 0), std::invalid_argument);
+}
+
+TEST_F(ArbScannerTest, FindsTheCrossingPair) {
+    EXPECT_FALSE(scanner_.update(0, quote(100.0, 1.0, 101.0, 1.0)));
+    EXPECT_FALSE(scanner_.update(1, quote(100.5, 1.0, 101.5, 1.0)));
+    // Venue 2 bids above venue 0's ask
+    EXPECT_TRUE(scanner_.update(2, quote(102.0, 0.5, 103.0, 1.0)));
+
+    const ArbScanner::Opportunity& best = scanner_.best(0);
+    EXPECT_EQ(best.buy_venue, 0u);
+    EXPECT_EQ(best.sell_venue, 2u);
+    EXPECT_EQ(best.buy_price, 101.0);
+    EXPECT_EQ(best.sell_price, 102.0);
+    EXPECT_DOUBLE_EQ(best.quantity, 0.5);
+    EXPECT_DOUBLE_EQ(best.profit, 0.5 * (102.0 - 101.0));
+}
+
+TEST_F(ArbScannerTest, SameVenueNeverPairsWithItself) {
+    // A crossed book on one venue is not an arbitrage between venues
+    EXPECT_FALSE(scanner_.update(0, quote(105.0, 1.0, 100.0, 1.0)));
+    EXPECT_EQ(scanner_.best(0).profit, 0.0);
+}
+
+TEST_F(ArbScannerTest, UnboundInstrumentsAreIgnored) {
+    EXPECT_FALSE(scanner_.update(1000, quote(100.0, 1.0, 101.0, 1.0)));
+}
+
+TEST_F(ArbScannerTest, FeesAndMinProfitRaiseTheHurdle) {
+    ArbScanner scanner({0.001, 0.001}, 0.002);
+    scanner.add_row();
+    scanner.bind(0, 0, 0);
+    scanner.bind(1, 0, 1);
+    scanner.update(0, quote(99.0, 1.0, 100.0, 1.0));
+
+    // Needs bid * 0.999 > 100 * 1.003, i.e. bid > 100.4004
+    EXPECT_FALSE(scanner.update(1, quote(100.40, 1.0, 101.0, 1.0)));
+    EXPECT_TRUE(scanner.update(1, quote(100.41, 1.0, 101.0, 1.0)));
+    EXPECT_NEAR(scanner.best(0).profit, 100.41 * 0.999 - 100.0 * 1.001, 1e-9);
+}
+
+TEST_F(ArbScannerTest, ClearVenueVoidsItsQuotesInEveryRow) {
+    scanner_.update(0, quote(100.0, 1.0, 101.0, 1.0));
+    scanner_.update(2, quote(102.0, 1.0, 103.0, 1.0));
+    scanner_.update(3, quote(200.0, 1.0, 201.0, 1.0));
+    scanner_.update(5, quote(202.0, 1.0, 203.0, 1.0));
+    ASSERT_GT(scanner_.best(0).profit, 0.0);
+    ASSERT_GT(scanner_.best(1).profit, 0.0);
+
+    scanner_.clear_venue(2);
+    EXPECT_EQ(scanner_.best(0).profit, 0.0);
+    EXPECT_EQ(scanner_.best(1).profit, 0.0);
+
+    // Back once the venue quotes again
+    EXPECT_TRUE(scanner_.update(2, quote(102.0, 1.0, 103.0, 1.0)));
+    scanner_.clear_venue(7); // Out of range, ignored
+    EXPECT_GT(scanner_.best(0).profit, 0.0);
+}
+
+TEST_F(ArbScannerTest, RankedOrdersRowsByProfit) {
+    scanner_.update(0, quote(100.0, 1.0, 101.0, 1.0));
+    scanner_.update(1, quote(101.5, 1.0, 102.0, 1.0)); // Row 0 earns 0.5
+    scanner_.update(3, quote(200.0, 2.0, 201.0, 2.0));
+    scanner_.update(4, quote(203.0, 2.0, 204.0, 2.0)); // Row 1 earns 4
+
+    std::vector<ArbScanner::Opportunity> out;
+    ASSERT_EQ(scanner_.ranked(out, 5), 2u);
+    EXPECT_EQ(out[0].row, 1u);
+    EXPECT_DOUBLE_EQ(out[0].profit, 4.0);
+    EXPECT_EQ(out[1].row, 0u);
+    EXPECT_DOUBLE_EQ(out[1].profit, 0.5);
+
+    ASSERT_EQ(scanner_.ranked(out, 1), 1u);
+    EXPECT_EQ(out[0].row, 1u);
+
+    scanner_.clear_venue(1);
+    EXPECT_EQ(scanner_.ranked(out, 5), 0u);
+}
+
+TEST_F(ArbScannerTest, MatchesBruteForceOverRandomQuotes) {
+    const std::vector<double> fees{0.001, 0.0026, 0.0005, 0.002};
+    ArbScanner scanner(fees, 0.0001);
+    scanner.add_row();
+    for (uint32_t v = 0; v < 4; ++v) scanner.bind(v, 0, v);
+
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> price(99.0, 101.0);
+    std::uniform_real_distribution<double> size(0.0, 2.0);
+    std::vector<LevelBook::TopOfBook> tops(4);
+    for (int step = 0; step < 2000; ++step) {
+        const uint32_t v = static_cast<uint32_t>(rng() % 4);
+        const double bid = price(rng);
+        tops[v] = rng() % 10 == 0 ? LevelBook::TopOfBook{} : quote(bid, size(rng), bid + 0.05, size(rng));
+        scanner.update(v, tops[v]);
+
+        double expected = 0.0;
+        for (size_t buy = 0; buy < 4; ++buy) {
+            for (size_t sell = 0; sell < 4; ++sell) {
+                if (buy == sell || tops[buy].ask_quantity <= 0.0 || tops[sell].bid_quantity <= 0.0) continue;
+                const double bid_after = tops[sell].bid_price * (1.0 - fees[sell]);
+                if (bid_after <= tops[buy].ask_price * (1.0 + fees[buy] + 0.0001)) continue;
+                const double quantity = std::min(tops[buy].ask_quantity, tops[sell].bid_quantity);
+                expected = std::max(expected, quantity * (bid_after - tops[buy].ask_price * (1.0 + fees[buy])));
+            }
+        }
+        ASSERT_NEAR(scanner.best(0).profit, expected, 1e-9) << "step " << step;
+    }
+}
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "candle_aggregator.hpp"
+
+namespace {
+constexpr int64_t MS = 1'000'000;
+constexpr int64_t SEC = 1'000'000'000;
+}
+
+class CandleAggregatorTest : public ::testing::Test {
+protected:
+    using Bar = CandleAggregator::CandleBar;
+
+    // Collects emitted bars with their instrument
+    auto collect() {
+        return [this](uint32_t instrument, const Bar& bar) { bars_.emplace_back(instrument, bar); };
+    }
+
+    std::vector<std::pair<uint32_t, Bar>> bars_;
+};
+
+TEST_F(CandleAggregatorTest, ParsesBarSpecs) {
+    BarSpec minute = BarSpec::parse("5m");
+    EXPECT_EQ(minute.kind, BarSpec::Kind::Time);
+    EXPECT_EQ(minute.interval_ns, 300 * SEC);
+    EXPECT_EQ(minute.label, "5m");
+    EXPECT_EQ(BarSpec::parse("250ms").interval_ns, 250 * MS);
+    EXPECT_EQ(BarSpec::parse("1h").interval_ns, 3600 * SEC);
+    EXPECT_EQ(BarSpec::parse("1.5s").interval_ns, 1500 * MS);
+
+    BarSpec volume = BarSpec::parse("2.5vol");
+    EXPECT_EQ(volume.kind, BarSpec::Kind::Volume);
+    EXPECT_EQ(volume.volume, 2.5);
+    BarSpec ticks = BarSpec::parse("100tick");
+    EXPECT_EQ(ticks.kind, BarSpec::Kind::Tick);
+    EXPECT_EQ(ticks.ticks, 100);
+
+    for (const char* bad : {"", "m", "0s", "5x", "5", "0.5ms", "0.5tick", "-1s"}) {
+        EXPECT_THROW(BarSpec::parse(bad), std::invalid_argument) << bad;
+    }
+}
+
+TEST_F(CandleAggregatorTest, TimeBarClosesOnTheFirstTradePastItsEnd) {
+    CandleAggregator candles(2, BarSpec::parse("1s"));
+    candles.on_trade(0, 100 * MS, 10.0, 1.0, collect());
+    candles.on_trade(0, 500 * MS, 12.0, 2.0, collect());
+    candles.on_trade(0, 900 * MS, 9.0, 1.0, collect());
+    EXPECT_TRUE(bars_.empty());
+
+    candles.on_trade(0, 1200 * MS, 11.0, 1.0, collect());
+    ASSERT_EQ(bars_.size(), 1u);
+    EXPECT_EQ(bars_[0].first, 0u);
+    const Bar& bar = bars_[0].second;
+    EXPECT_EQ(bar.open_time, 0);
+    EXPECT_EQ(bar.close_time, SEC);
+    EXPECT_EQ(bar.open, 10.0);
+    EXPECT_EQ(bar.high, 12.0);
+    EXPECT_EQ(bar.low, 9.0);
+    EXPECT_EQ(bar.close, 9.0);
+    EXPECT_EQ(bar.volume, 4.0);
+    EXPECT_EQ(bar.trade_count, 3);
+
+    // The closing trade opened the next interval
+    EXPECT_EQ(candles.bar(0).open_time, SEC);
+    EXPECT_EQ(candles.bar(0).open, 11.0);
+}
+
+TEST_F(CandleAggregatorTest, TimerClosesBarsThatHaveEnded) {
+    CandleAggregator candles(3, BarSpec::parse("1s"));
+    candles.on_trade(0, 1500 * MS, 10.0, 1.0, collect());
+    candles.on_trade(1, 2500 * MS, 20.0, 1.0, collect());
+
+    candles.on_timer(2 * SEC - 1, collect());
+    EXPECT_TRUE(bars_.empty());
+    candles.on_timer(2 * SEC, collect());
+    ASSERT_EQ(bars_.size(), 1u);
+    EXPECT_EQ(bars_[0].first, 0u);
+    EXPECT_EQ(bars_[0].second.close_time, 2 * SEC);
+
+    // Instrument 2 never traded, so it never produces a bar
+    candles.on_timer(10 * SEC, collect());
+    ASSERT_EQ(bars_.size(), 2u);
+    EXPECT_EQ(bars_[1].first, 1u);
+    candles.on_timer(20 * SEC, collect());
+    EXPECT_EQ(bars_.size(), 2u);
+}
+
+TEST_F(CandleAggregatorTest, LateTradesFoldIntoTheNextBar) {
+    CandleAggregator candles(1, BarSpec::parse("1s"));
+    candles.on_trade(0, 1500 * MS, 10.0, 1.0, collect());
+    candles.on_timer(2 * SEC, collect());
+    ASSERT_EQ(bars_.size(), 1u);
+
+    // Stamped inside the bar the timer already emitted: goes into [2s, 3s)
+    candles.on_trade(0, 1800 * MS, 11.0, 2.0, collect());
+    EXPECT_EQ(candles.late(), 1u);
+    EXPECT_EQ(candles.bar(0).open_time, 2 * SEC);
+    EXPECT_EQ(candles.bar(0).volume, 2.0);
+
+    // Out of order within the open bar's own history: counted, still folded in
+    candles.on_trade(0, 1900 * MS, 9.0, 1.0, collect());
+    EXPECT_EQ(candles.late(), 2u);
+    EXPECT_EQ(candles.bar(0).low, 9.0);
+
+    candles.on_timer(3 * SEC, collect());
+    ASSERT_EQ(bars_.size(), 2u);
+    EXPECT_EQ(bars_[1].second.open_time, 2 * SEC); // No interval is emitted twice
+    EXPECT_EQ(bars_[1].second.trade_count, 2);
+}
+
+TEST_F(CandleAggregatorTest, VolumeBarClosesOnTheFillingTrade) {
+    CandleAggregator candles(1, BarSpec::parse("3vol"));
+    candles.on_trade(0, 100, 10.0, 1.0, collect());
+    candles.on_trade(0, 200, 11.0, 1.5, collect());
+    EXPECT_TRUE(bars_.empty());
+    candles.on_timer(1'000 * SEC, collect()); // Only time bars close on the timer
+    EXPECT_TRUE(bars_.empty());
+
+    candles.on_trade(0, 300, 12.0, 1.0, collect());
+    ASSERT_EQ(bars_.size(), 1u);
+    const Bar& bar = bars_[0].second;
+    EXPECT_EQ(bar.open_time, 100);
+    EXPECT_EQ(bar.close_time, 300);
+    EXPECT_EQ(bar.volume, 3.5); // The filling trade is not split
+    EXPECT_EQ(bar.close, 12.0);
+
+    candles.on_trade(0, 400, 13.0, 0.5, collect());
+    EXPECT_EQ(candles.bar(0).open_time, 400);
+}
+
+TEST_F(CandleAggregatorTest, TickBarClosesEveryNTrades) {
+    CandleAggregator candles(1, BarSpec::parse("2tick"));
+    for (int i = 0; i < 5; ++i) candles.on_trade(0, i * 10, 100.0 + i, 1.0, collect());
+    ASSERT_EQ(bars_.size(), 2u);
+    EXPECT_EQ(bars_[0].second.open, 100.0);
+    EXPECT_EQ(bars_[0].second.close, 101.0);
+    EXPECT_EQ(bars_[1].second.open_time, 20);
+    EXPECT_EQ(bars_[1].second.close_time, 30);
+
+    // Shutdown emits the incomplete one
+    candles.flush(collect());
+    ASSERT_EQ(bars_.size(), 3u);
+    EXPECT_EQ(bars_[2].second.trade_count, 1);
+}
+
+class TradeCandlesTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        registry_.add("Binance", "BTCUSDT");
+        registry_.add("Coinbase", "BTC-USD");
+    }
+
+    // Publishes as a parser does, with the views into a frame that is gone afterwards
+    void publish(const std::string& source, const std::string& symbol, int64_t trade_time, double price) {
+        auto frame = std::make_unique<std::string>(source + symbol);
+        std::string_view view(*frame);
+        TradeEvent event{};
+        event.data.source = view.substr(0, source.size());
+        event.data.symbol = view.substr(source.size());
+        event.data.trade_time = trade_time;
+        event.data.price = price;
+        event.data.quantity = 1.0;
+        bus_->publish(event);
+        frame->assign(frame->size(), 'x');
+    }
+
+    std::shared_ptr<EventBus> bus_ = std::make_shared<EventBus>();
+    InstrumentRegistry registry_;
+};
+
+TEST_F(TradeCandlesTest, BuildsBarsPerInstrumentAndSpec) {
+    TradeCandles candles(bus_, registry_, {BarSpec::parse("1s"), BarSpec::parse("2tick")}, 64);
+    publish("Binance", "BTCUSDT", 100 * MS, 50000.0);
+    publish("Coinbase", "BTC-USD", 200 * MS, 50010.0);
+    publish("Binance", "BTCUSDT", 300 * MS, 50005.0);
+    publish("Kraken", "BTC/USD", 400 * MS, 49990.0); // Not in the registry
+
+    std::vector<CandleStickData> out;
+    auto emit = [&](const CandleStickData& c) { out.push_back(c); };
+    candles.poll(500 * MS, emit);
+    ASSERT_EQ(out.size(), 1u);
+    EXPECT_EQ(out[0].source, "Binance");
+    EXPECT_EQ(out[0].symbol, "BTCUSDT");
+    EXPECT_EQ(out[0].interval, "2tick");
+    EXPECT_EQ(out[0].close, 50005.0);
+
+    candles.poll(SEC, emit);
+    ASSERT_EQ(out.size(), 3u);
+    for (size_t i = 1; i < 3; ++i) EXPECT_EQ(out[i].interval, "1s");
+    EXPECT_EQ(out[1].symbol, "BTCUSDT");
+    EXPECT_EQ(out[1].trade_count, 2);
+    EXPECT_EQ(out[2].source, "Coinbase");
+    EXPECT_EQ(out[2].symbol, "BTC-USD");
+    EXPECT_EQ(out[2].open, 50010.0);
+    EXPECT_EQ(candles.dropped_trades(), 0u);
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "cross_arb_search.hpp"
+
+TEST(WalkCrossTest, NoCrossNoFill) {
+    CrossFill fill = walk_cross({{101.0, 1.0}}, {{100.0, 1.0}}, 0.0);
+    EXPECT_EQ(fill.quantity, 0.0);
+    EXPECT_EQ(fill.profit, 0.0);
+}
+
+TEST(WalkCrossTest, EmptySideNoFill) {
+    EXPECT_EQ(walk_cross({}, {{100.0, 1.0}}, 0.0).quantity, 0.0);
+    EXPECT_EQ(walk_cross({{99.0, 1.0}}, {}, 0.0).quantity, 0.0);
+}
+
+TEST(WalkCrossTest, SweepsLevelsWhileTheEdgeLasts) {
+    // Asks ascending, bids descending; the third pair (102 vs 101.5) no longer crosses
+    const std::vector<PriceLevel> asks{{100.0, 1.0}, {101.0, 2.0}, {102.0, 5.0}};
+    const std::vector<PriceLevel> bids{{103.0, 2.0}, {101.5, 4.0}};
+    CrossFill fill = walk_cross(asks, bids, 0.0);
+
+    // 1 @ 100 vs 103, 1 @ 101 vs 103, 1 @ 101 vs 101.5
+    EXPECT_DOUBLE_EQ(fill.quantity, 3.0);
+    EXPECT_DOUBLE_EQ(fill.buy_notional, 100.0 + 101.0 + 101.0);
+    EXPECT_DOUBLE_EQ(fill.sell_notional, 103.0 + 103.0 + 101.5);
+    EXPECT_DOUBLE_EQ(fill.profit, 3.0 + 2.0 + 0.5);
+    EXPECT_EQ(fill.buy_limit, 101.0);
+    EXPECT_EQ(fill.sell_limit, 101.5);
+    EXPECT_DOUBLE_EQ(fill.buy_vwap(), 302.0 / 3.0);
+    EXPECT_DOUBLE_EQ(fill.sell_vwap(), 307.5 / 3.0);
+}
+
+TEST(WalkCrossTest, FeesOnBothLegsStopTheWalkEarlier) {
+    const std::vector<PriceLevel> asks{{100.0, 1.0}, {100.5, 1.0}};
+    const std::vector<PriceLevel> bids{{101.0, 2.0}};
+    // 0.3% a leg: 101 * 0.997 = 100.697 beats 100 * 1.003 = 100.3 but not 100.5 * 1.003 = 100.8015
+    const double fee = 0.003;
+    CrossFill fill = walk_cross(asks, bids, fee);
+    EXPECT_DOUBLE_EQ(fill.quantity, 1.0);
+    EXPECT_NEAR(fill.profit, 101.0 * (1 - fee) - 100.0 * (1 + fee), 1e-9);
+    EXPECT_EQ(fill.buy_limit, 100.0);
+
+    EXPECT_DOUBLE_EQ(walk_cross(asks, bids, 0.0).quantity, 2.0);
+}
+
+TEST(WalkCrossTest, MaxQuantityCapsTheSweep) {
+    const std::vector<PriceLevel> asks{{100.0, 1.0}, {100.2, 1.0}};
+    const std::vector<PriceLevel> bids{{101.0, 5.0}};
+    CrossFill fill = walk_cross(asks, bids, 0.0, 1.5);
+    EXPECT_DOUBLE_EQ(fill.quantity, 1.5);
+    EXPECT_DOUBLE_EQ(fill.buy_notional, 100.0 + 0.5 * 100.2);
+    EXPECT_EQ(fill.buy_limit, 100.2);
+}
+
+TEST(WalkCrossTest, ProfitMatchesBruteForceOverUnitLots) {
+    // Expand every level into unit lots and pair them greedily, best against best
+    const std::vector<PriceLevel> asks{{10.0, 3.0}, {10.4, 2.0}, {10.9, 4.0}};
+    const std::vector<PriceLevel> bids{{11.2, 2.0}, {10.8, 3.0}, {10.1, 6.0}};
+    const double fee = 0.001;
+    std::vector<double> ask_lots;
+    std::vector<double> bid_lots;
+    for (const auto& [price, qty] : asks) ask_lots.insert(ask_lots.end(), static_cast<size_t>(qty), price);
+    for (const auto& [price, qty] : bids) bid_lots.insert(bid_lots.end(), static_cast<size_t>(qty), price);
+
+    double expected = 0.0;
+    double lots = 0.0;
+    for (size_t k = 0; k < std::min(ask_lots.size(), bid_lots.size()); ++k) {
+        const double edge = bid_lots[k] * (1.0 - fee) - ask_lots[k] * (1.0 + fee);
+        if (edge <= 0.0) break;
+        expected += edge;
+        lots += 1.0;
+    }
+
+    CrossFill fill = walk_cross(asks, bids, fee);
+    EXPECT_DOUBLE_EQ(fill.quantity, lots);
+    EXPECT_NEAR(fill.profit, expected, 1e-9);
+}
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include "exchange_simulator.hpp"
+#include "order_template.hpp"
+
+/**
+ * Order-entry client on its own io_context: requests are rendered with the OrderTemplates the
+ * routers use, and every read gives up after a timeout so a missing message fails the test.
+ */
+class SimulatorClient {
+public:
+    explicit SimulatorClient(unsigned short port) : ws_(ioc_) {
+        ws_.next_layer().connect(tcp::endpoint(net::ip::make_address("127.0.0.1"), port));
+        ws_.handshake("127.0.0.1", "/");
+        ws_.text(true);
+    }
+
+    void place(uint64_t request_id, Side side, uint64_t client_order_id, double price, double quantity) {
+        OrderTemplate order = OrderTemplate::binance_place("BTCUSDT", side, OrderType::Limit, 2, 4);
+        send(order.render(request_id, client_order_id, price, quantity));
+    }
+
+    void cancel(uint64_t request_id, uint64_t client_order_id) {
+        OrderTemplate order = OrderTemplate::binance_cancel("BTCUSDT");
+        send(order.render(request_id, client_order_id, 0.0, 0.0));
+    }
+
+    // The next message, or nothing once the connection is gone or `timeout` passed
+    std::optional<json::object> receive(std::chrono::milliseconds timeout = std::chrono::seconds(2)) {
+        if (closed_) return std::nullopt;
+        beast::flat_buffer buffer;
+        beast::error_code result;
+        bool done = false;
+        ws_.async_read(buffer, [&](beast::error_code ec, std::size_t) {
+            result = ec;
+            done = true;
+        });
+        ioc_.restart();
+        ioc_.run_for(timeout);
+        if (!done) {
+            // The pending read can't be resumed; the stream is unusable from here on
+            beast::error_code ignored;
+            ws_.next_layer().close(ignored);
+            ioc_.restart();
+            ioc_.run();
+            closed_ = true;
+            return std::nullopt;
+        }
+        if (result) {
+            closed_ = true;
+            return std::nullopt;
+        }
+        return json::parse(beast::buffers_to_string(buffer.data())).as_object();
+    }
+
+    bool closed() const { return closed_; }
+
+private:
+    void send(std::string_view message) { ws_.write(net::buffer(message)); }
+
+    net::io_context ioc_;
+    websocket::stream<tcp::socket> ws_;
+    bool closed_ = false;
+};
+
+class ExchangeSimulatorTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        ioc_.stop();
+        if (thread_.joinable()) thread_.join();
+    }
+
+    // Listens on a free loopback port and serves on a background thread
+    void start(SimulatorConfig config = {}) {
+        config.port = 0;
+        sim_ = std::make_unique<Simulator>(config);
+        listener_ = std::make_unique<Listener>(ioc_, *sim_, nullptr);
+        listener_->accept();
+        thread_ = std::thread([this] { ioc_.run(); });
+    }
+
+    std::unique_ptr<SimulatorClient> connect() { return std::make_unique<SimulatorClient>(listener_->port()); }
+
+    static std::string str(const json::object& obj, std::string_view key) {
+        return std::string(obj.at(key).as_string());
+    }
+
+    // Declared before the io_context: sessions left in it cancel their orders on destruction
+    std::unique_ptr<Simulator> sim_;
+    net::io_context ioc_;
+    std::unique_ptr<Listener> listener_;
+    std::thread thread_;
+};
+
+TEST_F(ExchangeSimulatorTest, PlacedOrdersAreAckedAndFilled) {
+    start();
+    auto maker = connect();
+    auto taker = connect();
+
+    maker->place(1, Side::Sell, 11, 50000.0, 0.1);
+    auto ack = maker->receive();
+    ASSERT_TRUE(ack);
+    EXPECT_EQ(str(*ack, "id"), "1");
+    EXPECT_EQ(ack->at("status").as_int64(), 200);
+    EXPECT_EQ(str(ack->at("result").as_object(), "status"), "NEW");
+    EXPECT_EQ(str(ack->at("result").as_object(), "clientOrderId"), "11");
+
+    taker->place(2, Side::Buy, 21, 50010.0, 0.1);
+    ack = taker->receive();
+    ASSERT_TRUE(ack);
+    EXPECT_EQ(str(*ack, "id"), "2");
+    EXPECT_EQ(str(ack->at("result").as_object(), "status"), "NEW");
+
+    // Both sides hear about the fill, at the maker's price
+    for (auto* session : {taker.get(), maker.get()}) {
+        auto report = session->receive();
+        ASSERT_TRUE(report);
+        EXPECT_EQ(str(*report, "e"), "executionReport");
+        EXPECT_EQ(str(*report, "X"), "FILLED");
+        EXPECT_EQ(std::stod(str(*report, "l")), 0.1);
+        EXPECT_EQ(std::stod(str(*report, "L")), 50000.0);
+        EXPECT_EQ(str(*report, "c"), session == taker.get() ? "21" : "11");
+    }
+}
+
+TEST_F(ExchangeSimulatorTest, RestingOrderIsCanceledOnce) {
+    start();
+    auto client = connect();
+    client->place(1, Side::Buy, 31, 49000.0, 0.2);
+    ASSERT_TRUE(client->receive());
+
+    client->cancel(2, 31);
+    auto response = client->receive();
+    ASSERT_TRUE(response);
+    EXPECT_EQ(response->at("status").as_int64(), 200);
+    EXPECT_EQ(str(response->at("result").as_object(), "status"), "CANCELED");
+    auto report = client->receive();
+    ASSERT_TRUE(report);
+    EXPECT_EQ(str(*report, "X"), "CANCELED");
+    EXPECT_EQ(str(*report, "c"), "31");
+
+    client->cancel(3, 31);
+    response = client->receive();
+    ASSERT_TRUE(response);
+    EXPECT_EQ(response->at("status").as_int64(), 400);
+    EXPECT_EQ(str(response->at("error").as_object(), "msg"), "Unknown order");
+}
+
+TEST_F(ExchangeSimulatorTest, InjectedRejectNeverReachesTheBook) {
+    SimulatorConfig config;
+    config.reject_rate = 1.0;
+    start(config);
+    auto client = connect();
+
+    client->place(1, Side::Sell, 41, 50000.0, 0.1);
+    auto response = client->receive();
+    ASSERT_TRUE(response);
+    EXPECT_EQ(str(*response, "id"), "1");
+    EXPECT_EQ(response->at("status").as_int64(), 400);
+    EXPECT_EQ(str(response->at("error").as_object(), "msg"), "Order rejected");
+    EXPECT_FALSE(client->receive(std::chrono::milliseconds(100)));
+}
+
+TEST_F(ExchangeSimulatorTest, InjectedDisconnectCancelsTheSessionsOrders) {
+    SimulatorConfig config;
+    config.disconnect_after = 2;
+    start(config);
+    auto maker = connect();
+
+    maker->place(1, Side::Sell, 51, 50000.0, 0.1);
+    ASSERT_TRUE(maker->receive());
+    maker->place(2, Side::Sell, 52, 50001.0, 0.1);
+    ASSERT_TRUE(maker->receive()); // Answered, then the connection is dropped
+    EXPECT_FALSE(maker->receive());
+    EXPECT_TRUE(maker->closed());
+
+    // Nothing of the dropped session's is left to trade against: the buy rests unfilled
+    auto taker = connect();
+    taker->place(1, Side::Buy, 61, 50001.0, 0.2);
+    auto ack = taker->receive();
+    ASSERT_TRUE(ack);
+    EXPECT_EQ(str(ack->at("result").as_object(), "status"), "NEW");
+    EXPECT_FALSE(taker->receive(std::chrono::milliseconds(100)));
+}
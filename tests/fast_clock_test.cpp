@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "fast_clock.hpp"
+#include "utils.hpp"
+
+// Largest offset from CLOCK_REALTIME tolerated while the calibration thread runs
+static constexpr int64_t MAX_DRIFT_NS = 100'000;
+
+TEST(FastClockTest, DriftFromRealtimeStaysBounded) {
+    FastClock::start_calibration_thread(std::chrono::milliseconds(50));
+    int64_t worst = 0;
+    int samples = 0;
+    for (int i = 0; i < 400; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        int64_t before = get_time_now_nano();
+        int64_t fast = FastClock::now_nanos();
+        int64_t after = get_time_now_nano();
+        if (after - before > 20'000) continue; // Preempted between the reads
+        worst = std::max(worst, std::abs(fast - (before + (after - before) / 2)));
+        ++samples;
+    }
+    FastClock::stop_calibration_thread();
+    ASSERT_GT(samples, 100);
+    EXPECT_LT(worst, MAX_DRIFT_NS) << "using_tsc=" << FastClock::using_tsc();
+}
+
+TEST(FastClockTest, NeverGoesBackwardsAcrossRecalibrations) {
+    FastClock::start_calibration_thread(std::chrono::milliseconds(1));
+    std::atomic<int> backwards{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&backwards] {
+            int64_t last = FastClock::now_nanos();
+            const int64_t end = last + 300'000'000;
+            while (last < end) {
+                int64_t now = FastClock::now_nanos();
+                if (now < last) backwards.fetch_add(1, std::memory_order_relaxed);
+                last = std::max(last, now);
+            }
+        });
+    }
+    for (auto& reader : readers) reader.join();
+    FastClock::stop_calibration_thread();
+    EXPECT_EQ(backwards.load(), 0);
+}
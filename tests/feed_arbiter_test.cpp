@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "feed_arbiter.hpp"
+
+class FeedArbiterTest : public ::testing::Test {
+protected:
+    static RawMessage depth(uint64_t final_id, uint64_t socket_rx) {
+        RawMessage m;
+        m.payload = "{\"stream\":\"btcusdt@depth@100ms\",\"data\":{\"e\":\"depthUpdate\",\"E\":1700000000000,"
+                    "\"s\":\"BTCUSDT\",\"U\":" + std::to_string(final_id) + ",\"u\":" + std::to_string(final_id) +
+                    ",\"b\":[[\"100.0\",\"1.0\"]],\"a\":[]}}";
+        m.trace.socket_rx = socket_rx;
+        return m;
+    }
+};
+
+TEST_F(FeedArbiterTest, FirstCopyWinsAndLaterCopiesAreRejected) {
+    FeedArbiter arbiter(&FeedArbiter::binance_key, 2);
+
+    // Connection 0 leads on odd IDs, connection 1 on even ones
+    for (uint64_t id = 1; id <= 10; ++id) {
+        uint32_t leader = id % 2 ? 0 : 1;
+        EXPECT_TRUE(arbiter.accept(leader, depth(id, 1000 * id)));
+        EXPECT_FALSE(arbiter.accept(1 - leader, depth(id, 1000 * id + 500)));
+    }
+
+    EXPECT_EQ(arbiter.unique_messages(), 10u);
+    EXPECT_EQ(arbiter.stats(0).wins.load(), 5u);
+    EXPECT_EQ(arbiter.stats(1).wins.load(), 5u);
+    EXPECT_EQ(arbiter.stats(0).duplicates.load(), 5u);
+    EXPECT_EQ(arbiter.stats(1).duplicates.load(), 5u);
+    EXPECT_DOUBLE_EQ(arbiter.win_rate(0), 0.5);
+    EXPECT_DOUBLE_EQ(arbiter.win_rate(1), 0.5);
+    EXPECT_GT(arbiter.stats(1).lag_ns_max.load(), 0u);
+}
+
+TEST_F(FeedArbiterTest, WinRateFollowsTheFasterConnection) {
+    FeedArbiter arbiter(&FeedArbiter::binance_key, 3);
+    for (uint64_t id = 1; id <= 8; ++id) {
+        uint32_t leader = id <= 6 ? 2 : 0;
+        EXPECT_TRUE(arbiter.accept(leader, depth(id, id)));
+        for (uint32_t c = 0; c < 3; ++c) {
+            if (c != leader) {
+                EXPECT_FALSE(arbiter.accept(c, depth(id, id)));
+            }
+        }
+    }
+    EXPECT_DOUBLE_EQ(arbiter.win_rate(2), 0.75);
+    EXPECT_DOUBLE_EQ(arbiter.win_rate(0), 0.25);
+    EXPECT_DOUBLE_EQ(arbiter.win_rate(1), 0.0);
+}
+
+TEST_F(FeedArbiterTest, DifferentStreamsWithTheSameIdAreDistinct) {
+    FeedArbiter arbiter(&FeedArbiter::binance_key, 2);
+    RawMessage eth = depth(7, 1);
+    eth.payload.replace(eth.payload.find("btcusdt"), 7, "ethusdt");
+    EXPECT_TRUE(arbiter.accept(0, depth(7, 1)));
+    EXPECT_TRUE(arbiter.accept(0, eth));
+    EXPECT_FALSE(arbiter.accept(1, eth));
+}
+
+TEST_F(FeedArbiterTest, WindowKeepsTheLastUniqueMessages) {
+    constexpr size_t window = 8;
+    FeedArbiter arbiter(&FeedArbiter::binance_key, 2, window);
+
+    // Every step evicts one fingerprint; a copy still inside the window must keep being found
+    // while the OrderIdMap shifts probe chains around the erased keys
+    for (uint64_t id = 1; id <= 200; ++id) {
+        ASSERT_TRUE(arbiter.accept(0, depth(id, id)));
+        uint64_t oldest = id >= window ? id - window + 1 : 1;
+        EXPECT_FALSE(arbiter.accept(1, depth(oldest, id))) << "id " << id;
+    }
+    EXPECT_EQ(arbiter.unique_messages(), 200u);
+    EXPECT_EQ(arbiter.stats(1).duplicates.load(), 200u);
+}
+
+TEST_F(FeedArbiterTest, CopyOlderThanTheWindowIsAcceptedAgain) {
+    FeedArbiter arbiter(&FeedArbiter::binance_key, 2, 4);
+    for (uint64_t id = 1; id <= 4; ++id) ASSERT_TRUE(arbiter.accept(0, depth(id, id)));
+    EXPECT_FALSE(arbiter.accept(1, depth(1, 5)));
+
+    ASSERT_TRUE(arbiter.accept(0, depth(5, 6))); // Evicts 1
+    EXPECT_TRUE(arbiter.accept(1, depth(1, 7)));
+    EXPECT_FALSE(arbiter.accept(1, depth(5, 8)));
+}
+
+TEST_F(FeedArbiterTest, FramesWithoutAnIdFallBackToThePayload) {
+    FeedArbiter arbiter(&FeedArbiter::coinbase_key, 2);
+    RawMessage heartbeat;
+    heartbeat.payload = "{\"type\":\"subscriptions\",\"channels\":[]}";
+    RawMessage other;
+    other.payload = "{\"type\":\"subscriptions\",\"channels\":[1]}";
+
+    EXPECT_TRUE(arbiter.accept(0, heartbeat));
+    EXPECT_FALSE(arbiter.accept(1, heartbeat));
+    EXPECT_TRUE(arbiter.accept(1, other));
+}
@@ -0,0 +1,239 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/ssl.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/beast/websocket.hpp>
+#include <boost/beast/websocket/ssl.hpp>
+#include "kraken_exchange.hpp"
+#include "self_signed_certificate.hpp"
+
+namespace http = beast::http;
+namespace websocket = beast::websocket;
+
+/**
+ * TLS WebSocket stand-in for a venue on 127.0.0.1. Connections are served one at a time, the
+ * i-th by scripts[i], and every message a client sends is recorded.
+ */
+class LoopbackVenue {
+public:
+    using Stream = websocket::stream<beast::ssl_stream<tcp::socket>>;
+
+    class Session {
+    public:
+        Session(Stream& ws, LoopbackVenue& venue) : ws_(ws), venue_(venue) {}
+
+        // Blocks for the client's next message and records it; false once the client is gone
+        bool receive() {
+            beast::flat_buffer buffer;
+            beast::error_code ec;
+            ws_.read(buffer, ec);
+            if (ec) return false;
+            std::lock_guard<std::mutex> lock(venue_.mutex_);
+            venue_.received_.push_back(beast::buffers_to_string(buffer.data()));
+            return true;
+        }
+
+        void send(const std::string& frame) { ws_.write(net::buffer(frame)); }
+
+        // Reads, answering pings, until the client closes or drops the connection
+        void hold() {
+            while (receive()) {}
+        }
+
+        // Resets the TCP connection without a close frame
+        void drop() {
+            beast::error_code ignored;
+            beast::get_lowest_layer(ws_).close(ignored);
+        }
+
+    private:
+        Stream& ws_;
+        LoopbackVenue& venue_;
+    };
+
+    using Script = std::function<void(Session&)>;
+
+    explicit LoopbackVenue(std::vector<Script> scripts)
+        : tls_(ssl::context::tlsv12_server), acceptor_(ioc_, {net::ip::make_address("127.0.0.1"), 0}),
+          scripts_(std::move(scripts)) {
+        use_self_signed_certificate(tls_);
+        thread_ = std::thread([this] { serve(); });
+    }
+
+    ~LoopbackVenue() {
+        // A client that never came back leaves accept() waiting: connect to release it
+        while (served_ < scripts_.size()) {
+            beast::error_code ignored;
+            tcp::socket socket(ioc_);
+            socket.connect(acceptor_.local_endpoint(), ignored);
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        thread_.join();
+    }
+
+    std::string port() const { return std::to_string(acceptor_.local_endpoint().port()); }
+
+    std::vector<std::string> received() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return received_;
+    }
+
+    std::vector<std::string> targets() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return targets_;
+    }
+
+private:
+    void serve() {
+        for (const Script& script : scripts_) {
+            try {
+                tcp::socket socket(ioc_);
+                acceptor_.accept(socket);
+                Stream ws(std::move(socket), tls_);
+                ws.next_layer().handshake(ssl::stream_base::server);
+                beast::flat_buffer buffer;
+                http::request<http::string_body> request;
+                http::read(ws.next_layer(), buffer, request);
+                ws.text(true);
+                ws.accept(request);
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    targets_.emplace_back(request.target());
+                }
+                Session session(ws, *this);
+                script(session);
+            } catch (const std::exception&) {
+                // The client went away mid-script, or the destructor's release connection
+            }
+            ++served_;
+        }
+    }
+
+    net::io_context ioc_;
+    ssl::context tls_;
+    tcp::acceptor acceptor_;
+    std::vector<Script> scripts_;
+    std::thread thread_;
+    std::atomic<size_t> served_{0};
+    std::mutex mutex_;
+    std::vector<std::string> received_;
+    std::vector<std::string> targets_;
+};
+
+class FeedReconnectTest : public ::testing::Test {
+protected:
+    // The exchange goes first: the venue's last session holds until the client closes
+    void TearDown() override {
+        if (exchange_) exchange_->stop();
+        if (io_thread_.joinable()) io_thread_.join();
+        venue_.reset();
+    }
+
+    // Starts the venue and a KrakenExchange subscribed to it
+    void start(std::vector<LoopbackVenue::Script> scripts, size_t queue_capacity = 1024) {
+        venue_ = std::make_unique<LoopbackVenue>(std::move(scripts));
+        queue_ = std::make_unique<SPSCQueue<RawMessage>>(queue_capacity);
+        ReconnectPolicy policy;
+        policy.initial_backoff = std::chrono::milliseconds(20);
+        policy.max_backoff = std::chrono::milliseconds(200);
+        policy.stale_after = std::chrono::milliseconds(300);
+        policy.connect_timeout = std::chrono::milliseconds(2000);
+        exchange_ = std::make_shared<KrakenExchange>(*queue_);
+        exchange_->set_reconnect_policy(policy);
+        exchange_->initialize("127.0.0.1", venue_->port(), "/v2", subscription_);
+        exchange_->start();
+        io_thread_ = std::thread([this] { exchange_->run(); });
+    }
+
+    // Pops until `count` entries arrived or the deadline passed, markers as "<state>"
+    std::vector<std::string> drain(size_t count, std::chrono::milliseconds timeout = std::chrono::seconds(5)) {
+        std::vector<std::string> out;
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        RawMessage m;
+        while (out.size() < count && std::chrono::steady_clock::now() < deadline) {
+            if (!queue_->try_pop(m)) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                continue;
+            }
+            out.push_back(m.feed_status ? marker(m.state) : std::string(m.payload));
+        }
+        return out;
+    }
+
+    static std::string marker(FeedState state) { return "<" + std::to_string(static_cast<int>(state)) + ">"; }
+
+    static bool wait_until(const std::function<bool()>& done) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!done()) {
+            if (std::chrono::steady_clock::now() >= deadline) return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return true;
+    }
+
+    json::object subscription_{{"method", "subscribe"},
+                               {"params", json::object{{"channel", "book"}, {"symbol", json::array{"BTC/USD"}}}}};
+    std::unique_ptr<LoopbackVenue> venue_;
+    std::unique_ptr<SPSCQueue<RawMessage>> queue_;
+    std::shared_ptr<KrakenExchange> exchange_;
+    std::thread io_thread_;
+};
+
+TEST_F(FeedReconnectTest, DropAndStallReconnectAndResubscribe) {
+    start({
+        [](LoopbackVenue::Session& s) {
+            s.receive();
+            s.send("a1");
+            s.send("a2");
+            s.drop();
+        },
+        [](LoopbackVenue::Session& s) {
+            s.receive();
+            s.send("b1");
+            s.hold(); // Silent until the client gives up on it
+        },
+        [](LoopbackVenue::Session& s) {
+            s.receive();
+            s.send("c1");
+            s.hold();
+        },
+    });
+
+    const std::string connected = marker(FeedState::Connected);
+    EXPECT_EQ(drain(9), (std::vector<std::string>{connected, "a1", "a2", marker(FeedState::Disconnected), connected,
+                                                  "b1", marker(FeedState::Stale), connected, "c1"}));
+
+    // Every connection was subscribed afresh
+    const std::string subscribe = json::serialize(subscription_);
+    ASSERT_TRUE(wait_until([&] { return venue_->received().size() >= 3; }));
+    EXPECT_EQ(venue_->received(), std::vector<std::string>(3, subscribe));
+    EXPECT_EQ(venue_->targets(), std::vector<std::string>(3, "/v2"));
+}
+
+TEST_F(FeedReconnectTest, GapResubscribesOnTheLiveConnection) {
+    start({
+        [](LoopbackVenue::Session& s) {
+            s.receive();
+            for (int i = 0; i < 16; ++i) s.send("f" + std::to_string(i));
+            s.hold();
+        },
+    }, 4);
+
+    // The reader overran the queue: the venue is asked for the subscription again
+    ASSERT_TRUE(wait_until([&] { return venue_->received().size() >= 3; }));
+    json::object unsubscribe = subscription_;
+    unsubscribe["method"] = "unsubscribe";
+    EXPECT_EQ(venue_->received(), (std::vector<std::string>{json::serialize(subscription_), json::serialize(unsubscribe),
+                                                          json::serialize(subscription_)}));
+    EXPECT_GT(exchange_->dropped_messages(), 0u);
+
+    // Three slots of the four: what fitted, then the marker that was waiting behind them
+    EXPECT_EQ(drain(4), (std::vector<std::string>{marker(FeedState::Connected), "f0", "f1", marker(FeedState::Gap)}));
+}
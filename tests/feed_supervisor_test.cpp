@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "feed_supervisor.hpp"
+
+class FeedSupervisorTest : public ::testing::Test {
+protected:
+    static RawMessage frame(const std::string& payload) {
+        RawMessage m;
+        m.payload = payload;
+        return m;
+    }
+
+    // Everything in the queue, markers as "<state>"
+    std::vector<std::string> drain() {
+        std::vector<std::string> out;
+        RawMessage m;
+        while (queue_.try_pop(m)) {
+            out.push_back(m.feed_status ? "<" + std::to_string(static_cast<int>(m.state)) + ">" : m.payload);
+        }
+        return out;
+    }
+
+    static std::string marker(FeedState state) { return "<" + std::to_string(static_cast<int>(state)) + ">"; }
+
+    boost::asio::io_context ioc_;
+    SPSCQueue<RawMessage> queue_{4};
+    FeedSupervisor supervisor_{ioc_, queue_, "test"};
+};
+
+TEST_F(FeedSupervisorTest, DroppedFramesAreFollowedByOneGapMarker) {
+    supervisor_.set_connection(3);
+    size_t accepted = 0;
+    for (int i = 0; i < 10; ++i) accepted += supervisor_.push(frame("f" + std::to_string(i)));
+    ASSERT_LT(accepted, 10u);
+
+    std::vector<std::string> first = drain();
+    EXPECT_EQ(first.size(), accepted);
+
+    // The next push flushes the marker ahead of itself
+    EXPECT_TRUE(supervisor_.push(frame("after")));
+    EXPECT_EQ(drain(), (std::vector<std::string>{marker(FeedState::Gap), "after"}));
+}
+
+TEST_F(FeedSupervisorTest, GapMarkerCarriesTheConnection) {
+    supervisor_.set_connection(3);
+    while (supervisor_.push(frame("x"))) {}
+    drain();
+    ASSERT_TRUE(supervisor_.push(frame("y")));
+
+    RawMessage m;
+    ASSERT_TRUE(queue_.try_pop(m));
+    EXPECT_TRUE(m.feed_status);
+    EXPECT_EQ(m.state, FeedState::Gap);
+    EXPECT_EQ(m.connection, 3u);
+}
+
+TEST_F(FeedSupervisorTest, GapResubscribesOncePerRunOfDrops) {
+    int resyncs = 0;
+    supervisor_.set_resync([&] { ++resyncs; });
+    supervisor_.start();
+    supervisor_.on_connected();
+    drain();
+    for (int i = 0; i < 10; ++i) supervisor_.push(frame("x"));
+    EXPECT_EQ(resyncs, 1);
+    EXPECT_EQ(supervisor_.resyncs(), 1u);
+
+    // A fresh run of drops after the queue drained asks again
+    drain();
+    ASSERT_TRUE(supervisor_.push(frame("y")));
+    for (int i = 0; i < 10; ++i) supervisor_.push(frame("x"));
+    EXPECT_EQ(resyncs, 2);
+    supervisor_.stop();
+}
+
+TEST_F(FeedSupervisorTest, BackoffGrowsWithJitterAndStaysBounded) {
+    ReconnectPolicy policy;
+    policy.initial_backoff = std::chrono::milliseconds(100);
+    policy.max_backoff = std::chrono::milliseconds(1000);
+    policy.multiplier = 2.0;
+    policy.jitter = 0.5;
+    supervisor_.set_policy(policy);
+
+    // Each delay falls in the jittered upper half of its exponential step
+    std::vector<int64_t> capped;
+    for (int attempt = 0; attempt < 24; ++attempt) {
+        const int64_t base = std::min<int64_t>(100 << std::min(attempt, 10), 1000);
+        const int64_t delay = supervisor_.next_backoff().count();
+        EXPECT_GE(delay, base / 2) << "attempt " << attempt;
+        EXPECT_LE(delay, base) << "attempt " << attempt;
+        if (base == 1000) capped.push_back(delay);
+    }
+    // At the cap only the jitter varies, and it does
+    std::sort(capped.begin(), capped.end());
+    EXPECT_GT(std::unique(capped.begin(), capped.end()) - capped.begin(), 1);
+
+    // A frame from the reconnected feed starts over
+    supervisor_.on_frame(0);
+    EXPECT_LE(supervisor_.next_backoff().count(), 100);
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "indicators.hpp"
+
+TEST(TimeWindowSumsTest, ExpiresSamplesAtTheWindowEdge) {
+    TimeWindowSums<2> sums(100, 16);
+    sums.push(0, {1.0, 10.0});
+    sums.push(50, {2.0, 20.0});
+    EXPECT_EQ(sums.count(), 2u);
+    EXPECT_EQ(sums.sum(0), 3.0);
+
+    // now - window is the cutoff, and a sample exactly at it is out
+    sums.push(100, {4.0, 40.0});
+    EXPECT_EQ(sums.count(), 2u);
+    EXPECT_EQ(sums.sum(0), 6.0);
+    EXPECT_EQ(sums.sum(1), 60.0);
+
+    sums.expire(149);
+    EXPECT_EQ(sums.count(), 2u);
+    sums.expire(150);
+    EXPECT_EQ(sums.count(), 1u);
+    EXPECT_EQ(sums.sum(0), 4.0);
+    sums.expire(1000);
+    EXPECT_EQ(sums.count(), 0u);
+    EXPECT_EQ(sums.sum(1), 0.0);
+}
+
+TEST(TimeWindowSumsTest, FullRingEvictsTheOldest) {
+    TimeWindowSums<1> sums(1'000'000, 4);
+    for (int i = 1; i <= 6; ++i) sums.push(i, {static_cast<double>(i)});
+    // Capacity rounds to 4: only 3..6 are left though all are inside the window
+    EXPECT_EQ(sums.count(), 4u);
+    EXPECT_EQ(sums.sum(0), 3.0 + 4.0 + 5.0 + 6.0);
+}
+
+TEST(TimeWindowSumsTest, RebuildClearsRoundOffOncePerLap) {
+    TimeWindowSums<1> sums(1'000'000, 4);
+    // 1e16 + 1 rounds, so removing the large sample leaves the sum of the small ones off
+    sums.push(0, {1e16});
+    for (int i = 1; i <= 4; ++i) sums.push(i, {1.0});
+    ASSERT_EQ(sums.count(), 4u);
+    EXPECT_NE(sums.sum(0), 4.0);
+
+    // Finish the lap: the sums are rebuilt from what the ring holds
+    for (int i = 5; i <= 7; ++i) sums.push(i, {1.0});
+    EXPECT_EQ(sums.sum(0), 4.0);
+}
+
+TEST(TimeWindowSumsTest, RejectsNonPositiveWindow) {
+    EXPECT_THROW(TimeWindowSums<1>(0, 4), std::invalid_argument);
+}
+
+TEST(RollingVwapTest, WeightsByVolumeOverTheWindow) {
+    RollingVwap vwap(1000, 16);
+    EXPECT_EQ(vwap.value(), 0.0);
+    vwap.update(0, 100.0, 1.0);
+    EXPECT_DOUBLE_EQ(vwap.update(10, 110.0, 3.0), (100.0 + 330.0) / 4.0);
+    EXPECT_DOUBLE_EQ(vwap.volume(), 4.0);
+
+    // The first trade leaves the window
+    vwap.expire(1000);
+    EXPECT_DOUBLE_EQ(vwap.value(), 110.0);
+    vwap.expire(1010);
+    EXPECT_EQ(vwap.value(), 0.0);
+    EXPECT_EQ(vwap.volume(), 0.0);
+}
+
+TEST(RealizedVolatilityTest, SumsSquaredLogReturns) {
+    RealizedVolatility vol(1000, 16);
+    EXPECT_EQ(vol.update(0, 100.0), 0.0); // No return from a single price
+    EXPECT_EQ(vol.returns(), 0u);
+    vol.update(10, 110.0);
+    vol.update(20, 100.0);
+    const double r = std::log(1.1);
+    EXPECT_EQ(vol.returns(), 2u);
+    EXPECT_NEAR(vol.variance(), 2.0 * r * r, 1e-15);
+    EXPECT_NEAR(vol.value(), std::sqrt(2.0) * r, 1e-15);
+
+    vol.expire(1010); // Return stamped at 10 expires
+    EXPECT_EQ(vol.returns(), 1u);
+    EXPECT_NEAR(vol.value(), r, 1e-15);
+}
+
+TEST(TimeEmaTest, DecaysWithElapsedTime) {
+    TimeEma ema(100);
+    EXPECT_FALSE(ema.ready());
+    EXPECT_EQ(ema.update(0, 0.0), 0.0); // The first sample seeds it
+    EXPECT_TRUE(ema.ready());
+    EXPECT_NEAR(ema.update(100, 1.0), 1.0 - std::exp(-1.0), 1e-15);
+}
+
+TEST(TimeEmaTest, BurstMovesNoFurtherThanOneTick) {
+    TimeEma burst(100);
+    TimeEma single(100);
+    burst.update(0, 0.0);
+    single.update(0, 0.0);
+    for (int64_t t = 10; t <= 100; t += 10) burst.update(t, 1.0);
+    single.update(100, 1.0);
+    EXPECT_NEAR(burst.value(), single.value(), 1e-12);
+}
+
+TEST(TimeEmaTest, IgnoresSamplesThatDoNotAdvanceTime) {
+    TimeEma ema(100);
+    ema.update(100, 5.0);
+    EXPECT_EQ(ema.update(100, 50.0), 5.0);
+    EXPECT_EQ(ema.update(40, 50.0), 5.0);
+    EXPECT_THROW(TimeEma(0), std::invalid_argument);
+}
+
+TEST(AggressorSignTest, MapsNormalizedSides) {
+    EXPECT_EQ(aggressor_sign("buy"), 1);
+    EXPECT_EQ(aggressor_sign("sell"), -1);
+    EXPECT_EQ(aggressor_sign(""), 0);
+}
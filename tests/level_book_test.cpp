@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "binance_fast_parser.hpp"
+#include "coinbase_fast_parser.hpp"
+#include "level_book.hpp"
+
+class LevelBookTest : public ::testing::Test {
+protected:
+    static OrderBookData diff(std::vector<PriceLevel> bids, std::vector<PriceLevel> asks) {
+        OrderBookData update;
+        update.bids = std::move(bids);
+        update.asks = std::move(asks);
+        return update;
+    }
+
+    static OrderBookData snapshot(int64_t last_id, std::vector<PriceLevel> bids, std::vector<PriceLevel> asks) {
+        OrderBookData update = diff(std::move(bids), std::move(asks));
+        update.snapshot = true;
+        update.id = last_id;
+        return update;
+    }
+
+    // A Binance depthUpdate covering IDs first..last
+    static OrderBookData sequenced(int64_t first, int64_t last, std::vector<PriceLevel> bids,
+                                   std::vector<PriceLevel> asks) {
+        OrderBookData update = diff(std::move(bids), std::move(asks));
+        update.first_id = first;
+        update.id = last;
+        return update;
+    }
+
+    LevelBook book_;
+};
+
+TEST_F(LevelBookTest, KeepsSidesSortedBestFirst) {
+    book_.apply(snapshot(0, {}, {}));
+    book_.apply(diff({{99.0, 1.0}, {101.0, 2.0}, {100.0, 3.0}}, {{103.0, 1.0}, {102.0, 2.0}}));
+    EXPECT_EQ(book_.bids(), (std::vector<PriceLevel>{{101.0, 2.0}, {100.0, 3.0}, {99.0, 1.0}}));
+    EXPECT_EQ(book_.asks(), (std::vector<PriceLevel>{{102.0, 2.0}, {103.0, 1.0}}));
+}
+
+TEST_F(LevelBookTest, ZeroQuantityRemovesAndOtherQuantitiesReplace) {
+    book_.apply(snapshot(0, {{100.0, 1.0}, {99.0, 1.0}}, {{101.0, 1.0}}));
+    book_.apply(diff({{100.0, 0.0}, {99.0, 4.0}, {98.0, 0.0}}, {}));
+    EXPECT_EQ(book_.bids(), (std::vector<PriceLevel>{{99.0, 4.0}}));
+}
+
+TEST_F(LevelBookTest, ReportsOnlyTopOfBookChanges) {
+    EXPECT_TRUE(book_.apply(snapshot(0, {{100.0, 1.0}}, {{101.0, 1.0}})));
+    EXPECT_FALSE(book_.apply(diff({{99.0, 5.0}}, {{102.0, 5.0}}))); // Below the top
+    EXPECT_TRUE(book_.apply(diff({{100.0, 2.0}}, {})));              // Quantity at the top
+    EXPECT_TRUE(book_.apply(diff({}, {{101.0, 0.0}})));              // Best ask removed
+    EXPECT_EQ(book_.top().ask_price, 102.0);
+}
+
+TEST_F(LevelBookTest, SnapshotReplacesTheWholeBook) {
+    book_.apply(snapshot(0, {{100.0, 1.0}, {95.0, 1.0}}, {{105.0, 1.0}}));
+    book_.apply(diff({{96.0, 1.0}}, {}));
+    book_.apply(snapshot(10, {{99.0, 2.0}}, {{101.0, 3.0}}));
+    EXPECT_EQ(book_.bids(), (std::vector<PriceLevel>{{99.0, 2.0}}));
+    EXPECT_EQ(book_.asks(), (std::vector<PriceLevel>{{101.0, 3.0}}));
+    EXPECT_EQ(book_.last_id(), 10);
+}
+
+TEST_F(LevelBookTest, UnsequencedDiffsWaitForASnapshot) {
+    EXPECT_FALSE(book_.apply(diff({{100.0, 1.0}}, {{101.0, 1.0}})));
+    EXPECT_TRUE(book_.empty());
+
+    book_.apply(snapshot(0, {{99.0, 1.0}}, {{102.0, 1.0}}));
+    EXPECT_TRUE(book_.apply(diff({{100.0, 1.0}}, {})));
+    EXPECT_EQ(book_.top().bid_price, 100.0);
+}
+
+TEST_F(LevelBookTest, UnsequencedDiffsAreIgnoredAfterClear) {
+    book_.apply(snapshot(0, {{100.0, 1.0}}, {{101.0, 1.0}}));
+    book_.clear(); // Gap or disconnect on a venue without sequence numbers
+
+    // Levels seen since the clear are only part of the book; a top built from them is wrong
+    EXPECT_FALSE(book_.apply(diff({{100.5, 1.0}}, {{100.6, 1.0}})));
+    EXPECT_TRUE(book_.empty());
+
+    book_.apply(snapshot(0, {{100.2, 1.0}}, {{100.9, 1.0}}));
+    EXPECT_TRUE(book_.apply(diff({{100.5, 1.0}}, {})));
+    EXPECT_EQ(book_.bids(), (std::vector<PriceLevel>{{100.5, 1.0}, {100.2, 1.0}}));
+}
+
+TEST_F(LevelBookTest, SequencedDiffsWaitForASnapshot) {
+    EXPECT_FALSE(book_.apply(sequenced(1, 5, {{100.0, 1.0}}, {})));
+    EXPECT_TRUE(book_.empty());
+
+    book_.apply(snapshot(5, {{100.0, 1.0}}, {{101.0, 1.0}}));
+    EXPECT_TRUE(book_.apply(sequenced(6, 8, {{100.5, 1.0}}, {})));
+    EXPECT_EQ(book_.top().bid_price, 100.5);
+    EXPECT_EQ(book_.last_id(), 8);
+}
+
+TEST_F(LevelBookTest, DiffsTheSnapshotCoversAreSkipped) {
+    book_.apply(snapshot(10, {{100.0, 1.0}}, {{101.0, 1.0}}));
+    EXPECT_FALSE(book_.apply(sequenced(7, 9, {{100.0, 0.0}}, {})));
+    EXPECT_EQ(book_.top().bid_price, 100.0);
+
+    // Straddles the snapshot: U <= lastUpdateId + 1 <= u, the first diff Binance says to apply
+    EXPECT_TRUE(book_.apply(sequenced(9, 12, {{100.2, 1.0}}, {})));
+    EXPECT_EQ(book_.last_id(), 12);
+    EXPECT_EQ(book_.gaps(), 0u);
+}
+
+TEST_F(LevelBookTest, MissingIdsClearTheBookUntilTheNextSnapshot) {
+    book_.apply(snapshot(10, {{100.0, 1.0}}, {{101.0, 1.0}}));
+    ASSERT_FALSE(book_.apply(sequenced(11, 12, {{99.0, 1.0}}, {})));
+
+    // 13 never arrived
+    EXPECT_TRUE(book_.apply(sequenced(14, 15, {{100.1, 1.0}}, {})));
+    EXPECT_TRUE(book_.empty());
+    EXPECT_EQ(book_.gaps(), 1u);
+
+    // Nothing applies until a snapshot reseeds it
+    EXPECT_FALSE(book_.apply(sequenced(16, 17, {{100.1, 1.0}}, {})));
+    EXPECT_TRUE(book_.empty());
+    book_.apply(snapshot(17, {{100.3, 1.0}}, {{101.0, 1.0}}));
+    EXPECT_TRUE(book_.apply(sequenced(18, 18, {{100.4, 1.0}}, {})));
+    EXPECT_EQ(book_.top().bid_price, 100.4);
+}
+
+TEST_F(LevelBookTest, ClearUnseedsASequencedBook) {
+    book_.apply(snapshot(10, {{100.0, 1.0}}, {{101.0, 1.0}}));
+    book_.clear();
+    EXPECT_EQ(book_.last_id(), 0);
+    EXPECT_FALSE(book_.apply(sequenced(11, 12, {{100.0, 1.0}}, {})));
+    EXPECT_TRUE(book_.empty());
+}
+
+TEST_F(LevelBookTest, BinanceFramesBuildTheBook) {
+    const std::string partial =
+        R"({"stream":"btcusdt@depth20@100ms","data":{"lastUpdateId":160,)"
+        R"("bids":[["100.00","1.0"],["99.00","2.0"]],"asks":[["101.00","3.0"],["102.00","4.0"]]}})";
+    const std::string update =
+        R"({"stream":"btcusdt@depth@100ms","data":{"e":"depthUpdate","E":1700000000000,"s":"BTCUSDT",)"
+        R"("U":161,"u":163,"b":[["100.00","0.0"]],"a":[["101.50","1.5"]]}})";
+
+    book_.apply(BinanceFastParser::parse_partial_depth(partial.data(), partial.size()));
+    OrderBookData diff = BinanceFastParser::parse_depth_update(update.data(), update.size());
+    EXPECT_EQ(diff.first_id, 161);
+    EXPECT_EQ(diff.id, 163);
+    // Each side holds only its own levels
+    EXPECT_EQ(diff.bids, (std::vector<PriceLevel>{{100.0, 0.0}}));
+    EXPECT_EQ(diff.asks, (std::vector<PriceLevel>{{101.5, 1.5}}));
+
+    EXPECT_TRUE(book_.apply(diff));
+    EXPECT_EQ(book_.bids(), (std::vector<PriceLevel>{{99.0, 2.0}}));
+    EXPECT_EQ(book_.asks(), (std::vector<PriceLevel>{{101.0, 3.0}, {101.5, 1.5}, {102.0, 4.0}}));
+}
+
+TEST_F(LevelBookTest, CoinbaseFramesBuildTheBook) {
+    const std::string snap =
+        R"({"type":"snapshot","product_id":"BTC-USD","bids":[["100.00","1.0"],["99.00","2.0"]],)"
+        R"("asks":[["101.00","3.0"],["102.00","4.0"]]})";
+    const std::string update =
+        R"({"type":"l2update","product_id":"BTC-USD","changes":[["buy","100.00","0.0"],)"
+        R"(["sell","101.50","1.5"],["buy","99.50","0.5"]],"time":"2024-01-01T00:00:00.000000Z"})";
+
+    OrderBookData seed = CoinbaseFastParser::parse_snapshot(snap.data(), snap.size());
+    EXPECT_TRUE(seed.snapshot);
+    EXPECT_EQ(seed.symbol, "BTC-USD");
+    book_.apply(seed);
+
+    // Every change is kept, the first one included
+    OrderBookData diff = CoinbaseFastParser::parse_depth_update(update.data(), update.size());
+    EXPECT_FALSE(diff.snapshot);
+    EXPECT_EQ(diff.bids, (std::vector<PriceLevel>{{100.0, 0.0}, {99.5, 0.5}}));
+    EXPECT_EQ(diff.asks, (std::vector<PriceLevel>{{101.5, 1.5}}));
+
+    EXPECT_TRUE(book_.apply(diff));
+    EXPECT_EQ(book_.bids(), (std::vector<PriceLevel>{{99.5, 0.5}, {99.0, 2.0}}));
+    EXPECT_EQ(book_.asks(), (std::vector<PriceLevel>{{101.0, 3.0}, {101.5, 1.5}, {102.0, 4.0}}));
+}
@@ -0,0 +1,29 @@
+#include <gtest/gtest.h>
+#include "matching_engine.hpp"
+
+TEST(MatchingEngineTest, RejectsDuplicateClientOrderIdOfRestingOrder) {
+    MatchingEngine engine;
+    auto first = engine.submit(1, "BTCUSDT", "a", Side::Buy, OrderType::Limit, 100.0, 1.0);
+    ASSERT_EQ(first.front().status, OrderStatus::Acknowledged);
+
+    auto duplicate = engine.submit(1, "BTCUSDT", "a", Side::Buy, OrderType::Limit, 99.0, 2.0);
+    ASSERT_EQ(duplicate.size(), 1u);
+    EXPECT_EQ(duplicate.front().status, OrderStatus::Rejected);
+    EXPECT_EQ(engine.best_bid_ask("BTCUSDT").first, 100.0);
+
+    // The original is still the one resting, and still cancelable
+    auto canceled = engine.cancel(1, "a");
+    ASSERT_EQ(canceled.size(), 1u);
+    EXPECT_EQ(canceled.front().price, 100.0);
+    EXPECT_EQ(engine.best_bid_ask("BTCUSDT").first, 0.0);
+}
+
+TEST(MatchingEngineTest, ClientOrderIdsAreScopedToOwnerAndFreedWhenDone) {
+    MatchingEngine engine;
+    engine.submit(1, "BTCUSDT", "a", Side::Sell, OrderType::Limit, 100.0, 1.0);
+    // Another owner may use the same ID, and filling the resting order frees it
+    auto taker = engine.submit(2, "BTCUSDT", "a", Side::Buy, OrderType::Limit, 100.0, 1.0);
+    EXPECT_EQ(taker.back().status, OrderStatus::Filled);
+    auto reused = engine.submit(1, "BTCUSDT", "a", Side::Sell, OrderType::Limit, 101.0, 1.0);
+    EXPECT_EQ(reused.front().status, OrderStatus::Acknowledged);
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "merged_feed.hpp"
+
+class MergedFeedTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        registry_.add("Binance", "BTCUSDT");
+        registry_.add("Coinbase", "BTC-USD");
+    }
+
+    // Publishes as a parser does, with every view into a frame that is gone afterwards
+    void publish(const std::string& source, const std::string& symbol, int64_t exchange_time, double price) {
+        auto frame = std::make_unique<std::string>(source + symbol + "sell");
+        std::string_view view(*frame);
+        TradeEvent event{};
+        event.data.source = view.substr(0, source.size());
+        event.data.symbol = view.substr(source.size(), symbol.size());
+        event.data.side = view.substr(source.size() + symbol.size());
+        event.data.price = price;
+        event.data.trace.exchange_time = exchange_time;
+        bus_->publish(event);
+        frame->assign(frame->size(), 'x');
+    }
+
+    std::shared_ptr<EventBus> bus_ = std::make_shared<EventBus>();
+    InstrumentRegistry registry_;
+};
+
+TEST_F(MergedFeedTest, EmitsVenuesInExchangeTimeOrder) {
+    MergedFeed<TradeEvent> feed(bus_, registry_, {"Binance", "Coinbase"}, 16, 1'000);
+    // Each venue in its own order, the venues interleaved out of order
+    publish("Binance", "BTCUSDT", 100, 1.0);
+    publish("Binance", "BTCUSDT", 300, 3.0);
+    publish("Coinbase", "BTC-USD", 200, 2.0);
+    publish("Coinbase", "BTC-USD", 400, 4.0);
+
+    std::vector<double> prices;
+    auto emit = [&](int64_t, const TradeEvent& e) { prices.push_back(e.data.price); };
+    // Both lanes have something pending, so everything older than the newest head is provably next
+    feed.poll(0, emit);
+    EXPECT_EQ(prices, (std::vector<double>{1.0, 2.0, 3.0}));
+
+    feed.flush(emit);
+    EXPECT_EQ(prices, (std::vector<double>{1.0, 2.0, 3.0, 4.0}));
+    EXPECT_EQ(feed.merger().late(), 0u);
+}
+
+TEST_F(MergedFeedTest, EventsOutliveTheirFrames) {
+    MergedFeed<TradeEvent> feed(bus_, registry_, {"Binance", "Coinbase"}, 16, 1'000);
+    publish("Coinbase", "BTC-USD", 200, 2.0);
+
+    std::vector<TradeEvent> out;
+    feed.flush([&](int64_t, const TradeEvent& e) { out.push_back(e); });
+    ASSERT_EQ(out.size(), 1u);
+    EXPECT_EQ(out[0].data.source, "Coinbase");
+    EXPECT_EQ(out[0].data.symbol, "BTC-USD");
+    EXPECT_EQ(out[0].data.side, "sell");
+}
+
+TEST_F(MergedFeedTest, SilentVenueHoldsOthersOnlyUntilTheWatermark) {
+    MergedFeed<TradeEvent> feed(bus_, registry_, {"Binance", "Coinbase"}, 16, 1'000);
+    publish("Binance", "BTCUSDT", 100, 1.0);
+
+    size_t emitted = 0;
+    auto emit = [&](int64_t, const TradeEvent&) { ++emitted; };
+    EXPECT_EQ(feed.poll(1'000, emit), 0u); // Coinbase might still deliver something older
+    EXPECT_EQ(feed.poll(1'101, emit), 1u);
+    EXPECT_EQ(emitted, 1u);
+}
+
+TEST_F(MergedFeedTest, FullRingForcesItsOldestOut) {
+    MergedFeed<TradeEvent> feed(bus_, registry_, {"Binance", "Coinbase"}, 4, 1'000'000);
+    for (int64_t t = 1; t <= 10; ++t) publish("Binance", "BTCUSDT", t, static_cast<double>(t));
+
+    std::vector<double> prices;
+    auto emit = [&](int64_t, const TradeEvent& e) { prices.push_back(e.data.price); };
+    feed.poll(0, emit);
+    EXPECT_EQ(feed.lane(0).dropped(), 6u); // Fan-in queue holds 4
+    EXPECT_EQ(feed.merger().pending() + prices.size(), 4u);
+
+    publish("Binance", "BTCUSDT", 11, 11.0);
+    publish("Binance", "BTCUSDT", 12, 12.0);
+    publish("Binance", "BTCUSDT", 13, 13.0);
+    feed.poll(0, emit);
+    feed.flush(emit);
+    ASSERT_EQ(prices.size(), 7u);
+    for (size_t i = 1; i < prices.size(); ++i) EXPECT_LT(prices[i - 1], prices[i]);
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include "order_book_keeper.hpp"
+
+class OrderBookKeeperTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        bus_->subscribe<OrderUpdateEvent>([this](const OrderUpdateEvent& e) { updates_.push_back(e.data); });
+    }
+
+    static OrderRequest request(uint64_t client_order_id, double quantity) {
+        OrderRequest o{};
+        o.client_order_id = client_order_id;
+        o.instrument_id = 0;
+        o.side = Side::Buy;
+        o.type = OrderType::Limit;
+        o.price = 100.0;
+        o.quantity = quantity;
+        return o;
+    }
+
+    std::shared_ptr<EventBus> bus_ = std::make_shared<EventBus>();
+    OrderBookKeeper keeper_{bus_, 16, 4};
+    std::vector<OrderUpdateData> updates_;
+};
+
+TEST_F(OrderBookKeeperTest, AckMovesNewToAcknowledged) {
+    ASSERT_TRUE(keeper_.on_new_order(request(1, 2.0), 10));
+    EXPECT_TRUE(keeper_.on_ack(1, 501, 11));
+    EXPECT_EQ(keeper_.find(1)->status, OrderStatus::Acknowledged);
+    EXPECT_EQ(keeper_.find(1)->exchange_order_id, 501u);
+    EXPECT_FALSE(keeper_.on_ack(1, 501, 12)); // Duplicate
+}
+
+TEST_F(OrderBookKeeperTest, AckAfterPartialFillKeepsFillStatus) {
+    ASSERT_TRUE(keeper_.on_new_order(request(1, 2.0), 10));
+    ASSERT_TRUE(keeper_.on_fill(1, 0.5, 100.0, 11));
+    EXPECT_TRUE(keeper_.on_ack(1, 501, 12));
+
+    const OrderRecord* order = keeper_.find(1);
+    ASSERT_NE(order, nullptr);
+    EXPECT_EQ(order->status, OrderStatus::PartiallyFilled);
+    EXPECT_EQ(order->exchange_order_id, 501u);
+    EXPECT_EQ(updates_.back().exchange_order_id, 501u);
+    EXPECT_FALSE(keeper_.on_ack(1, 501, 13));
+}
+
+TEST_F(OrderBookKeeperTest, OrderFilledBeforeAckIsReleasedByTheAck) {
+    ASSERT_TRUE(keeper_.on_new_order(request(1, 2.0), 10));
+    ASSERT_TRUE(keeper_.on_fill(1, 2.0, 100.0, 11));
+    ASSERT_NE(keeper_.find(1), nullptr);
+    EXPECT_EQ(keeper_.find(1)->status, OrderStatus::Filled);
+
+    EXPECT_TRUE(keeper_.on_ack(1, 501, 12));
+    EXPECT_EQ(updates_.back().status, OrderStatus::Filled);
+    EXPECT_EQ(updates_.back().exchange_order_id, 501u);
+    EXPECT_EQ(keeper_.find(1), nullptr);
+    EXPECT_EQ(keeper_.open_orders(), 0u);
+}
+
+TEST_F(OrderBookKeeperTest, AckedOrderIsReleasedWhenFilled) {
+    ASSERT_TRUE(keeper_.on_new_order(request(1, 2.0), 10));
+    ASSERT_TRUE(keeper_.on_ack(1, 501, 11));
+    ASSERT_TRUE(keeper_.on_fill(1, 2.0, 100.0, 12));
+    EXPECT_EQ(keeper_.find(1), nullptr);
+    EXPECT_DOUBLE_EQ(keeper_.position(0).position, 2.0);
+}
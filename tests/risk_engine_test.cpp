@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include "risk_checked_router.hpp"
+#include "risk_engine.hpp"
+
+// One instrument quoted 100 / 101, limits loose enough that each case trips only its own
+class RiskEngineTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        limits_.max_position = 10.0;
+        limits_.max_notional = 1'000'000.0;
+        limits_.max_price_deviation = 0.05;
+        limits_.max_orders_per_window = 1000;
+        limits_.order_window_ns = 1'000'000'000;
+        engine_->set_limits(0, limits_);
+        engine_->update_reference_price(0, 100.0, 101.0);
+    }
+
+    static OrderRequest order(Side side, double price, double quantity, uint32_t instrument = 0) {
+        OrderRequest o{};
+        o.instrument_id = instrument;
+        o.side = side;
+        o.type = OrderType::Limit;
+        o.price = price;
+        o.quantity = quantity;
+        return o;
+    }
+
+    std::unique_ptr<RiskEngine> engine_ = std::make_unique<RiskEngine>();
+    RiskLimits limits_;
+};
+
+TEST_F(RiskEngineTest, AcceptsOrderWithinLimits) {
+    EXPECT_EQ(engine_->check(order(Side::Buy, 101.0, 1.0), 0), RiskCheckResult::Accepted);
+}
+
+TEST_F(RiskEngineTest, KillSwitchRejectsEverythingUntilReset) {
+    engine_->activate_kill_switch();
+    EXPECT_TRUE(engine_->kill_switch_active());
+    EXPECT_EQ(engine_->check(order(Side::Buy, 101.0, 1.0), 0), RiskCheckResult::KillSwitchActive);
+    EXPECT_EQ(engine_->check(order(Side::Sell, 100.0, 1.0), 0), RiskCheckResult::KillSwitchActive);
+
+    engine_->reset_kill_switch();
+    EXPECT_EQ(engine_->check(order(Side::Buy, 101.0, 1.0), 0), RiskCheckResult::Accepted);
+}
+
+TEST_F(RiskEngineTest, RejectsInstrumentWithoutLimits) {
+    EXPECT_EQ(engine_->check(order(Side::Buy, 101.0, 1.0, 1), 0), RiskCheckResult::UnknownInstrument);
+    EXPECT_EQ(engine_->check(order(Side::Buy, 101.0, 1.0, RiskEngine::MAX_INSTRUMENTS), 0),
+              RiskCheckResult::UnknownInstrument);
+}
+
+TEST_F(RiskEngineTest, IgnoresOutOfRangeInstrumentIds) {
+    const uint32_t id = RiskEngine::MAX_INSTRUMENTS;
+    engine_->set_limits(id, limits_);
+    engine_->set_position(id, 5.0);
+    engine_->on_fill(id, Side::Buy, 1.0);
+    engine_->update_reference_price(id, 100.0, 101.0);
+    EXPECT_EQ(engine_->position(id), 0.0);
+    EXPECT_EQ(engine_->check(order(Side::Buy, 101.0, 1.0, id), 0), RiskCheckResult::UnknownInstrument);
+}
+
+TEST_F(RiskEngineTest, RejectsWithoutReferencePrice) {
+    engine_->update_reference_price(0, 0.0, 0.0);
+    EXPECT_EQ(engine_->check(order(Side::Buy, 101.0, 1.0), 0), RiskCheckResult::NoReferencePrice);
+}
+
+TEST_F(RiskEngineTest, FatFingerComparesAgainstTheSideBeingCrossed) {
+    // Buys against the 101 ask, sells against the 100 bid, 5% either way
+    EXPECT_EQ(engine_->check(order(Side::Buy, 106.0, 1.0), 0), RiskCheckResult::Accepted);
+    EXPECT_EQ(engine_->check(order(Side::Buy, 106.1, 1.0), 0), RiskCheckResult::FatFingerPrice);
+    EXPECT_EQ(engine_->check(order(Side::Sell, 95.5, 1.0), 0), RiskCheckResult::Accepted);
+    EXPECT_EQ(engine_->check(order(Side::Sell, 94.9, 1.0), 0), RiskCheckResult::FatFingerPrice);
+}
+
+TEST_F(RiskEngineTest, MaxPositionCountsFills) {
+    EXPECT_EQ(engine_->check(order(Side::Buy, 101.0, 10.0), 0), RiskCheckResult::Accepted);
+    EXPECT_EQ(engine_->check(order(Side::Buy, 101.0, 10.5), 0), RiskCheckResult::MaxPositionExceeded);
+
+    engine_->on_fill(0, Side::Buy, 6.0);
+    EXPECT_DOUBLE_EQ(engine_->position(0), 6.0);
+    EXPECT_EQ(engine_->check(order(Side::Buy, 101.0, 5.0), 0), RiskCheckResult::MaxPositionExceeded);
+    // Reducing the position is allowed
+    EXPECT_EQ(engine_->check(order(Side::Sell, 100.0, 5.0), 0), RiskCheckResult::Accepted);
+    EXPECT_EQ(engine_->check(order(Side::Sell, 100.0, 16.5), 0), RiskCheckResult::MaxPositionExceeded);
+}
+
+TEST_F(RiskEngineTest, MaxNotionalUsesOrderPrice) {
+    limits_.max_notional = 500.0;
+    engine_->set_limits(0, limits_);
+    EXPECT_EQ(engine_->check(order(Side::Buy, 100.0, 5.0), 0), RiskCheckResult::Accepted);
+    EXPECT_EQ(engine_->check(order(Side::Buy, 101.0, 5.0), 0), RiskCheckResult::MaxNotionalExceeded);
+
+    engine_->set_position(0, -4.0);
+    EXPECT_EQ(engine_->check(order(Side::Sell, 100.0, 1.0), 0), RiskCheckResult::Accepted);
+    EXPECT_EQ(engine_->check(order(Side::Sell, 100.0, 1.1), 0), RiskCheckResult::MaxNotionalExceeded);
+}
+
+TEST_F(RiskEngineTest, OrderRateResetsWithTheWindow) {
+    limits_.max_orders_per_window = 3;
+    limits_.order_window_ns = 1000;
+    engine_->set_limits(0, limits_);
+    // The first check opens a window at its own timestamp
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(engine_->check(order(Side::Buy, 101.0, 1.0), 5000 + i), RiskCheckResult::Accepted);
+    }
+    EXPECT_EQ(engine_->check(order(Side::Buy, 101.0, 1.0), 5500), RiskCheckResult::OrderRateExceeded);
+    EXPECT_EQ(engine_->check(order(Side::Buy, 101.0, 1.0), 5999), RiskCheckResult::OrderRateExceeded);
+    EXPECT_EQ(engine_->check(order(Side::Buy, 101.0, 1.0), 6000), RiskCheckResult::Accepted);
+}
+
+TEST_F(RiskEngineTest, RejectedOrdersDoNotUseTheRateBudget) {
+    limits_.max_orders_per_window = 1;
+    engine_->set_limits(0, limits_);
+    EXPECT_EQ(engine_->check(order(Side::Buy, 200.0, 1.0), 5000), RiskCheckResult::FatFingerPrice);
+    EXPECT_EQ(engine_->check(order(Side::Buy, 101.0, 1.0), 5000), RiskCheckResult::Accepted);
+    EXPECT_EQ(engine_->check(order(Side::Buy, 101.0, 1.0), 5001), RiskCheckResult::OrderRateExceeded);
+}
+
+TEST_F(RiskEngineTest, RouterCountsRejectionsAndForwardsTheRest) {
+    // Counts what gets through instead of sending it
+    struct CountingRouter : IExcecutionRouter {
+        bool send_order(const OrderRequest&) override {
+            ++sent;
+            return true;
+        }
+        int sent = 0;
+    };
+    auto downstream = std::make_shared<CountingRouter>();
+    RiskCheckedRouter router(*engine_, downstream);
+
+    EXPECT_TRUE(router.send_order(order(Side::Buy, 101.0, 1.0)));
+    for (int i = 0; i < 3; ++i) EXPECT_FALSE(router.send_order(order(Side::Buy, 200.0, 1.0)));
+    EXPECT_EQ(downstream->sent, 1);
+    EXPECT_EQ(router.rejected_orders(), 3u);
+}
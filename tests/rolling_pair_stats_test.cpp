@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <deque>
+#include <random>
+#include <utility>
+#include "rolling_pair_stats.hpp"
+
+class RollingPairStatsTest : public ::testing::Test {
+protected:
+    // Two-pass statistics over an explicit window, the reference for the O(1) updates
+    struct BruteForce {
+        double mean_y = 0.0, mean_x = 0.0, var_y = 0.0, var_x = 0.0, cov = 0.0;
+
+        explicit BruteForce(const std::deque<std::pair<double, double>>& window) {
+            const double n = static_cast<double>(window.size());
+            for (const auto& [y, x] : window) {
+                mean_y += y;
+                mean_x += x;
+            }
+            mean_y /= n;
+            mean_x /= n;
+            for (const auto& [y, x] : window) {
+                var_y += (y - mean_y) * (y - mean_y);
+                var_x += (x - mean_x) * (x - mean_x);
+                cov += (y - mean_y) * (x - mean_x);
+            }
+            var_y /= n;
+            var_x /= n;
+            cov /= n;
+        }
+    };
+
+    static void expect_matches(const RollingPairStats& stats, const std::deque<std::pair<double, double>>& window,
+                               double tolerance) {
+        BruteForce ref(window);
+        EXPECT_NEAR(stats.mean_y(), ref.mean_y, tolerance);
+        EXPECT_NEAR(stats.mean_x(), ref.mean_x, tolerance);
+        EXPECT_NEAR(stats.variance_y(), ref.var_y, tolerance);
+        EXPECT_NEAR(stats.variance_x(), ref.var_x, tolerance);
+        EXPECT_NEAR(stats.covariance(), ref.cov, tolerance);
+        EXPECT_NEAR(stats.hedge_ratio(), ref.var_x > 0.0 ? ref.cov / ref.var_x : 0.0, tolerance);
+    }
+};
+
+TEST_F(RollingPairStatsTest, WindowBelowTwoThrows) {
+    EXPECT_THROW(RollingPairStats(0), std::invalid_argument);
+    EXPECT_THROW(RollingPairStats(1), std::invalid_argument);
+    EXPECT_NO_THROW(RollingPairStats(2));
+}
+
+TEST_F(RollingPairStatsTest, ReadyOnlyOnceTheWindowIsFull) {
+    RollingPairStats stats(4);
+    std::deque<std::pair<double, double>> window;
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_FALSE(stats.ready());
+        const double y = 10.0 + i * i;
+        const double x = 5.0 + 2.0 * i;
+        stats.push(y, x);
+        window.emplace_back(y, x);
+        EXPECT_EQ(stats.count(), static_cast<size_t>(i + 1));
+        expect_matches(stats, window, 1e-12);
+    }
+    EXPECT_TRUE(stats.ready());
+    EXPECT_EQ(stats.window(), 4u);
+}
+
+TEST_F(RollingPairStatsTest, SlideMatchesBruteForceWindow) {
+    const size_t n = 7;
+    RollingPairStats stats(n);
+    std::deque<std::pair<double, double>> window;
+    std::mt19937_64 rng(11);
+    std::normal_distribution<double> noise(0.0, 0.01);
+    double x = std::log(50000.0);
+    for (int i = 0; i < 500; ++i) {
+        x += noise(rng);
+        const double y = 0.8 * x + 1.3 + noise(rng) * 0.2;
+        stats.push(y, x);
+        window.emplace_back(y, x);
+        if (window.size() > n) window.pop_front();
+        expect_matches(stats, window, 1e-9);
+        if (HasFailure()) FAIL() << "diverged at sample " << i;
+    }
+}
+
+TEST_F(RollingPairStatsTest, WrapRecomputesExactSums) {
+    // Large offsets make the incremental updates lose digits; each lap resets them exactly
+    const size_t n = 16;
+    RollingPairStats stats(n);
+    std::deque<std::pair<double, double>> window;
+    std::mt19937_64 rng(3);
+    std::uniform_real_distribution<double> step(-1.0, 1.0);
+    for (size_t i = 0; i < 100'000; ++i) {
+        const double x = 1e8 + step(rng);
+        const double y = 2e8 + 3.0 * (x - 1e8) + step(rng) * 0.1;
+        stats.push(y, x);
+        window.emplace_back(y, x);
+        if (window.size() > n) window.pop_front();
+    }
+    // 100000 is a multiple of 16, so the last push wrapped and recomputed
+    BruteForce ref(window);
+    EXPECT_DOUBLE_EQ(stats.mean_y(), ref.mean_y);
+    EXPECT_DOUBLE_EQ(stats.mean_x(), ref.mean_x);
+    EXPECT_NEAR(stats.variance_x(), ref.var_x, 1e-9 * ref.var_x);
+    EXPECT_NEAR(stats.covariance(), ref.cov, 1e-9 * std::abs(ref.cov));
+    EXPECT_NEAR(stats.hedge_ratio(), ref.cov / ref.var_x, 1e-9);
+}
+
+TEST_F(RollingPairStatsTest, SpreadAndZScoreFollowTheRegression) {
+    RollingPairStats stats(4);
+    // y = 2x + 1 exactly, except the last point sits 0.5 above the line
+    stats.push(1.0, 0.0);
+    stats.push(3.0, 1.0);
+    stats.push(5.0, 2.0);
+    stats.push(7.5, 3.0);
+    ASSERT_TRUE(stats.ready());
+
+    const double beta = stats.hedge_ratio();
+    EXPECT_NEAR(beta, 2.15, 1e-12);
+    // Residuals around the fitted line sum to zero
+    double sum = 0.0;
+    for (auto [y, x] : {std::pair{1.0, 0.0}, {3.0, 1.0}, {5.0, 2.0}, {7.5, 3.0}}) sum += stats.spread(y, x);
+    EXPECT_NEAR(sum, 0.0, 1e-12);
+    EXPECT_GT(stats.z_score(7.5, 3.0), 0.0);
+
+    // x never moves: no hedge, spread is y's deviation
+    RollingPairStats flat(2);
+    flat.push(1.0, 5.0);
+    flat.push(3.0, 5.0);
+    EXPECT_EQ(flat.hedge_ratio(), 0.0);
+    EXPECT_DOUBLE_EQ(flat.spread_variance(), 1.0);
+    EXPECT_DOUBLE_EQ(flat.z_score(3.0, 5.0), 1.0);
+}
+
+TEST_F(RollingPairStatsTest, ClearStartsAFreshWindow) {
+    RollingPairStats stats(3);
+    for (int i = 0; i < 5; ++i) stats.push(100.0 + i, 50.0 - i);
+    ASSERT_TRUE(stats.ready());
+
+    stats.clear();
+    EXPECT_FALSE(stats.ready());
+    EXPECT_EQ(stats.count(), 0u);
+
+    std::deque<std::pair<double, double>> window{{1.0, 2.0}, {2.0, 3.0}, {4.0, 3.5}};
+    for (const auto& [y, x] : window) stats.push(y, x);
+    EXPECT_TRUE(stats.ready());
+    expect_matches(stats, window, 1e-12); // Nothing from before the clear
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <set>
+#include <string>
+#include <vector>
+#include "triangle_scanner.hpp"
+
+class TriangleScannerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        btc_usdt_ = registry_.add("Binance", "BTCUSDT");
+        eth_usdt_ = registry_.add("Binance", "ETHUSDT");
+        eth_btc_ = registry_.add("Binance", "ETHBTC");
+        registry_.add("Coinbase", "BTC-USD"); // Another venue, not part of the graph
+        registry_.add("Binance", "WHATEVER");  // No known quote asset
+    }
+
+    static LevelBook::TopOfBook quote(double bid, double bid_quantity, double ask, double ask_quantity) {
+        return LevelBook::TopOfBook{bid, bid_quantity, ask, ask_quantity};
+    }
+
+    // Every leg pays with what the previous one received, and the cycle returns to its start
+    static void expect_closed(const TriangleScanner& scanner, uint32_t cycle_id) {
+        const TriangleScanner::Cycle& cycle = scanner.cycle(cycle_id);
+        uint32_t holding = cycle.start;
+        for (const auto& leg : cycle.legs) {
+            EXPECT_EQ(scanner.from(leg), holding);
+            holding = scanner.to(leg);
+        }
+        EXPECT_EQ(holding, cycle.start);
+    }
+
+    InstrumentRegistry registry_;
+    uint32_t btc_usdt_ = 0;
+    uint32_t eth_usdt_ = 0;
+    uint32_t eth_btc_ = 0;
+};
+
+TEST_F(TriangleScannerTest, SplitsSymbolsBySeparatorOrQuoteSuffix) {
+    TriangleScanner scanner(registry_, "Binance", 0.0, 0.0);
+    std::string_view base;
+    std::string_view quote;
+    ASSERT_TRUE(scanner.split_symbol("BTC-USD", base, quote));
+    EXPECT_EQ(base, "BTC");
+    EXPECT_EQ(quote, "USD");
+    ASSERT_TRUE(scanner.split_symbol("ETH/EUR", base, quote));
+    EXPECT_EQ(base, "ETH");
+    EXPECT_EQ(quote, "EUR");
+    // Longest suffix first: USDT, not USD
+    ASSERT_TRUE(scanner.split_symbol("BTCUSDT", base, quote));
+    EXPECT_EQ(base, "BTC");
+    EXPECT_EQ(quote, "USDT");
+    ASSERT_TRUE(scanner.split_symbol("ETHBTC", base, quote));
+    EXPECT_EQ(base, "ETH");
+    EXPECT_EQ(quote, "BTC");
+
+    EXPECT_FALSE(scanner.split_symbol("WHATEVER", base, quote));
+    EXPECT_FALSE(scanner.split_symbol("USDT", base, quote)); // Nothing left for the base
+    EXPECT_FALSE(scanner.split_symbol("-USD", base, quote));
+}
+
+TEST_F(TriangleScannerTest, OneTriangleGivesBothDirections) {
+    TriangleScanner scanner(registry_, "Binance", 0.0, 0.0);
+    ASSERT_EQ(scanner.cycles(), 2u);
+    for (uint32_t c = 0; c < 2; ++c) expect_closed(scanner, c);
+    // Same three pairs, opposite order
+    EXPECT_EQ(scanner.cycle(0).legs[0].instrument, scanner.cycle(1).legs[2].instrument);
+    EXPECT_NE(scanner.cycle(0).legs[0].sell, scanner.cycle(1).legs[2].sell);
+}
+
+TEST_F(TriangleScannerTest, EnumeratesEveryTriangleOnce) {
+    // Four currencies, all six pairs: four triangles, eight cycles
+    registry_.add("Binance", "BNBUSDT");
+    registry_.add("Binance", "BNBBTC");
+    registry_.add("Binance", "BNBETH");
+    TriangleScanner scanner(registry_, "Binance", 0.0, 0.0);
+    ASSERT_EQ(scanner.cycles(), 8u);
+
+    std::set<std::array<uint32_t, 3>> triangles;
+    for (uint32_t c = 0; c < scanner.cycles(); ++c) {
+        expect_closed(scanner, c);
+        std::array<uint32_t, 3> pairs{};
+        for (size_t i = 0; i < 3; ++i) pairs[i] = scanner.cycle(c).legs[i].instrument;
+        std::sort(pairs.begin(), pairs.end());
+        triangles.insert(pairs);
+    }
+    EXPECT_EQ(triangles.size(), 4u);
+}
+
+TEST_F(TriangleScannerTest, EmitsOnlyProfitableCycles) {
+    const double fee = 0.001;
+    TriangleScanner scanner(registry_, "Binance", fee, 0.0005);
+    auto none = [](uint32_t, double) { ADD_FAILURE() << "no cycle should clear yet"; };
+    EXPECT_EQ(scanner.update(btc_usdt_, quote(50000.0, 1.0, 50001.0, 1.0), none), 0u);
+    EXPECT_EQ(scanner.update(eth_usdt_, quote(3000.0, 5.0, 3001.0, 5.0), none), 0u);
+    // Fair cross rate: no cycle pays the fees
+    EXPECT_EQ(scanner.update(eth_btc_, quote(0.05999, 10.0, 0.06001, 10.0), none), 0u);
+
+    // ETH cheap in BTC: USDT -> BTC -> ETH -> USDT
+    std::vector<std::pair<uint32_t, double>> found;
+    EXPECT_EQ(scanner.update(eth_btc_, quote(0.0589, 10.0, 0.059, 10.0),
+                             [&](uint32_t c, double r) { found.emplace_back(c, r); }), 1u);
+    ASSERT_EQ(found.size(), 1u);
+    const double expected = std::log(3000.0 / (50001.0 * 0.059)) + 3.0 * std::log(1.0 - fee);
+    EXPECT_NEAR(found[0].second, expected, 1e-12);
+    expect_closed(scanner, found[0].first);
+}
+
+TEST_F(TriangleScannerTest, EmptySideBreaksTheCycle) {
+    TriangleScanner scanner(registry_, "Binance", 0.0, 0.0);
+    size_t found = 0;
+    auto count = [&](uint32_t, double) { ++found; };
+    scanner.update(btc_usdt_, quote(50000.0, 1.0, 50001.0, 1.0), count);
+    scanner.update(eth_usdt_, quote(3000.0, 5.0, 3001.0, 5.0), count);
+    scanner.update(eth_btc_, quote(0.0589, 10.0, 0.059, 10.0), count);
+    ASSERT_EQ(found, 1u);
+
+    // A cleared book (as after a feed drop) can't be traded through
+    EXPECT_EQ(scanner.update(eth_btc_, LevelBook::TopOfBook{}, count), 0u);
+    EXPECT_EQ(scanner.update(btc_usdt_, quote(50000.0, 1.0, 50001.0, 1.0), count), 0u);
+    EXPECT_EQ(scanner.update(9999, quote(1.0, 1.0, 1.0, 1.0), count), 0u);
+}
+
+TEST_F(TriangleScannerTest, SizeIsCappedByTheThinnestLeg) {
+    TriangleScanner scanner(registry_, "Binance", 0.0, 0.0);
+    uint32_t cycle_id = UINT32_MAX;
+    auto keep = [&](uint32_t c, double) { cycle_id = c; };
+    scanner.update(btc_usdt_, quote(50000.0, 1.0, 50001.0, 1.0), keep);
+    scanner.update(eth_usdt_, quote(3000.0, 5.0, 3001.0, 5.0), keep);
+    scanner.update(eth_btc_, quote(0.0589, 10.0, 0.059, 10.0), keep);
+    ASSERT_NE(cycle_id, UINT32_MAX);
+
+    // USDT in: 1 BTC costs 50001, 10 ETH cost 0.59 BTC, 5 ETH sell; the ETH sale binds
+    EXPECT_NEAR(scanner.size(cycle_id), 5.0 * 0.059 * 50001.0, 1e-6);
+
+    scanner.update(eth_usdt_, quote(3000.0, 50.0, 3001.0, 50.0), keep);
+    EXPECT_NEAR(scanner.size(cycle_id), 10.0 * 0.059 * 50001.0, 1e-6); // Now the ETHBTC ask
+}
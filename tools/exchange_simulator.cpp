@@ -0,0 +1,62 @@
+// Local order-entry simulator speaking a Binance-like WebSocket order protocol over loopback,
+// see include/exchange_simulator.hpp for the protocol.
+//
+// Usage:
+//   exchange_simulator [--port 9443] [--cert cert.pem --key key.pem] [--ack-latency-us N]
+//                      [--fill-latency-us N] [--reject-rate 0..1] [--disconnect-after N] [--seed N]
+//
+// Without --cert/--key the server speaks plain ws://, with them wss:// so the existing
+// BinanceExchange/CoinbaseExchange TLS connection code can point at 127.0.0.1 directly.
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "exchange_simulator.hpp"
+
+static SimulatorConfig parse_args(int argc, char** argv) {
+    SimulatorConfig cfg;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        std::string value = argv[i + 1];
+        if (flag == "--port") cfg.port = static_cast<unsigned short>(std::stoi(value));
+        else if (flag == "--cert") cfg.cert_file = value;
+        else if (flag == "--key") cfg.key_file = value;
+        else if (flag == "--ack-latency-us") cfg.ack_latency = std::chrono::microseconds(std::stoll(value));
+        else if (flag == "--fill-latency-us") cfg.fill_latency = std::chrono::microseconds(std::stoll(value));
+        else if (flag == "--reject-rate") cfg.reject_rate = std::stod(value);
+        else if (flag == "--disconnect-after") cfg.disconnect_after = std::stoull(value);
+        else if (flag == "--seed") cfg.seed = std::stoull(value);
+        else throw std::invalid_argument("Unknown option: " + flag);
+    }
+    return cfg;
+}
+
+int main(int argc, char** argv) {
+    try {
+        Simulator sim(parse_args(argc, argv));
+        net::io_context ioc{1};
+
+        std::unique_ptr<ssl::context> tls;
+        if (!sim.config.cert_file.empty()) {
+            tls = std::make_unique<ssl::context>(ssl::context::tlsv12_server);
+            tls->use_certificate_chain_file(sim.config.cert_file);
+            tls->use_private_key_file(sim.config.key_file, ssl::context::pem);
+        }
+
+        Listener listener(ioc, sim, tls.get());
+        listener.accept();
+
+        std::cout << "[Simulator] Listening on 127.0.0.1:" << listener.port()
+                  << (tls ? " (wss)" : " (ws)") << std::endl;
+
+        net::signal_set signals(ioc, SIGINT, SIGTERM);
+        signals.async_wait([&ioc](beast::error_code, int) { ioc.stop(); });
+
+        ioc.run();
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Simulator exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
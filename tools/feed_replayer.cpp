@@ -0,0 +1,439 @@
+// Local TLS WebSocket market data server for load testing the exchange pipelines over loopback.
+//
+// Every client that connects gets its own stream of frames, either replayed from a recorded
+// file (one frame per line, e.g. benchmarks/data/binance_depth.jsonl) or synthesized in the
+// venue's wire format with a random-walk price, increasing sequence numbers and the current
+// time as the exchange timestamp (so the pipeline's "network" stage measures loopback latency).
+// The request target and any subscribe messages from the client are ignored.
+//
+// Usage:
+//   feed_replayer [--port 9443] [--cert cert.pem --key key.pem]
+//                 [--replay frames.jsonl | --venue binance|coinbase|kraken --channel depth|trade|ticker]
+//                 [--rate msgs_per_sec] [--duration sec] [--count N] [--seed N]
+//                 [--drop-after N | --stall-after N] [--mirror 1] [--deflate 1]
+//
+// --rate 0 (the default) sends as fast as the socket allows. Synthetic sessions are seeded per
+// connection unless --mirror 1, which gives every session the same sequence, as a venue's
+// redundant A/B connections would see (see FeedArbiter). --deflate 1 accepts permessage-deflate
+// when the client offers it, which the exchanges do by default. Without --cert/--key an
+// ephemeral self-signed certificate is generated; the pipelines do not verify certificates.
+//
+// Point a pipeline at it with initialize("127.0.0.1", "9443", ...), or use pipeline_load_test.
+//
+// Failure injection for the exchanges' reconnect supervision, applied to every session:
+//   --drop-after N   reset the TCP connection without a close frame after N messages
+//   --stall-after N  stop sending (and answering pings) after N messages but keep the socket
+//                    open, until --duration or Ctrl-C; the client should detect a stale feed
+
+#include <boost/asio.hpp>
+#include <boost/asio/ssl.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/beast/ssl.hpp>
+#include <boost/beast/websocket.hpp>
+#include <boost/beast/websocket/ssl.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "self_signed_certificate.hpp"
+
+namespace beast = boost::beast;
+namespace http = beast::http;
+namespace websocket = beast::websocket;
+namespace net = boost::asio;
+namespace ssl = net::ssl;
+using tcp = net::ip::tcp;
+
+struct ReplayerConfig {
+    unsigned short port = 9443;
+    std::string cert_file;
+    std::string key_file;
+    std::string replay_file;
+    std::string venue = "binance";
+    std::string channel = "depth";
+    uint64_t rate = 0;          // Messages per second per connection, 0 = unthrottled
+    uint64_t duration_sec = 0;  // 0 = until the client disconnects or Ctrl-C
+    uint64_t count = 0;         // Messages per connection, 0 = unlimited
+    uint64_t seed = 42;
+    uint64_t drop_after = 0;    // 0 = never
+    uint64_t stall_after = 0;   // 0 = never
+    bool mirror = false;        // Same synthetic sequence on every session
+    bool deflate = false;       // Accept permessage-deflate
+};
+
+static std::atomic<bool> g_running{true};
+
+static int64_t epoch_nanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @class FrameSource
+ * @brief Produces the next frame to send; one instance per connection.
+ */
+class FrameSource {
+public:
+    virtual ~FrameSource() = default;
+    virtual std::string_view next() = 0;
+};
+
+class ReplaySource : public FrameSource {
+public:
+    explicit ReplaySource(const std::vector<std::string>& frames) : frames_(frames) {}
+
+    std::string_view next() override {
+        const std::string& frame = frames_[index_];
+        if (++index_ == frames_.size()) index_ = 0;
+        return frame;
+    }
+
+private:
+    const std::vector<std::string>& frames_;
+    size_t index_ = 0;
+};
+
+/**
+ * @class SyntheticSource
+ * @brief Formats frames in Binance combined-stream, Coinbase exchange-feed or Kraken v2 layout.
+ *
+ * Formatting is a single snprintf into a reused buffer, and ISO-8601 timestamps only call
+ * gmtime once per second, so a source comfortably outruns a single WebSocket connection.
+ */
+class SyntheticSource : public FrameSource {
+public:
+    SyntheticSource(std::string venue, std::string channel, uint64_t seed)
+        : venue_(std::move(venue)), channel_(std::move(channel)), rng_(seed | 1) {
+        buffer_.resize(2048);
+        if (!supported(venue_, channel_)) {
+            throw std::invalid_argument("No synthetic format for " + venue_ + "/" + channel_);
+        }
+    }
+
+    static bool supported(const std::string& venue, const std::string& channel) {
+        bool venue_ok = venue == "binance" || venue == "coinbase" || venue == "kraken";
+        bool channel_ok = channel == "depth" || channel == "trade" || channel == "ticker";
+        return venue_ok && channel_ok;
+    }
+
+    std::string_view next() override {
+        int64_t now_ns = epoch_nanos();
+        mid_ += (static_cast<double>(random() % 2001) - 1000.0) * 0.001;
+        if (mid_ < 1000.0) mid_ = 1000.0;
+        ++sequence_;
+
+        char* out = buffer_.data();
+        size_t cap = buffer_.size();
+        int n = 0;
+        if (venue_ == "binance") {
+            long long ms = static_cast<long long>(now_ns / 1'000'000);
+            if (channel_ == "depth") {
+                unsigned long long first = sequence_ * 4;
+                // Books only apply sequenced diffs on top of a snapshot, so seed and resync with a
+                // partial-depth frame every 64 updates
+                if (sequence_ % 64 == 1) {
+                    n = std::snprintf(out, cap,
+                        "{\"stream\":\"btcusdt@depth20@100ms\",\"data\":{\"lastUpdateId\":%llu,"
+                        "\"bids\":[[\"%.2f\",\"%.5f\"],[\"%.2f\",\"%.5f\"]],"
+                        "\"asks\":[[\"%.2f\",\"%.5f\"],[\"%.2f\",\"%.5f\"]]}}",
+                        first + 3, mid_ - 0.01, qty(), mid_ - 0.50, qty(), mid_ + 0.01, qty(), mid_ + 0.50, qty());
+                } else {
+                    n = std::snprintf(out, cap,
+                        "{\"stream\":\"btcusdt@depth@100ms\",\"data\":{\"e\":\"depthUpdate\",\"E\":%lld,\"s\":\"BTCUSDT\","
+                        "\"U\":%llu,\"u\":%llu,\"b\":[[\"%.2f\",\"%.5f\"],[\"%.2f\",\"%.5f\"]],"
+                        "\"a\":[[\"%.2f\",\"%.5f\"],[\"%.2f\",\"%.5f\"]]}}",
+                        ms, first, first + 3, mid_ - 0.01, qty(), mid_ - 0.50, qty(), mid_ + 0.01, qty(), mid_ + 0.50, qty());
+                }
+            } else if (channel_ == "trade") {
+                n = std::snprintf(out, cap,
+                    "{\"stream\":\"btcusdt@trade\",\"data\":{\"e\":\"trade\",\"E\":%lld,\"s\":\"BTCUSDT\",\"t\":%llu,"
+                    "\"p\":\"%.2f\",\"q\":\"%.5f\",\"T\":%lld,\"m\":%s,\"M\":true}}",
+                    ms, static_cast<unsigned long long>(sequence_), mid_, qty(), ms, (sequence_ & 1) ? "true" : "false");
+            } else {
+                n = std::snprintf(out, cap,
+                    "{\"stream\":\"btcusdt@ticker\",\"data\":{\"e\":\"24hrTicker\",\"E\":%lld,\"s\":\"BTCUSDT\","
+                    "\"p\":\"%.2f\",\"P\":\"%.3f\",\"c\":\"%.2f\",\"b\":\"%.2f\",\"B\":\"%.5f\",\"a\":\"%.2f\","
+                    "\"A\":\"%.5f\",\"o\":\"62100.00\",\"h\":\"63890.00\",\"l\":\"61770.12\",\"v\":\"21873.40102\"}}",
+                    ms, mid_ - 62100.0, (mid_ - 62100.0) / 621.0, mid_, mid_ - 0.01, qty(), mid_, qty());
+            }
+        } else if (venue_ == "coinbase") {
+            const char* time = iso8601(now_ns);
+            if (channel_ == "depth" && sequence_ % 64 == 1) {
+                // No sequence numbers to resync by, so the snapshot comes around as often as Binance's
+                n = std::snprintf(out, cap,
+                    "{\"type\":\"snapshot\",\"product_id\":\"BTC-USD\",\"bids\":[[\"%.2f\",\"%.8f\"],"
+                    "[\"%.2f\",\"%.8f\"]],\"asks\":[[\"%.2f\",\"%.8f\"],[\"%.2f\",\"%.8f\"]]}",
+                    mid_ - 0.01, qty(), mid_ - 0.50, qty(), mid_ + 0.01, qty(), mid_ + 0.50, qty());
+            } else if (channel_ == "depth") {
+                n = std::snprintf(out, cap,
+                    "{\"type\":\"l2update\",\"product_id\":\"BTC-USD\",\"changes\":[[\"buy\",\"%.2f\",\"%.8f\"],"
+                    "[\"sell\",\"%.2f\",\"%.8f\"]],\"time\":\"%s\"}",
+                    mid_ - 0.01, qty(), mid_ + 0.01, qty(), time);
+            } else if (channel_ == "trade") {
+                n = std::snprintf(out, cap,
+                    "{\"type\":\"match\",\"trade_id\":%llu,\"side\":\"%s\",\"size\":\"%.8f\",\"price\":\"%.2f\","
+                    "\"product_id\":\"BTC-USD\",\"sequence\":%llu,\"time\":\"%s\"}",
+                    static_cast<unsigned long long>(sequence_), (sequence_ & 1) ? "buy" : "sell", qty(), mid_,
+                    static_cast<unsigned long long>(sequence_), time);
+            } else {
+                n = std::snprintf(out, cap,
+                    "{\"type\":\"ticker\",\"sequence\":%llu,\"product_id\":\"BTC-USD\",\"price\":\"%.2f\","
+                    "\"open_24h\":\"62101.37\",\"volume_24h\":\"8421.90230876\",\"low_24h\":\"61760.00\","
+                    "\"high_24h\":\"63899.99\",\"best_bid\":\"%.2f\",\"best_bid_size\":\"%.8f\",\"best_ask\":\"%.2f\","
+                    "\"best_ask_size\":\"%.8f\",\"side\":\"buy\",\"time\":\"%s\",\"trade_id\":%llu,\"last_size\":\"%.8f\"}",
+                    static_cast<unsigned long long>(sequence_), mid_, mid_ - 0.01, qty(), mid_, qty(), time,
+                    static_cast<unsigned long long>(sequence_), qty());
+            }
+        } else {
+            const char* time = iso8601(now_ns);
+            if (channel_ == "depth") {
+                n = std::snprintf(out, cap,
+                    "{\"channel\":\"book\",\"type\":\"%s\",\"data\":[{\"symbol\":\"BTC/USD\","
+                    "\"bids\":[{\"price\":%.1f,\"qty\":%.8f}],\"asks\":[{\"price\":%.1f,\"qty\":%.8f}],"
+                    "\"checksum\":%u,\"timestamp\":\"%s\"}]}",
+                    sequence_ % 64 == 1 ? "snapshot" : "update", mid_ - 0.1, qty(), mid_ + 0.1, qty(),
+                    static_cast<unsigned>(random()), time);
+            } else if (channel_ == "trade") {
+                n = std::snprintf(out, cap,
+                    "{\"channel\":\"trade\",\"type\":\"update\",\"data\":[{\"symbol\":\"BTC/USD\",\"side\":\"%s\","
+                    "\"price\":%.1f,\"qty\":%.8f,\"ord_type\":\"market\",\"trade_id\":%llu,\"timestamp\":\"%s\"}]}",
+                    (sequence_ & 1) ? "buy" : "sell", mid_, qty(), static_cast<unsigned long long>(sequence_), time);
+            } else {
+                n = std::snprintf(out, cap,
+                    "{\"channel\":\"ticker\",\"type\":\"update\",\"data\":[{\"symbol\":\"BTC/USD\",\"bid\":%.1f,"
+                    "\"bid_qty\":%.8f,\"ask\":%.1f,\"ask_qty\":%.8f,\"last\":%.1f,\"volume\":1893.37164815,"
+                    "\"vwap\":62954.9,\"low\":61770.0,\"high\":63890.0,\"change\":%.1f,\"change_pct\":%.2f}]}",
+                    mid_ - 0.1, qty(), mid_, qty(), mid_, mid_ - 62100.0, (mid_ - 62100.0) / 621.0);
+            }
+        }
+        return std::string_view(out, n > 0 ? static_cast<size_t>(n) : 0);
+    }
+
+private:
+    // xorshift64, good enough for prices and quantities
+    uint64_t random() {
+        rng_ ^= rng_ << 13;
+        rng_ ^= rng_ >> 7;
+        rng_ ^= rng_ << 17;
+        return rng_;
+    }
+
+    double qty() { return static_cast<double>(random() % 100000) * 0.00001; }
+
+    // "2024-09-25T08:09:37.123456Z"; the date part is cached per second
+    const char* iso8601(int64_t ns) {
+        int64_t sec = ns / 1'000'000'000;
+        if (sec != cached_sec_) {
+            std::time_t t = static_cast<std::time_t>(sec);
+            std::tm tm{};
+#ifdef _WIN32
+            gmtime_s(&tm, &t);
+#else
+            gmtime_r(&t, &tm);
+#endif
+            std::strftime(time_buffer_, sizeof(time_buffer_), "%Y-%m-%dT%H:%M:%S", &tm);
+            cached_sec_ = sec;
+        }
+        std::snprintf(time_buffer_ + 19, sizeof(time_buffer_) - 19, ".%06dZ",
+                      static_cast<int>((ns % 1'000'000'000) / 1000));
+        return time_buffer_;
+    }
+
+    std::string venue_;
+    std::string channel_;
+    std::string buffer_;
+    uint64_t rng_;
+    uint64_t sequence_ = 0;
+    double mid_ = 63250.0;
+    int64_t cached_sec_ = -1;
+    char time_buffer_[40] = {};
+};
+
+static std::vector<std::string> load_frames(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("Cannot open " + path);
+    std::vector<std::string> frames;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (!line.empty()) frames.push_back(std::move(line));
+    }
+    if (frames.empty()) throw std::runtime_error("No frames in " + path);
+    return frames;
+}
+
+/**
+ * @brief Serves one client: TLS and WebSocket handshakes, then a paced blocking write loop.
+ *
+ * Each connection has its own thread, so a slow client only throttles itself. Pacing
+ * tracks the total due since the start rather than sleeping per message, so short stalls
+ * are caught up instead of lowering the sustained rate.
+ */
+static void run_session(tcp::socket socket, ssl::context& tls, const ReplayerConfig& config,
+                        const std::vector<std::string>& frames, uint64_t session_id) {
+    try {
+        socket.set_option(tcp::no_delay(true));
+        websocket::stream<beast::ssl_stream<tcp::socket>> ws(std::move(socket), tls);
+        ws.next_layer().handshake(ssl::stream_base::server);
+
+        beast::flat_buffer buffer;
+        http::request<http::string_body> request;
+        http::read(ws.next_layer(), buffer, request);
+        ws.set_option(websocket::stream_base::decorator([](websocket::response_type& res) {
+            res.set(http::field::server, "feed-replayer");
+        }));
+        ws.auto_fragment(false);
+        if (config.deflate) {
+            websocket::permessage_deflate pmd;
+            pmd.server_enable = true;
+            ws.set_option(pmd);
+        }
+        ws.text(true);
+        ws.accept(request);
+        std::cout << "[Replayer] Session " << session_id << " connected, target " << request.target() << std::endl;
+
+        std::unique_ptr<FrameSource> source;
+        if (!frames.empty()) source = std::make_unique<ReplaySource>(frames);
+        else source = std::make_unique<SyntheticSource>(config.venue, config.channel, config.mirror ? config.seed : config.seed + session_id);
+
+        using clock = std::chrono::steady_clock;
+        const auto start = clock::now();
+        const auto deadline = start + std::chrono::seconds(config.duration_sec);
+        const double ns_per_message = config.rate ? 1e9 / static_cast<double>(config.rate) : 0.0;
+        uint64_t sent = 0;
+
+        while (g_running.load(std::memory_order_relaxed)) {
+            if (config.count && sent >= config.count) break;
+            auto now = clock::now();
+            if (config.duration_sec && now >= deadline) break;
+
+            if (config.rate) {
+                double elapsed_ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count());
+                uint64_t due = static_cast<uint64_t>(elapsed_ns / ns_per_message) + 1;
+                if (sent >= due) {
+                    // Sleep when well ahead, otherwise spin for the next slot
+                    double wait_ns = static_cast<double>(sent + 1 - due) * ns_per_message;
+                    if (wait_ns > 200'000.0) std::this_thread::sleep_for(std::chrono::microseconds(100));
+                    continue;
+                }
+            }
+
+            if (config.drop_after && sent >= config.drop_after) {
+                std::cout << "[Replayer] Session " << session_id << " dropping connection after " << sent << " messages" << std::endl;
+                beast::error_code ec;
+                beast::get_lowest_layer(ws).close(ec);
+                return;
+            }
+            if (config.stall_after && sent >= config.stall_after) {
+                std::cout << "[Replayer] Session " << session_id << " stalling after " << sent << " messages" << std::endl;
+                while (g_running.load(std::memory_order_relaxed) &&
+                       !(config.duration_sec && clock::now() >= deadline)) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                }
+                break;
+            }
+
+            std::string_view frame = source->next();
+            ws.write(net::buffer(frame.data(), frame.size()));
+            ++sent;
+        }
+
+        double secs = std::chrono::duration<double>(clock::now() - start).count();
+        std::cout << "[Replayer] Session " << session_id << " sent " << sent << " messages in " << secs << "s ("
+                  << static_cast<uint64_t>(static_cast<double>(sent) / (secs > 0 ? secs : 1)) << " msg/s)" << std::endl;
+
+        beast::error_code ec;
+        ws.close(websocket::close_code::normal, ec);
+    } catch (const std::exception& e) {
+        std::cerr << "[Replayer] Session " << session_id << ": " << e.what() << std::endl;
+    }
+}
+
+static ReplayerConfig parse_args(int argc, char** argv) {
+    ReplayerConfig cfg;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        std::string value = argv[i + 1];
+        if (flag == "--port") cfg.port = static_cast<unsigned short>(std::stoi(value));
+        else if (flag == "--cert") cfg.cert_file = value;
+        else if (flag == "--key") cfg.key_file = value;
+        else if (flag == "--replay") cfg.replay_file = value;
+        else if (flag == "--venue") cfg.venue = value;
+        else if (flag == "--channel") cfg.channel = value;
+        else if (flag == "--rate") cfg.rate = std::stoull(value);
+        else if (flag == "--duration") cfg.duration_sec = std::stoull(value);
+        else if (flag == "--count") cfg.count = std::stoull(value);
+        else if (flag == "--seed") cfg.seed = std::stoull(value);
+        else if (flag == "--drop-after") cfg.drop_after = std::stoull(value);
+        else if (flag == "--stall-after") cfg.stall_after = std::stoull(value);
+        else if (flag == "--mirror") cfg.mirror = value != "0";
+        else if (flag == "--deflate") cfg.deflate = value != "0";
+        else throw std::invalid_argument("Unknown option: " + flag);
+    }
+    if (cfg.replay_file.empty() && !SyntheticSource::supported(cfg.venue, cfg.channel)) {
+        throw std::invalid_argument("Unsupported --venue/--channel: " + cfg.venue + "/" + cfg.channel);
+    }
+    return cfg;
+}
+
+int main(int argc, char** argv) {
+    try {
+        ReplayerConfig config = parse_args(argc, argv);
+        std::vector<std::string> frames;
+        if (!config.replay_file.empty()) frames = load_frames(config.replay_file);
+
+        ssl::context tls(ssl::context::tlsv12_server);
+        if (!config.cert_file.empty()) {
+            tls.use_certificate_chain_file(config.cert_file);
+            tls.use_private_key_file(config.key_file, ssl::context::pem);
+        } else {
+            use_self_signed_certificate(tls);
+        }
+
+        net::io_context ioc{1};
+        tcp::acceptor acceptor(ioc, tcp::endpoint(net::ip::make_address("127.0.0.1"), config.port));
+        std::vector<std::thread> sessions;
+        uint64_t next_session_id = 1;
+
+        std::function<void()> accept = [&] {
+            acceptor.async_accept([&](beast::error_code ec, tcp::socket socket) {
+                if (ec) {
+                    if (ec != net::error::operation_aborted) std::cerr << "[Replayer] Accept: " << ec.message() << "\n";
+                    return;
+                }
+                sessions.emplace_back(run_session, std::move(socket), std::ref(tls), std::cref(config),
+                                      std::cref(frames), next_session_id++);
+                accept();
+            });
+        };
+        accept();
+
+        net::signal_set signals(ioc, SIGINT, SIGTERM);
+        signals.async_wait([&](beast::error_code, int) {
+            g_running.store(false);
+            acceptor.close();
+        });
+
+        std::cout << "[Replayer] Listening on 127.0.0.1:" << config.port << " (wss), "
+                  << (frames.empty() ? "synthesizing " + config.venue + "/" + config.channel
+                                     : "replaying " + std::to_string(frames.size()) + " frames")
+                  << ", rate " << (config.rate ? std::to_string(config.rate) + " msg/s" : "unthrottled") << std::endl;
+        ioc.run();
+
+        for (auto& t : sessions) t.join();
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Replayer exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
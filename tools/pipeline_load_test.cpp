@@ -0,0 +1,165 @@
+// End-to-end load test of one exchange pipeline against a local feed_replayer.
+//
+// Runs the venue's pipeline (exchange I/O thread, SPSC queue, parser thread, event bus) pointed
+// at host:port, prints the handled and dropped message rate every second, and at the end the
+// sustained throughput, total drops ("Queue full, dropping message") and the per-stage
+// socket-to-handler latency percentiles from the pipeline's LatencyTracer.
+//
+// --transport io_uring receives through IoUringService instead of epoll; run the same replayer
+// settings once with each to compare the two receive paths.
+//
+// Usage:
+//   feed_replayer --venue binance --channel depth --rate 500000 &
+//   pipeline_load_test [--venue binance|coinbase|kraken] [--host 127.0.0.1] [--port 9443]
+//                      [--duration sec] [--queue-size N] [--histograms file]
+//                      [--transport epoll|io_uring]
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <boost/json.hpp>
+
+#include "binance_pipeline.hpp"
+#include "coinbase_pipeline.hpp"
+#include "kraken_pipeline.hpp"
+#include "event_bus.hpp"
+#include "fast_clock.hpp"
+
+namespace json = boost::json;
+
+struct LoadTestConfig {
+    std::string venue = "binance";
+    std::string host = "127.0.0.1";
+    std::string port = "9443";
+    uint64_t duration_sec = 10;
+    size_t queue_size = 8192;
+    std::string histogram_file;
+    std::string transport = "epoll";
+};
+
+static volatile sig_atomic_t g_running = 1;
+
+static void signal_handler(int) {
+    g_running = 0;
+}
+
+static LoadTestConfig parse_args(int argc, char** argv) {
+    LoadTestConfig cfg;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        std::string value = argv[i + 1];
+        if (flag == "--venue") cfg.venue = value;
+        else if (flag == "--host") cfg.host = value;
+        else if (flag == "--port") cfg.port = value;
+        else if (flag == "--duration") cfg.duration_sec = std::stoull(value);
+        else if (flag == "--queue-size") cfg.queue_size = std::stoull(value);
+        else if (flag == "--histograms") cfg.histogram_file = value;
+        else if (flag == "--transport") cfg.transport = value;
+        else throw std::invalid_argument("Unknown option: " + flag);
+    }
+    if (cfg.venue != "binance" && cfg.venue != "coinbase" && cfg.venue != "kraken") {
+        throw std::invalid_argument("Unknown venue: " + cfg.venue);
+    }
+    if (cfg.transport != "epoll" && cfg.transport != "io_uring") {
+        throw std::invalid_argument("Unknown transport: " + cfg.transport);
+    }
+    return cfg;
+}
+
+/**
+ * @brief Drives a started pipeline for the configured duration and reports the results.
+ *
+ * Handled messages are the Total stage count of the tracer, i.e. frames that made it through
+ * parsing and every bus handler.
+ */
+template<typename Pipeline>
+static void run_load_test(Pipeline& pipeline, const LoadTestConfig& config) {
+    using clock = std::chrono::steady_clock;
+    const LatencyHistogram& total = pipeline.latency_tracer().stage(TraceStage::Total);
+    SocketTuning tuning;
+    tuning.io_uring = config.transport == "io_uring";
+    pipeline.set_socket_tuning(tuning);
+
+    pipeline.start();
+    const auto start = clock::now();
+    uint64_t last_handled = 0;
+    uint64_t last_dropped = 0;
+
+    for (uint64_t second = 1; g_running && second <= config.duration_sec; ++second) {
+        std::this_thread::sleep_until(start + std::chrono::seconds(second));
+        uint64_t handled = total.count();
+        uint64_t dropped = pipeline.dropped_messages();
+        std::cout << "[LoadTest] t=" << second << "s handled=" << handled - last_handled << "/s dropped="
+                  << dropped - last_dropped << "/s p99=" << total.percentile(99.0) << "ns" << std::endl;
+        last_handled = handled;
+        last_dropped = dropped;
+    }
+
+    double elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    pipeline.stop();
+
+    uint64_t handled = total.count();
+    uint64_t dropped = pipeline.dropped_messages();
+    std::cout << "\n[LoadTest] " << config.venue << " " << config.host << ":" << config.port << " over "
+              << config.transport << "\n"
+              << "  duration     " << elapsed << " s\n"
+              << "  handled      " << handled << "\n"
+              << "  throughput   " << static_cast<uint64_t>(static_cast<double>(handled) / elapsed) << " msg/s\n"
+              << "  dropped      " << dropped << " ("
+              << (handled + dropped ? 100.0 * static_cast<double>(dropped) / static_cast<double>(handled + dropped) : 0.0)
+              << "%)\n"
+              << "  socket-to-handler p50=" << total.percentile(50.0) << "ns p99=" << total.percentile(99.0)
+              << "ns p99.9=" << total.percentile(99.9) << "ns max=" << total.max() << "ns\n\n";
+    pipeline.latency_tracer().export_summary(std::cout, config.venue);
+
+    if (!config.histogram_file.empty()) {
+        std::ofstream out(config.histogram_file);
+        pipeline.latency_tracer().export_histograms(out, config.venue);
+        std::cout << "[LoadTest] Histograms written to " << config.histogram_file << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    try {
+        LoadTestConfig config = parse_args(argc, argv);
+        std::signal(SIGINT, signal_handler);
+        std::signal(SIGTERM, signal_handler);
+        FastClock::start_calibration_thread();
+
+        SPSCQueue<RawMessage> queue(config.queue_size);
+        auto event_bus = std::make_shared<EventBus>();
+
+        // The replayer ignores subscriptions, these only need to satisfy each exchange's start()
+        if (config.venue == "binance") {
+            BinancePipeline pipeline(queue, event_bus);
+            json::object subscription_info = {{"streams", json::array{"btcusdt@depth@100ms"}}};
+            pipeline.initialize(config.host, config.port, "/ws", subscription_info);
+            run_load_test(pipeline, config);
+        } else if (config.venue == "coinbase") {
+            CoinbasePipeline pipeline(queue, event_bus);
+            json::object subscription_info = {
+                {"product_ids", json::array{"BTC-USD"}},
+                {"channels", json::array{"level2_batch"}}
+            };
+            pipeline.initialize(config.host, config.port, "/", subscription_info);
+            run_load_test(pipeline, config);
+        } else {
+            KrakenPipeline pipeline(queue, event_bus);
+            json::object params = {{"channel", "book"}, {"symbol", json::array{"BTC/USD"}}};
+            json::object subscription_info = {{"method", "subscribe"}, {"params", params}};
+            pipeline.initialize(config.host, config.port, "/v2", subscription_info);
+            run_load_test(pipeline, config);
+        }
+
+        FastClock::stop_calibration_thread();
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Load test exception: " << e.what() << std::endl;
+        return 1;
+    }
+}